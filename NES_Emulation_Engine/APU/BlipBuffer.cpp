@@ -0,0 +1,85 @@
+#include <cmath>
+#include <cstring>
+
+#include "BlipBuffer.h"
+
+namespace NES::APU {
+	namespace {
+
+		constexpr double pi{ 3.14159265358979323846 };
+		constexpr double cutoff{ 0.45 }; // Of the output sample rate, just under Nyquist
+		constexpr u32 bass_shift{ 9 }; // DC blocker | ~14Hz at 44.1kHz
+
+		// Windowed sinc low-pass | x in output samples, centred on 0
+		double impulse(double x) {
+			constexpr double half_width{ BlipBuffer::kernel_width / 2.0 };
+			if (x <= -half_width || x >= half_width) return 0.0;
+
+			const double sinc = (x == 0.0) ? 1.0 : std::sin(2.0 * pi * cutoff * x) / (2.0 * pi * cutoff * x);
+			const double window = 0.42 + 0.5 * std::cos(pi * x / half_width) + 0.08 * std::cos(2.0 * pi * x / half_width); // Blackman
+			return 2.0 * cutoff * sinc * window;
+		}
+
+	} // Anonymous Namespace
+
+	// The kernel of a phase is the difference of the band-limited step between consecutive samples,
+	// i.e. the impulse integrated over each sample period, shifted by the phase's sub-sample offset.
+	void BlipBuffer::set_rates(double clock_rate, u32 sample_rate, u32 max_clocks) {
+		constexpr u32 phases{ 1 << phase_bits };
+		constexpr u32 resolution{ 32 }; // Integration steps per sample
+		constexpr double unity = 1 << unity_bits;
+
+		for (u32 phase{ 0 }; phase < phases; ++phase) {
+			const double offset = static_cast<double>(phase) / phases;
+
+			std::array<double, kernel_width> taps{};
+			double sum{ 0.0 };
+			for (u32 tap{ 0 }; tap < kernel_width; ++tap) {
+				for (u32 step{ 0 }; step < resolution; ++step) {
+					const double x = tap - (kernel_width / 2.0) - offset + (step + 0.5) / resolution;
+					taps[tap] += impulse(x) / resolution;
+				}
+				sum += taps[tap];
+			}
+
+			// Each phase has to add exactly unity, any rounding error would accumulate as DC drift
+			s32 total{ 0 };
+			for (u32 tap{ 0 }; tap < kernel_width; ++tap) {
+				_kernel[phase][tap] = static_cast<s16>(std::lround(taps[tap] / sum * unity));
+				total += _kernel[phase][tap];
+			}
+			_kernel[phase][kernel_width / 2] += static_cast<s16>((1 << unity_bits) - total);
+		}
+
+		_factor = sample_rate ? static_cast<u64>(std::llround(sample_rate / clock_rate * 4294967296.0)) : 0;
+		_nominal_factor = _factor;
+		const u64 samples = sample_rate ? (static_cast<u64>(max_clocks) * (_factor + (_factor >> 6)) >> 32) + 1 : 0;
+		_buffer.assign(samples + kernel_width + 1, 0);
+		_offset = 0;
+		_integrator = 0;
+	}
+
+	u32 BlipBuffer::read_samples(s16* out, u32 count) {
+		count = std::min(count, samples_available());
+		if (!count) return 0;
+
+		for (u32 i{ 0 }; i < count; ++i) {
+			_integrator += _buffer[i];
+			out[i] = static_cast<s16>(std::clamp(_integrator >> unity_bits, -32768, 32767));
+			_integrator -= _integrator >> bass_shift;
+		}
+
+		// Shift the pending tail [samples still reachable by the kernel] down to the start
+		const u32 pending = samples_available() - count + kernel_width;
+		std::memmove(_buffer.data(), _buffer.data() + count, pending * sizeof(s32));
+		std::fill(_buffer.begin() + pending, _buffer.begin() + std::min<u64>(pending + count, _buffer.size()), 0);
+		_offset -= static_cast<u64>(count) << 32;
+		return count;
+	}
+
+	void BlipBuffer::clear() {
+		std::fill(_buffer.begin(), _buffer.end(), 0);
+		_offset &= 0xFFFFFFFF; // Keeps the sub-sample phase
+		_integrator = 0;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::APU {
+
+	// Band-Limited Step Synthesis | The APU only reports when its output level changes, as a delta at a clock time.
+	// Each delta is added as a band-limited step [windowed sinc, integrated] into a buffer of sample differences,
+	// so a square wave at any pitch costs two kernel adds per period instead of being point-sampled and aliasing.
+	// Samples are the running sum of the differences, with a leaky integrator as the DC blocker.
+	class BlipBuffer {
+	public:
+		static constexpr u32 kernel_width{ 16 }; // Taps per step, the output lags by half of it
+		static constexpr u32 phase_bits{ 5 }; // 32 sub-sample step positions
+		static constexpr u32 unity_bits{ 14 }; // Kernel taps of one phase sum to 1 << unity_bits
+
+		// clock_rate -> input clocks per second [CPU cycles] | sample_rate -> output samples per second, 0 disables synthesis
+		// max_clocks -> longest span between two end_frame calls, with room for rate control raising the factor by up to 1/64
+		void set_rates(double clock_rate, u32 sample_rate, u32 max_clocks);
+		[[nodiscard]] bool enabled() const { return _factor != 0; }
+
+		// Resampling ratio in 32.32 fixed point samples per clock | Adjusted by rate control, only right after end_frame
+		[[nodiscard]] u64 get_factor() const { return _factor; }
+		[[nodiscard]] u64 get_nominal_factor() const { return _nominal_factor; } // From set_rates
+		void set_factor(u64 factor) { _factor = factor; }
+
+		// Adds a step of delta at time clocks after the last end_frame
+		void add_delta(u32 time, s32 delta) {
+			if (!delta || !_factor) return;
+
+			const u64 position = _offset + time * _factor;
+			const u32 phase = static_cast<u32>(position >> (32 - phase_bits)) & ((1 << phase_bits) - 1);
+			s32* out = &_buffer[static_cast<u32>(position >> 32)];
+			const s16* kernel = _kernel[phase].data();
+			for (u32 i{ 0 }; i < kernel_width; ++i) {
+				out[i] += delta * kernel[i];
+			}
+		}
+
+		// Closes the span of time clocks | Samples that no later delta can reach become readable
+		void end_frame(u32 time) { _offset += time * _factor; }
+
+		[[nodiscard]] u32 samples_available() const { return static_cast<u32>(_offset >> 32); }
+
+		// Reads up to count samples, returns how many were read
+		u32 read_samples(s16* out, u32 count);
+
+		void clear();
+
+	private:
+		std::vector<s32>	_buffer; // Sample differences, scaled by 1 << unity_bits
+		u64					_offset{ 0 }; // 32.32 position of the current span's start in _buffer
+		u64					_factor{ 0 }; // 32.32 samples per clock
+		u64					_nominal_factor{ 0 };
+		s32					_integrator{ 0 };
+
+		std::array<std::array<s16, kernel_width>, 1 << phase_bits>	_kernel{};
+	};
+}
@@ -0,0 +1,346 @@
+#include "Channels.h"
+
+namespace NES::APU {
+	namespace {
+
+		constexpr u8 length_table[32] = {
+			10, 254, 20,  2, 40,  4, 80,  6, 160,  8, 60, 10, 14, 12, 26, 14,
+			12,  16, 24, 18, 48, 20, 96, 22, 192, 24, 72, 26, 16, 28, 32, 30,
+		};
+
+		constexpr u8 duty_table[4][8] = {
+			{ 0, 0, 0, 0, 0, 0, 0, 1 }, // 12.5%
+			{ 0, 0, 0, 0, 0, 0, 1, 1 }, // 25%
+			{ 0, 0, 0, 0, 1, 1, 1, 1 }, // 50%
+			{ 1, 1, 1, 1, 1, 1, 0, 0 }, // 25% negated
+		};
+
+		constexpr u8 triangle_table[32] = {
+			15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0,
+			 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+		};
+
+		constexpr u16 noise_periods[16] = { 4, 8, 16, 32, 64, 96, 128, 160, 202, 254, 380, 508, 762, 1016, 2034, 4068 }; // NTSC, CPU cycles
+		constexpr u16 dmc_periods[16] = { 428, 380, 340, 320, 286, 254, 226, 214, 190, 160, 142, 128, 106, 84, 72, 54 }; // NTSC, CPU cycles
+
+		// Runs a timer over [time, end] | step(t) is called at every expiry, timer is left at the cycles still to go
+		template<typename Step>
+		void advance(u32& timer, u32 period, u32 time, u32 end, Step&& step) {
+			u32 remaining = end - time;
+			while (timer <= remaining) {
+				time += timer;
+				remaining -= timer;
+				timer = period;
+				step(time);
+			}
+			timer -= remaining;
+		}
+
+		// Same as advance for a channel that cannot be heard | Returns the number of expiries without visiting them
+		u32 skip(u32& timer, u32 period, u32 time, u32 end) {
+			const u32 remaining = end - time;
+			if (timer > remaining) {
+				timer -= remaining;
+				return 0;
+			}
+			const u32 steps = (remaining - timer) / period + 1;
+			timer = timer + steps * period - remaining;
+			return steps;
+		}
+
+	} // Anonymous Namespace
+
+	/// ENVELOPE ///
+
+	void Envelope::clock() {
+		if (_start) {
+			_start = false;
+			_decay = 15;
+			_divider = _period;
+		} else if (_divider) {
+			--_divider;
+		} else {
+			_divider = _period;
+			if (_decay) {
+				--_decay;
+			} else if (_loop) {
+				_decay = 15;
+			}
+		}
+	}
+
+	void LengthCounter::load(u8 index) {
+		if (_enabled) _count = length_table[index & 0x1F];
+	}
+
+	/// END ENVELOPE ///
+
+	/// PULSE ///
+
+	void Pulse::write(u8 reg, u8 data) {
+		switch (reg & 0x03) {
+		case 0: // DDLC VVVV -> duty, length counter halt/envelope loop, constant volume, volume/envelope period
+			_duty = data >> 6;
+			_length.set_halt(data & 0x20);
+			_envelope.write(data);
+			break;
+
+		case 1: // EPPP NSSS -> sweep enable, period, negate, shift
+			_sweep_enabled = data & 0x80;
+			_sweep_period = (data >> 4) & 0x07;
+			_sweep_negate = data & 0x08;
+			_sweep_shift = data & 0x07;
+			_sweep_reload = true;
+			break;
+
+		case 2: // Timer low
+			_period = (_period & 0x0700) | data;
+			break;
+
+		case 3: // LLLL LHHH -> length counter load, timer high | Restarts the sequencer and the envelope
+			_period = (_period & 0x00FF) | ((data & 0x07) << 8);
+			_length.load(data >> 3);
+			_step = 0;
+			_envelope.restart();
+			break;
+		}
+	}
+
+	// Pulse 1 negates in one's complement, Pulse 2 in two's complement
+	u16 Pulse::sweep_target() const {
+		const s32 change = _period >> _sweep_shift;
+		if (!_sweep_negate) return static_cast<u16>(_period + change);
+		return static_cast<u16>(std::max<s32>(0, _period - change - (_channel == Channel::Pulse1 ? 1 : 0)));
+	}
+
+	void Pulse::half_frame() {
+		_length.clock();
+
+		if (_sweep_divider == 0 && _sweep_enabled && _sweep_shift && !muted()) {
+			_period = sweep_target();
+		}
+		if (_sweep_divider == 0 || _sweep_reload) {
+			_sweep_divider = _sweep_period;
+			_sweep_reload = false;
+		} else {
+			--_sweep_divider;
+		}
+	}
+
+	void Pulse::run(u32 time, u32 end, Mixer& mixer) {
+		const u8 volume = (active() && !muted()) ? _envelope.volume() : 0;
+		const u32 period = (_period + 1) * 2;
+		mixer.update(_channel, time, volume * duty_table[_duty][_step]);
+
+		if (!volume) {
+			_step = (_step + skip(_timer, period, time, end)) & 0x07;
+			return;
+		}
+		advance(_timer, period, time, end, [&](u32 t) {
+			_step = (_step + 1) & 0x07;
+			mixer.update(_channel, t, volume * duty_table[_duty][_step]);
+		});
+	}
+
+	/// END PULSE ///
+
+	/// TRIANGLE ///
+
+	void Triangle::write(u8 reg, u8 data) {
+		switch (reg & 0x03) {
+		case 0: // CRRR RRRR -> control/length counter halt, linear counter reload value
+			_control = data & 0x80;
+			_length.set_halt(_control);
+			_linear_period = data & 0x7F;
+			break;
+
+		case 2: // Timer low
+			_period = (_period & 0x0700) | data;
+			break;
+
+		case 3: // LLLL LHHH -> length counter load, timer high
+			_period = (_period & 0x00FF) | ((data & 0x07) << 8);
+			_length.load(data >> 3);
+			_linear_reload = true;
+			break;
+		}
+	}
+
+	void Triangle::quarter_frame() {
+		if (_linear_reload) {
+			_linear_counter = _linear_period;
+		} else if (_linear_counter) {
+			--_linear_counter;
+		}
+		if (!_control) _linear_reload = false;
+	}
+
+	// Periods below 2 are ultrasonic, games use them to silence the channel | The sequencer is held there instead of aliasing
+	void Triangle::run(u32 time, u32 end, Mixer& mixer) {
+		const u32 period = _period + 1;
+		mixer.update(Channel::Triangle, time, triangle_table[_step]);
+
+		if (!active() || !_linear_counter || _period < 2) {
+			skip(_timer, period, time, end);
+			return;
+		}
+		advance(_timer, period, time, end, [&](u32 t) {
+			_step = (_step + 1) & 0x1F;
+			mixer.update(Channel::Triangle, t, triangle_table[_step]);
+		});
+	}
+
+	/// END TRIANGLE ///
+
+	/// NOISE ///
+
+	void Noise::write(u8 reg, u8 data) {
+		switch (reg & 0x03) {
+		case 0: // --LC VVVV -> length counter halt/envelope loop, constant volume, volume/envelope period
+			_length.set_halt(data & 0x20);
+			_envelope.write(data);
+			break;
+
+		case 2: // M--- PPPP -> mode, period
+			_mode = data & 0x80;
+			_period = noise_periods[data & 0x0F];
+			break;
+
+		case 3: // LLLL L--- -> length counter load | Restarts the envelope
+			_length.load(data >> 3);
+			_envelope.restart();
+			break;
+		}
+	}
+
+	// The LFSR keeps running while silent, its state decides what the next note sounds like
+	void Noise::run(u32 time, u32 end, Mixer& mixer) {
+		const u8 volume = active() ? _envelope.volume() : 0;
+		const u8 tap = _mode ? 6 : 1;
+		mixer.update(Channel::Noise, time, (_shift & 0x01) ? 0 : volume);
+
+		advance(_timer, _period, time, end, [&](u32 t) {
+			const u16 feedback = (_shift ^ (_shift >> tap)) & 0x01;
+			_shift = (_shift >> 1) | (feedback << 14);
+			if (volume) mixer.update(Channel::Noise, t, (_shift & 0x01) ? 0 : volume);
+		});
+	}
+
+	/// END NOISE ///
+
+	/// DMC ///
+
+	void DMC::write(u8 reg, u8 data) {
+		switch (reg & 0x03) {
+		case 0: // IL-- RRRR -> IRQ enable, loop, rate
+			_irq_enabled = data & 0x80;
+			if (!_irq_enabled) _irq = false;
+			_loop = data & 0x40;
+			_period = dmc_periods[data & 0x0F];
+			break;
+
+		case 1: // -DDD DDDD -> direct load of the output level
+			_output = data & 0x7F;
+			break;
+
+		case 2: // Sample address -> $C000 + A * 64
+			_sample_address = 0xC000 | (data << 6);
+			break;
+
+		case 3: // Sample length -> L * 16 + 1 bytes
+			_sample_length = (data << 4) | 0x0001;
+			break;
+		}
+	}
+
+	void DMC::set_enabled(bool enabled) {
+		_irq = false;
+		if (!enabled) {
+			_bytes_remaining = 0;
+		} else if (!_bytes_remaining) {
+			restart();
+			fetch();
+		}
+	}
+
+	// Memory Reader | Refills the sample buffer as soon as it is empty
+	void DMC::fetch() {
+		if (_buffer_full || !_bytes_remaining) return;
+
+		_buffer = _reader ? _reader(_current_address) : 0x00;
+		_buffer_full = true;
+		_current_address = (_current_address == 0xFFFF) ? 0x8000 : _current_address + 1;
+
+		if (!--_bytes_remaining) {
+			if (_loop) {
+				restart();
+			} else if (_irq_enabled) {
+				_irq = true;
+			}
+		}
+	}
+
+	// Every fetch takes 8 output clocks to play back, the last one raises IRQ
+	u64 DMC::cycles_until_irq() const {
+		if (_irq) return 0;
+		if (!_irq_enabled || _loop || !_bytes_remaining) return UINT64_MAX;
+		return (static_cast<u64>(_bytes_remaining) - 1) * 8 * _period;
+	}
+
+	// The buffer is refilled as the output cycle takes the byte in it -> after the bits left in the shift register
+	u64 DMC::cycles_until_fetch() const {
+		if (!_buffer_full || !_bytes_remaining) return UINT64_MAX;
+		return _timer + static_cast<u64>(_bits_remaining - 1) * _period;
+	}
+
+	void DMC::run(u32 time, u32 end, Mixer& mixer) {
+		mixer.update(Channel::DMC, time, _output);
+
+		advance(_timer, _period, time, end, [&](u32 t) {
+			if (!_silence) {
+				if (_shift & 0x01) {
+					if (_output <= 125) _output += 2;
+				} else if (_output >= 2) {
+					_output -= 2;
+				}
+				mixer.update(Channel::DMC, t, _output);
+			}
+			_shift >>= 1;
+
+			if (!--_bits_remaining) { // Output cycle ends -> next byte from the buffer
+				_bits_remaining = 8;
+				_silence = !_buffer_full;
+				if (_buffer_full) {
+					_shift = _buffer;
+					_buffer_full = false;
+					fetch();
+				}
+			}
+		});
+	}
+
+	void DMC::save_state(State& state) const {
+		state = { _irq_enabled, _loop, _irq, _buffer_full, _silence, _output, _buffer, _shift, _bits_remaining,
+			_period, _sample_address, _sample_length, _current_address, _bytes_remaining, _timer };
+	}
+
+	void DMC::load_state(const State& state) {
+		_irq_enabled = state.irq_enabled;
+		_loop = state.loop;
+		_irq = state.irq;
+		_buffer_full = state.buffer_full;
+		_silence = state.silence;
+		_output = state.output;
+		_buffer = state.buffer;
+		_shift = state.shift;
+		_bits_remaining = state.bits_remaining;
+		_period = state.period;
+		_sample_address = state.sample_address;
+		_sample_length = state.sample_length;
+		_current_address = state.current_address;
+		_bytes_remaining = state.bytes_remaining;
+		_timer = state.timer;
+	}
+
+	/// END DMC ///
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <type_traits>
+
+#include "../Common/CommonHeaders.h"
+#include "Mixer.h"
+
+// https://www.nesdev.org/wiki/APU
+// Every channel is driven by a timer that counts CPU cycles. A channel is not clocked cycle by cycle: run() advances it from one
+// timer expiry to the next over a span of time and only reports the points where its output level changes.
+// The frame counter splits the spans, so envelopes, sweeps and length counters are constant inside one.
+
+namespace NES::APU {
+
+	// Volume Envelope | Pulse and Noise
+	class Envelope {
+	public:
+		void write(u8 data) {
+			_loop = data & 0x20;
+			_constant = data & 0x10;
+			_period = data & 0x0F;
+		}
+		void restart() { _start = true; }
+		void clock(); // Quarter frame
+
+		[[nodiscard]] u8 volume() const { return _constant ? _period : _decay; }
+
+	private:
+		bool	_start{ false };
+		bool	_loop{ false };
+		bool	_constant{ false };
+		u8		_period{ 0 }; // Also the constant volume
+		u8		_divider{ 0 };
+		u8		_decay{ 0 };
+	};
+
+	// Length Counter | Silences the channel when it runs out, only loads while the channel is enabled in $4015
+	class LengthCounter {
+	public:
+		void load(u8 index);
+		void clock() { if (!_halt && _count) --_count; } // Half frame
+
+		void set_halt(bool halt) { _halt = halt; }
+		void set_enabled(bool enabled) {
+			_enabled = enabled;
+			if (!enabled) _count = 0;
+		}
+
+		[[nodiscard]] bool active() const { return _count != 0; }
+
+	private:
+		bool	_enabled{ false };
+		bool	_halt{ false };
+		u8		_count{ 0 };
+	};
+
+	// Pulse | $4000-$4003, $4004-$4007 | 8-step duty sequencer clocked every (period + 1) * 2 CPU cycles
+	class Pulse {
+	public:
+		explicit Pulse(Channel channel) : _channel{ channel } {}
+
+		void write(u8 reg, u8 data); // reg 0-3
+		void quarter_frame() { _envelope.clock(); }
+		void half_frame();
+
+		void set_enabled(bool enabled) { _length.set_enabled(enabled); }
+		[[nodiscard]] bool active() const { return _length.active(); }
+
+		void run(u32 time, u32 end, Mixer& mixer);
+
+	private:
+		[[nodiscard]] u16 sweep_target() const;
+		[[nodiscard]] bool muted() const { return _period < 8 || sweep_target() > 0x7FF; }
+
+		Channel			_channel;
+		Envelope		_envelope;
+		LengthCounter	_length;
+
+		u8		_duty{ 0 };
+		u8		_step{ 0 };
+		u16		_period{ 0 }; // 11-bit timer reload
+		u32		_timer{ 2 }; // CPU cycles until the sequencer steps
+
+		bool	_sweep_enabled{ false };
+		bool	_sweep_negate{ false };
+		bool	_sweep_reload{ false };
+		u8		_sweep_period{ 0 };
+		u8		_sweep_shift{ 0 };
+		u8		_sweep_divider{ 0 };
+	};
+
+	// Triangle | $4008-$400B | 32-step sequencer clocked every period + 1 CPU cycles while both counters are non-zero
+	class Triangle {
+	public:
+		void write(u8 reg, u8 data);
+		void quarter_frame();
+		void half_frame() { _length.clock(); }
+
+		void set_enabled(bool enabled) { _length.set_enabled(enabled); }
+		[[nodiscard]] bool active() const { return _length.active(); }
+
+		void run(u32 time, u32 end, Mixer& mixer);
+
+	private:
+		LengthCounter	_length;
+
+		bool	_control{ false }; // Also halts the length counter
+		bool	_linear_reload{ false };
+		u8		_linear_period{ 0 };
+		u8		_linear_counter{ 0 };
+
+		u8		_step{ 0 };
+		u16		_period{ 0 };
+		u32		_timer{ 1 };
+	};
+
+	// Noise | $400C-$400F | 15-bit LFSR clocked from a table of 16 periods
+	class Noise {
+	public:
+		void write(u8 reg, u8 data);
+		void quarter_frame() { _envelope.clock(); }
+		void half_frame() { _length.clock(); }
+
+		void set_enabled(bool enabled) { _length.set_enabled(enabled); }
+		[[nodiscard]] bool active() const { return _length.active(); }
+
+		void run(u32 time, u32 end, Mixer& mixer);
+
+	private:
+		Envelope		_envelope;
+		LengthCounter	_length;
+
+		bool	_mode{ false }; // 1 -> short, 93-step sequence
+		u16		_shift{ 0x0001 };
+		u16		_period{ 4 };
+		u32		_timer{ 4 };
+	};
+
+	// Delta Modulation Channel | $4010-$4013 | Plays 1-bit deltas fetched from $8000-$FFFF by DMA, each fetch stalls the CPU
+	class DMC {
+	public:
+		// DMA Fetch | Reads a sample byte through the CPU Bus, which charges the CPU for the stolen cycles
+		void set_reader(std::function<u8(u16)> reader) { _reader = std::move(reader); }
+
+		void write(u8 reg, u8 data);
+
+		void set_enabled(bool enabled);
+		[[nodiscard]] bool active() const { return _bytes_remaining != 0; }
+
+		[[nodiscard]] bool irq() const { return _irq; }
+		void acknowledge_irq() { _irq = false; }
+
+		// Lower bound on the CPU cycles until the channel raises IRQ, UINT64_MAX if it cannot
+		[[nodiscard]] u64 cycles_until_irq() const;
+		// CPU cycles until the next sample fetch [the end of the current output cycle], UINT64_MAX if none is coming
+		[[nodiscard]] u64 cycles_until_fetch() const;
+
+		void run(u32 time, u32 end, Mixer& mixer);
+
+		// Snapshot | The reader is wiring, not state
+		struct State {
+			bool	irq_enabled;
+			bool	loop;
+			bool	irq;
+			bool	buffer_full;
+			bool	silence;
+			u8		output;
+			u8		buffer;
+			u8		shift;
+			u8		bits_remaining;
+			u16		period;
+			u16		sample_address;
+			u16		sample_length;
+			u16		current_address;
+			u16		bytes_remaining;
+			u32		timer;
+		};
+		void save_state(State& state) const;
+		void load_state(const State& state);
+
+	private:
+		void restart() {
+			_current_address = _sample_address;
+			_bytes_remaining = _sample_length;
+		}
+		void fetch();
+
+		std::function<u8(u16)>	_reader;
+
+		bool	_irq_enabled{ false };
+		bool	_loop{ false };
+		bool	_irq{ false };
+		u16		_period{ 428 };
+		u32		_timer{ 428 };
+
+		u8		_output{ 0 }; // 7-bit level
+		u16		_sample_address{ 0xC000 };
+		u16		_sample_length{ 1 };
+		u16		_current_address{ 0xC000 };
+		u16		_bytes_remaining{ 0 };
+
+		u8		_buffer{ 0 };
+		bool	_buffer_full{ false };
+		u8		_shift{ 0 };
+		u8		_bits_remaining{ 8 };
+		bool	_silence{ true };
+	};
+
+	// Pulse, Triangle and Noise are plain data and are snapshotted as they are [R2A03::State]
+	static_assert(std::is_trivially_copyable_v<Pulse> && std::is_trivially_copyable_v<Triangle> && std::is_trivially_copyable_v<Noise>);
+}
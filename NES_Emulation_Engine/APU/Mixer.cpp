@@ -0,0 +1,19 @@
+#include "Mixer.h"
+
+namespace NES::APU {
+	namespace {
+
+		constexpr double amplitude{ 24000.0 }; // Mixer output 1.0 -> sample value, the DC blocker centres it on 0
+
+	} // Anonymous Namespace
+
+	// https://www.nesdev.org/wiki/APU_Mixer | Lookup table approximation
+	Mixer::Mixer() {
+		for (u32 i{ 1 }; i < _pulse_table.size(); ++i) {
+			_pulse_table[i] = static_cast<s32>(amplitude * 95.52 / (8128.0 / i + 100.0));
+		}
+		for (u32 i{ 1 }; i < _tnd_table.size(); ++i) {
+			_tnd_table[i] = static_cast<s32>(amplitude * 163.67 / (24329.0 / i + 100.0));
+		}
+	}
+}
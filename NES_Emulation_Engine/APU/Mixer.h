@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+#include "BlipBuffer.h"
+
+namespace NES::APU {
+
+	enum class Channel : u8 { Pulse1, Pulse2, Triangle, Noise, DMC };
+
+	// Non-linear 2A03 Mixer | The pulse pair and triangle/noise/DMC each go through their own resistor network,
+	// approximated with the two lookup tables from the nesdev wiki. Channels report their level when it changes,
+	// the mixer turns that into one delta of the mixed output for the BlipBuffer.
+	class Mixer {
+	public:
+		Mixer();
+
+		// time -> clocks since the last BlipBuffer::end_frame
+		void update(Channel channel, u32 time, u8 level) {
+			u8& current = _levels[static_cast<u8>(channel)];
+			if (current == level) return;
+			current = level;
+
+			const s32 output = _pulse_table[_levels[0] + _levels[1]] + _tnd_table[3 * _levels[2] + 2 * _levels[3] + _levels[4]];
+			_blip.add_delta(time, output - _output);
+			_output = output;
+		}
+
+		[[nodiscard]] BlipBuffer& blip() { return _blip; }
+
+		// Channel levels for snapshots | Restoring them is one more level change, so the output steps to the restored mix
+		[[nodiscard]] const std::array<u8, 5>& levels() const { return _levels; }
+		void set_levels(const std::array<u8, 5>& levels, u32 time) {
+			for (u8 channel{ 0 }; channel < levels.size(); ++channel) update(static_cast<Channel>(channel), time, levels[channel]);
+		}
+
+	private:
+		BlipBuffer				_blip;
+		std::array<u8, 5>		_levels{}; // Pulse 0-15, Triangle 0-15, Noise 0-15, DMC 0-127
+		s32						_output{ 0 }; // Mixed level the deltas add up to
+
+		std::array<s32, 31>		_pulse_table{};
+		std::array<s32, 203>	_tnd_table{};
+	};
+}
@@ -0,0 +1,265 @@
+#include "R2A03.h"
+
+#if AUDIO_RING_TEST
+#include <chrono>
+#include <iostream>
+#include <thread>
+#endif // AUDIO_RING_TEST
+
+namespace NES::APU { // [Audio Processing Unit]
+	namespace {
+
+		// Frame Counter Steps | CPU cycles after the sequence starts [NTSC]. The 5-step mode's silent 4th step is left out.
+		constexpr s32 frame_steps[2][4] = {
+			{ 7457, 14913, 22371, 29829 }, // 4-step -> IRQ on the last one
+			{ 7457, 14913, 22371, 37281 }, // 5-step
+		};
+		constexpr s32 frame_periods[2] = { 29830, 37282 };
+
+		constexpr u32 max_span{ 8192 }; // Longest run between two flushes -> one frame counter step plus the $4017 delay
+
+	} // Anonymous Namespace
+
+	R2A03::R2A03() {
+		set_sample_rate(44100);
+	}
+
+	void R2A03::set_sample_rate(u32 sample_rate) {
+		_sample_rate = sample_rate;
+		_mixer.blip().set_rates(cpu_clock_rate, sample_rate, max_span);
+		_samples.clear();
+		set_latency(_latency);
+	}
+
+	void R2A03::set_latency(u32 milliseconds) {
+		_latency = milliseconds;
+		_mixer.blip().set_factor(_mixer.blip().get_nominal_factor());
+		_rate_control.configure(_mixer.blip().get_nominal_factor(), static_cast<u32>(static_cast<u64>(_sample_rate) * milliseconds / 1000));
+	}
+
+	// Writes to the APU Registers
+	void R2A03::cpubus_write(u16 address, u8 data) {
+		const u8 reg = address & 0x03;
+
+		switch (address & 0x001F) {
+		case 0x00: case 0x01: case 0x02: case 0x03: _pulse_1.write(reg, data); break;
+		case 0x04: case 0x05: case 0x06: case 0x07: _pulse_2.write(reg, data); break;
+		case 0x08: case 0x09: case 0x0A: case 0x0B: _triangle.write(reg, data); break;
+		case 0x0C: case 0x0D: case 0x0E: case 0x0F: _noise.write(reg, data); break;
+		case 0x10: case 0x11: case 0x12: case 0x13: _dmc.write(reg, data); break;
+
+		case 0x15: // ---D NT21 -> channel enables | Also acknowledges the DMC IRQ
+			_pulse_1.set_enabled(data & 0x01);
+			_pulse_2.set_enabled(data & 0x02);
+			_triangle.set_enabled(data & 0x04);
+			_noise.set_enabled(data & 0x08);
+			_dmc.set_enabled(data & 0x10);
+			break;
+
+		case 0x17: // MI-- ---- -> 5-step mode, IRQ inhibit | The sequence restarts 3-4 cycles later, mode 1 clocks everything right away
+			_five_step = data & 0x80;
+			_irq_inhibit = data & 0x40;
+			if (_irq_inhibit) _frame_irq = false;
+
+			_frame_step = 0;
+			_frame_cycle = -3;
+			if (_five_step) {
+				quarter_frame();
+				half_frame();
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// Reads from the APU Registers | Only $4015 -> IF-D NT21 [DMC IRQ, frame IRQ, DMC active, length counters]
+	u8 R2A03::cpubus_read(u16 address) {
+		if ((address & 0x001F) != 0x15) return 0x00;
+
+		const u8 status = (_pulse_1.active() ? 0x01 : 0x00) | (_pulse_2.active() ? 0x02 : 0x00) | (_triangle.active() ? 0x04 : 0x00) |
+			(_noise.active() ? 0x08 : 0x00) | (_dmc.active() ? 0x10 : 0x00) | (_frame_irq ? 0x40 : 0x00) | (_dmc.irq() ? 0x80 : 0x00);
+		_frame_irq = false;
+		return status;
+	}
+
+	u64 R2A03::cycles_until_irq() const {
+		if (irq()) return 0;
+
+		u64 cycles = _dmc.cycles_until_irq();
+		if (!_five_step && !_irq_inhibit) {
+			cycles = std::min<u64>(cycles, frame_steps[0][3] - _frame_cycle);
+		}
+		return cycles;
+	}
+
+	// Runs a batch of CPU cycles | Split at the frame counter steps, the only points where the channels' settings change by themselves
+	void R2A03::run(u64 cycles) {
+		while (cycles) {
+			const s32 step = frame_steps[_five_step][_frame_step];
+			const u32 span = static_cast<u32>(std::min<u64>(cycles, static_cast<u64>(step - _frame_cycle)));
+
+			run_channels(span);
+			_frame_cycle += span;
+			cycles -= span;
+
+			if (_frame_cycle == step) frame_step();
+		}
+		flush_samples();
+	}
+
+	void R2A03::run_channels(u32 cycles) {
+		const u32 end = _time + cycles;
+		_pulse_1.run(_time, end, _mixer);
+		_pulse_2.run(_time, end, _mixer);
+		_triangle.run(_time, end, _mixer);
+		_noise.run(_time, end, _mixer);
+		_dmc.run(_time, end, _mixer);
+		_time = end;
+	}
+
+	void R2A03::frame_step() {
+		quarter_frame();
+		if (_frame_step & 0x01) { // Steps 2 and 4
+			half_frame();
+		}
+		if (_frame_step == 3 && !_five_step && !_irq_inhibit) {
+			_frame_irq = true;
+		}
+
+		if (++_frame_step == 4) {
+			_frame_step = 0;
+			_frame_cycle -= frame_periods[_five_step];
+		}
+		flush_samples();
+	}
+
+	void R2A03::quarter_frame() { // Envelopes + Triangle linear counter
+		_pulse_1.quarter_frame();
+		_pulse_2.quarter_frame();
+		_triangle.quarter_frame();
+		_noise.quarter_frame();
+	}
+
+	void R2A03::half_frame() { // Length counters + Sweeps
+		_pulse_1.half_frame();
+		_pulse_2.half_frame();
+		_triangle.half_frame();
+		_noise.half_frame();
+	}
+
+	void R2A03::save_state(State& state) const {
+		state.pulse_1 = _pulse_1;
+		state.pulse_2 = _pulse_2;
+		state.triangle = _triangle;
+		state.noise = _noise;
+		_dmc.save_state(state.dmc);
+		state.levels = _mixer.levels();
+		state.frame_cycle = _frame_cycle;
+		state.frame_step = _frame_step;
+		state.five_step = _five_step;
+		state.irq_inhibit = _irq_inhibit;
+		state.frame_irq = _frame_irq;
+	}
+
+	void R2A03::load_state(const State& state) {
+		_pulse_1 = state.pulse_1;
+		_pulse_2 = state.pulse_2;
+		_triangle = state.triangle;
+		_noise = state.noise;
+		_dmc.load_state(state.dmc);
+		_mixer.set_levels(state.levels, _time);
+		_frame_cycle = state.frame_cycle;
+		_frame_step = state.frame_step;
+		_five_step = state.five_step;
+		_irq_inhibit = state.irq_inhibit;
+		_frame_irq = state.frame_irq;
+	}
+
+	void R2A03::flush_samples() {
+		BlipBuffer& blip = _mixer.blip();
+		blip.end_frame(_time);
+		_time = 0;
+
+		s16 buffer[1024];
+		while (const u32 count = blip.read_samples(buffer, 1024)) {
+			if (_output_enabled) _samples.write(buffer, count);
+		}
+
+		if (_rate_control.enabled() && _output_enabled) {
+			const u32 reserve = _samples.take_low_water();
+			if (reserve != UINT32_MAX) blip.set_factor(_rate_control.update(reserve)); // Nothing played since the last flush -> nothing to learn
+		}
+	}
+
+#if AUDIO_RING_TEST
+	u32 test_audio_ring() {
+		using clock = std::chrono::steady_clock;
+		constexpr u32 latency{ 8 }; // Milliseconds of reserve floor | Stalls of the producer thread beyond it [~12ms seen on a shared one-core host] are covered by the learned allowance
+		constexpr u32 block{ 128 }; // Samples per audio callback
+		constexpr auto duration = std::chrono::seconds(6);
+		constexpr auto warm_up = std::chrono::seconds(1); // Rate control learns the drift and the host's wake-up jitter [RateControl allowance]
+		constexpr auto chunk = std::chrono::milliseconds(2); // Emulation thread wake-ups, about an eighth of a frame
+		constexpr double drift{ 1.003 }; // Consumer clock against the emulated one
+
+		R2A03 apu;
+		apu.set_latency(latency);
+		apu.cpubus_write(0x4015, 0x01);
+		apu.cpubus_write(0x4000, 0xBF); // 50% duty, constant volume 15, halted length counter
+		apu.cpubus_write(0x4002, 0xFD); // ~440Hz
+		apu.cpubus_write(0x4003, 0x00);
+
+		SampleRing& ring = apu.samples();
+		const clock::time_point start = clock::now();
+		std::atomic<bool> running{ true };
+
+		// Producer | Runs the APU in real time, the cycles due so far at every wake-up
+		std::thread producer([&]() {
+			u64 cycles_run{ 0 };
+			for (clock::time_point wake = start; running.load(std::memory_order_relaxed); wake += chunk) {
+				std::this_thread::sleep_until(wake);
+				const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+				const u64 cycles_due = static_cast<u64>(elapsed * cpu_clock_rate);
+				apu.run(cycles_due - cycles_run);
+				cycles_run = cycles_due;
+			}
+		});
+
+		// Consumer | A sound card whose clock runs fast, started once the target latency is buffered
+		while (ring.size() < static_cast<u32>(apu.get_sample_rate() * latency / 1000)) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		u64 underruns{ 0 };
+		u64 fill_sum{ 0 }, blocks{ 0 };
+		u32 max_fill{ 0 };
+		bool warmed_up{ false };
+		const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(block / (apu.get_sample_rate() * drift)));
+		const clock::time_point playback = clock::now();
+		s16 buffer[block];
+		for (clock::time_point wake = playback; wake - playback < duration; wake += period) {
+			std::this_thread::sleep_until(wake);
+			if (wake - playback >= warm_up) {
+				if (!warmed_up) underruns = ring.underruns(); // Only count from here on
+				warmed_up = true;
+				const u32 fill = ring.size();
+				fill_sum += fill;
+				max_fill = std::max(max_fill, fill);
+				++blocks;
+			}
+			ring.consume(buffer, block);
+		}
+		running.store(false, std::memory_order_relaxed);
+		producer.join();
+
+		const u64 late_underruns = ring.underruns() - underruns;
+		const double latency_ms = static_cast<double>(fill_sum) / blocks * 1000.0 / apu.get_sample_rate();
+		const double max_latency = max_fill * 1000.0 / apu.get_sample_rate();
+		const u32 problems = static_cast<u32>(late_underruns) + (latency_ms > 20.0 ? 1 : 0);
+
+		std::cout << "Audio Ring Test [" << latency << "ms target, consumer +" << (drift - 1.0) * 100.0 << "%]: " << (problems ? "FAILED" : "passed")
+			<< " -> " << late_underruns << " underruns, " << latency_ms << "ms latency [" << max_latency << "ms max], " << ring.dropped() << " dropped\n";
+		return problems;
+	}
+#endif // AUDIO_RING_TEST
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+#include "Channels.h"
+#include "Mixer.h"
+#include "RateControl.h"
+#include "SampleRing.h"
+
+namespace NES::APU { // Audio Processing Unit
+
+	constexpr double cpu_clock_rate{ 1789773.0 }; // NTSC, Hz
+
+	// Audio half of the 2A03 | $4000-$4013, $4015, $4017
+	// Runs lazily like the PPU: the CPU Bus catches it up in batches, run() advances every channel from one frame counter step to the next
+	// and the BlipBuffer turns the level changes into samples at the host rate, which land in the SampleRing.
+	class R2A03 {
+	public:
+		R2A03();
+
+		void cpubus_write(u16 address, u8 data);
+		u8 cpubus_read(u16 address); // $4015 | Clears the frame IRQ flag
+
+		// Runs a batch of CPU cycles
+		void run(u64 cycles);
+
+		// IRQ Line | Frame counter or DMC
+		[[nodiscard]] bool irq() const { return _frame_irq || _dmc.irq(); }
+		// Lower bound on the CPU cycles until irq() can become true, 0 if it already is, UINT64_MAX if nothing can raise it
+		[[nodiscard]] u64 cycles_until_irq() const;
+
+		// DMC sample fetches go through the CPU Bus | The reader is charged for the DMA cycles
+		void set_dma_reader(std::function<u8(u16)> reader) { _dmc.set_reader(std::move(reader)); }
+		// CPU cycles until run() makes the next fetch, UINT64_MAX if the DMC has nothing to read
+		[[nodiscard]] u64 cycles_until_dma() const { return _dmc.cycles_until_fetch(); }
+
+		// Host sample rate, 0 stops synthesis [the channels keep running for $4015 and IRQ]
+		void set_sample_rate(u32 sample_rate);
+		[[nodiscard]] u32 get_sample_rate() const { return _sample_rate; }
+
+		// Target audio latency for dynamic rate control [RateControl] | The least reserve left in the ring when a batch lands, the learned
+		// jitter allowance adds up to as much again and the average latency is about half a batch more | 0 -> fixed resampling ratio
+		void set_latency(u32 milliseconds);
+
+		// Off -> synthesized samples are dropped instead of queued [frames emulated for run-ahead that are never heard]
+		void set_output_enabled(bool enabled) { _output_enabled = enabled; }
+
+		// Read by the audio thread | The APU is the producer
+		[[nodiscard]] SampleRing& samples() { return _samples; }
+
+		// Snapshot | Channels and frame counter | Synthesis [BlipBuffer, SampleRing, rate control] is host output and carries on across a load
+		struct State {
+			Pulse				pulse_1{ Channel::Pulse1 };
+			Pulse				pulse_2{ Channel::Pulse2 };
+			Triangle			triangle;
+			Noise				noise;
+			DMC::State			dmc;
+			std::array<u8, 5>	levels; // Mixer inputs
+			s32					frame_cycle;
+			u8					frame_step;
+			bool				five_step;
+			bool				irq_inhibit;
+			bool				frame_irq;
+		};
+		void save_state(State& state) const;
+		void load_state(const State& state);
+
+	private:
+		// Frame Counter | $4017
+		void frame_step();
+		void quarter_frame();
+		void half_frame();
+
+		void run_channels(u32 cycles);
+		void flush_samples(); // BlipBuffer -> SampleRing
+
+		Pulse		_pulse_1{ Channel::Pulse1 };
+		Pulse		_pulse_2{ Channel::Pulse2 };
+		Triangle	_triangle;
+		Noise		_noise;
+		DMC			_dmc;
+
+		Mixer		_mixer;
+		SampleRing	_samples;
+		RateControl	_rate_control;
+		u32			_sample_rate{ 0 };
+		u32			_latency{ 0 }; // Milliseconds
+		u32			_time{ 0 }; // CPU cycles since the last BlipBuffer::end_frame
+		bool		_output_enabled{ true };
+
+		bool		_five_step{ false }; // Mode 1
+		bool		_irq_inhibit{ false };
+		bool		_frame_irq{ false };
+		u8			_frame_step{ 0 };
+		s32			_frame_cycle{ 0 }; // CPU cycles since the sequence started, negative while a $4017 write is pending
+	};
+
+#if AUDIO_RING_TEST
+	// Plays a tone through the ring into a consumer thread whose clock runs 0.3% fast, like a real sound card against the emulator.
+	// Returns the number of problems [underruns after warm-up, average latency above 20ms].
+	u32 test_audio_ring();
+#endif // AUDIO_RING_TEST
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::APU {
+
+	// Dynamic Rate Control | The emulator and the sound card run on different clocks, so a fixed resampling ratio slowly
+	// over- or underfills any buffer between them. After every batch the producer nudges the ratio by at most max_deviation
+	// [0.5% -> inaudible pitch change] in proportion to how far the ring's fill level is from the target, plus a slowly
+	// learned correction for the steady clock mismatch, so the fill settles on the target instead of below it.
+	// The fill controlled is the reserve: the fewest samples the consumer left in the ring since the last update [SampleRing low-water
+	// mark]. Samples arrive in batches, so the ring draws a sawtooth and only its low point says how late the next batch may be.
+	// A batch that comes late [scheduler jitter] digs below the target; the deepest recent dip [up to the target itself] is added to
+	// the target and held for seconds, so the next late batch of that size still finds the target reserve instead of an empty ring.
+	// The target is only the floor, the learned allowance covers the jitter: a host that never stalls settles on the target alone.
+	// It starts at its cap, so stalls before the first one was seen are covered too, and decays from there.
+	class RateControl {
+	public:
+		// base_factor -> nominal BlipBuffer factor | target_fill -> reserve in samples, 0 disables
+		void configure(u64 base_factor, u32 target_fill, double max_deviation = 0.005) {
+			_base = static_cast<double>(base_factor);
+			_target = target_fill;
+			_max_deviation = max_deviation;
+			_drift = 0.0;
+			_allowance = target_fill;
+		}
+
+		[[nodiscard]] bool enabled() const { return _target != 0; }
+		[[nodiscard]] u32 target() const { return _target; }
+
+		// Factor for the next batch | Below the target -> more samples per clock, above -> fewer
+		[[nodiscard]] u64 update(u32 reserve) {
+			const double dip = std::min<double>(_target, static_cast<double>(_target) - reserve);
+			_allowance = std::max(_allowance * (1.0 - 1.0 / 4096.0), dip); // Decays over ~4096 updates [~12s at one per 3ms audio callback]
+			const double target = _target + _allowance;
+			const double error = std::clamp((target - reserve) / _target, -1.0, 1.0);
+			_drift = std::clamp(_drift + _max_deviation * error / 256.0, -_max_deviation, _max_deviation); // ~1s to learn a 0.3% mismatch
+			return static_cast<u64>(_base * (1.0 + std::clamp(_drift + _max_deviation * error, -_max_deviation, _max_deviation)));
+		}
+
+	private:
+		double	_base{ 0.0 };
+		u32		_target{ 0 };
+		double	_max_deviation{ 0.005 };
+		double	_drift{ 0.0 }; // Integral term, relative
+		double	_allowance{ 0.0 }; // Samples, deepest recent dip below _target
+	};
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::APU {
+
+	// Output Samples | Lock-free single-producer/single-consumer ring between the emulation thread [APU] and the audio thread.
+	// Each side only stores its own position [release] and loads the other's [acquire], no locks and no CAS loops.
+	// Samples that do not fit are dropped, so a front end that never reads [headless] costs nothing but the synthesis.
+	class SampleRing {
+	public:
+		explicit SampleRing(u32 capacity = 8192) { set_capacity(capacity); }
+
+		// Rounded up to a power of 2 | Drops whatever is buffered, neither side may be running
+		void set_capacity(u32 capacity) {
+			u32 size{ 1 };
+			while (size < capacity) size <<= 1;
+			_samples.assign(size, 0);
+			_mask = size - 1;
+			_read.store(0, std::memory_order_relaxed);
+			_write.store(0, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] u32 capacity() const { return _mask + 1; }
+
+		// Fill Level | Samples buffered, exact from either side, a snapshot from anywhere else
+		[[nodiscard]] u32 size() const {
+			return static_cast<u32>(_write.load(std::memory_order_acquire) - _read.load(std::memory_order_acquire));
+		}
+
+		/// PRODUCER ///
+
+		// Returns the samples written, the rest is counted as dropped
+		u32 write(const s16* samples, u32 count) {
+			const u64 write = _write.load(std::memory_order_relaxed);
+			const u64 read = _read.load(std::memory_order_acquire);
+
+			const u32 written = std::min(count, capacity() - static_cast<u32>(write - read));
+			copy_in(write, samples, written);
+			_write.store(write + written, std::memory_order_release);
+
+			if (written != count) _dropped.fetch_add(count - written, std::memory_order_relaxed);
+			return written;
+		}
+
+		/// CONSUMER ///
+
+		// Returns the samples read
+		u32 read(s16* samples, u32 count) {
+			const u64 read = _read.load(std::memory_order_relaxed);
+			const u64 write = _write.load(std::memory_order_acquire);
+
+			count = std::min(count, static_cast<u32>(write - read));
+			copy_out(read, samples, count);
+			_read.store(read + count, std::memory_order_release);
+
+			const u32 left = static_cast<u32>(write - read) - count;
+			if (left < _low_water.load(std::memory_order_relaxed)) _low_water.store(left, std::memory_order_relaxed);
+
+			if (count) _last = samples[count - 1];
+			return count;
+		}
+
+		// Audio callback | Always fills count samples, a short ring repeats the last sample [no click] and counts an underrun
+		void consume(s16* samples, u32 count) {
+			const u32 available = read(samples, count);
+			if (available == count) return;
+
+			std::fill(samples + available, samples + count, _last);
+			_underruns.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Drops whatever is buffered | Consumer side
+		void clear() { _read.store(_write.load(std::memory_order_acquire), std::memory_order_release); }
+
+		/// END ///
+
+		// Low-Water Mark | Fewest samples the consumer left behind since the last call, UINT32_MAX if it has not read since | Producer side
+		// A consumer store racing the reset can only land a level it really left, so no CAS loop is needed.
+		[[nodiscard]] u32 take_low_water() { return _low_water.exchange(UINT32_MAX, std::memory_order_relaxed); }
+
+		// Monitoring | Readable from any thread
+		[[nodiscard]] u64 underruns() const { return _underruns.load(std::memory_order_relaxed); }
+		[[nodiscard]] u64 dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+	private:
+		// Copies across the wrap point in at most two runs
+		void copy_in(u64 position, const s16* samples, u32 count) {
+			const u32 start = static_cast<u32>(position) & _mask;
+			const u32 first = std::min(count, capacity() - start);
+			std::copy(samples, samples + first, _samples.begin() + start);
+			std::copy(samples + first, samples + count, _samples.begin());
+		}
+		void copy_out(u64 position, s16* samples, u32 count) const {
+			const u32 start = static_cast<u32>(position) & _mask;
+			const u32 first = std::min(count, capacity() - start);
+			std::copy(_samples.begin() + start, _samples.begin() + start + first, samples);
+			std::copy(_samples.begin(), _samples.begin() + (count - first), samples + first);
+		}
+
+		std::vector<s16>	_samples;
+		u32					_mask{ 0 };
+
+		// Free-running positions, wrapped by _mask on access | Own cache lines, so the two threads do not share one
+		alignas(64) std::atomic<u64>	_write{ 0 }; // Producer
+		alignas(64) std::atomic<u64>	_read{ 0 }; // Consumer
+		s16								_last{ 0 }; // Consumer, repeated on underrun
+		std::atomic<u32>				_low_water{ UINT32_MAX }; // Consumer lowers it, the producer takes it
+
+		alignas(64) std::atomic<u64>	_underruns{ 0 };
+		std::atomic<u64>				_dropped{ 0 };
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+#include "../Common/CommonHeaders.h"
+#include "../PPU/TileDecoder.h"
+
+namespace NES::Benchmarks {
+
+	// One Case | ops of unit each, timed as the fastest of the suite's repeats
+	struct Result {
+		std::string	name;
+		std::string	unit;
+		u64			ops{ 0 };
+		double		ns_per_op{ 0.0 };
+		double		ops_per_second{ 0.0 };
+		double		instructions_per_second{ 0.0 }; // CPU cases only, 0 otherwise
+	};
+
+	struct Options {
+		u32			repeat{ 5 };
+		double		scale{ 1.0 }; // Multiplies every case's op count [< 1 -> quick smoke run]
+		std::string	filter; // Only cases whose name contains it
+	};
+
+	// Keeps the optimiser from dropping a benchmark loop whose result is otherwise unused
+	inline void do_not_optimize(u64 value) {
+		static volatile u64 sink;
+		sink = value;
+	}
+
+	// Benchmark Suite | Cases are plain callables that do ops operations, the suite times them and formats the results.
+	// Timing is wall clock, best of repeat -> the least disturbed run, which is what is comparable between commits.
+	class Suite {
+	public:
+		explicit Suite(Options options) : _options(std::move(options)) {}
+
+		[[nodiscard]] const Options& options() const { return _options; }
+		[[nodiscard]] const std::vector<Result>& results() const { return _results; }
+
+		[[nodiscard]] bool enabled(const std::string& name) const { return _options.filter.empty() || name.find(_options.filter) != std::string::npos; }
+		[[nodiscard]] u64 scaled(u64 ops) const { return std::max<u64>(1, static_cast<u64>(ops * _options.scale)); }
+
+		// Times function(ops) | Returns the result to add instruction counts to [valid until the next run], nullptr if the filter skipped the case
+		template<typename Function>
+		Result* run(const std::string& name, const char* unit, u64 ops, Function&& function) {
+			if (!enabled(name)) return nullptr;
+
+			ops = scaled(ops);
+			double best = std::numeric_limits<double>::max();
+			for (u32 i{ 0 }; i < std::max<u32>(_options.repeat, 1); ++i) {
+				const auto start = std::chrono::steady_clock::now();
+				function(ops);
+				const auto end = std::chrono::steady_clock::now();
+				best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+			}
+
+			Result& result = _results.emplace_back();
+			result.name = name;
+			result.unit = unit;
+			result.ops = ops;
+			result.ns_per_op = best / ops;
+			result.ops_per_second = best > 0.0 ? ops * 1e9 / best : 0.0;
+			return &result;
+		}
+
+		void print_table(std::FILE* out) const {
+			std::fprintf(out, "%-36s %12s %16s %14s\n", "case", "ns/op", "ops/s", "instr/s");
+			for (const Result& result : _results) {
+				std::fprintf(out, "%-36s %12.3f %16.0f %14.0f  [%s]\n", result.name.c_str(), result.ns_per_op, result.ops_per_second,
+					result.instructions_per_second, result.unit.c_str());
+			}
+		}
+
+		// {"suite", "config" [build options], "results": [{"name", "unit", "ops", "ns_per_op", "ops_per_second", "instructions_per_second"}]}
+		void write_json(std::FILE* out) const {
+			std::fprintf(out, "{\n  \"suite\": \"nes_bench\",\n");
+			std::fprintf(out, "  \"config\": {\"cpu_switch_core\": %d, \"cpu_instruction_cache\": %d, \"cpu_dynarec\": %d, \"cartridge_static_dispatch\": %d, \"ppu_simd\": \"%s\", \"repeat\": %u, \"scale\": %g},\n",
+				CPU_SWITCH_CORE, CPU_INSTRUCTION_CACHE, CPU_DYNAREC, CARTRIDGE_STATIC_DISPATCH, PPU_SIMD_AVX2 ? "AVX2" : PPU_SIMD_SSE2 ? "SSE2" : "Scalar", _options.repeat, _options.scale);
+			std::fprintf(out, "  \"results\": [");
+			for (u64 i{ 0 }; i < _results.size(); ++i) {
+				const Result& result = _results[i];
+				std::fprintf(out, "%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.4f, \"ops_per_second\": %.1f, \"instructions_per_second\": %.1f}",
+					i ? "," : "", result.name.c_str(), result.unit.c_str(), static_cast<unsigned long long>(result.ops), result.ns_per_op,
+					result.ops_per_second, result.instructions_per_second);
+			}
+			std::fprintf(out, "\n  ]\n}\n");
+		}
+
+	private:
+		Options				_options;
+		std::vector<Result>	_results;
+	};
+
+	// The Micro-Benchmark Cases [MicroBenchmarks.cpp] | CPU dispatch, Bus decode per region, mapper, RAM and PPU scanlines
+	void run_micro_benchmarks(Suite& suite);
+}
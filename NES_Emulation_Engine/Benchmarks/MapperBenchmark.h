@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+
+#include "../Cartridge/Cartridge.h"
+
+namespace NES::Benchmarks {
+	namespace detail {
+
+		// PPU-like access pattern | Pattern table fetches across both tables, low and high bit planes
+		inline u16 pattern_address(u32 i) {
+			return static_cast<u16>(((i * 16) & 0x1FF0) | (i & 0x07) | ((i >> 7) & 0x08));
+		}
+
+		template<typename Function>
+		double time_ns_per_access(u32 accesses, Function&& function) {
+			const auto start = std::chrono::steady_clock::now();
+			function();
+			const auto end = std::chrono::steady_clock::now();
+			return std::chrono::duration<double, std::nano>(end - start).count() / accesses;
+		}
+
+		inline void benchmark_mapper(const char* name, NES::Cartridge::GameCard& card, u32 accesses) {
+			u32 checksum{ 0 };
+
+			// Virtual: every access goes through the Mapper vtable
+			const double virtual_ns = time_ns_per_access(accesses, [&] {
+				NES::Cartridge::Mapper* mapper = card.get_mapper().get();
+				for (u32 i{ 0 }; i < accesses; ++i) {
+					u8 data{ 0 };
+					if (card.ppu_read(mapper, pattern_address(i), data)) checksum += data;
+				}
+			});
+
+			// Variant: std::visit on every access [GameCard::ppu_read]
+			const double variant_ns = time_ns_per_access(accesses, [&] {
+				for (u32 i{ 0 }; i < accesses; ++i) {
+					u8 data{ 0 };
+					if (card.ppu_read(pattern_address(i), data)) checksum += data;
+				}
+			});
+
+			// Hoisted: one std::visit, the loop is instantiated per mapper type and the mapping inlines
+			const double hoisted_ns = time_ns_per_access(accesses, [&] {
+				card.visit_mapper([&](auto* mapper) {
+					for (u32 i{ 0 }; i < accesses; ++i) {
+						u8 data{ 0 };
+						if (card.ppu_read(mapper, pattern_address(i), data)) checksum += data;
+					}
+				});
+			});
+
+			std::cout << name << " | virtual: " << virtual_ns << " ns | variant: " << variant_ns << " ns | hoisted: " << hoisted_ns
+				<< " ns | per access [checksum " << checksum << "]\n";
+		}
+
+		inline std::unique_ptr<NES::Cartridge::GameCard> make_card(u16 mapper_id, std::vector<u8>& program, std::vector<u8>& character) {
+			NES::Cartridge::RomInfo info;
+			info.mapper_id = mapper_id;
+			info.program_rom_size = program.size();
+			info.character_rom_size = character.size();
+
+			auto card = std::make_unique<NES::Cartridge::GameCard>();
+			card->set_info(info);
+			card->set_program_banks_count(info.program_banks());
+			card->init_program_memory(program);
+			card->set_character_banks_count(info.character_banks());
+			card->init_character_memory(character);
+			card->set_mapper(NES::Cartridge::MapperRegistry::instance().create(info));
+			return card;
+		}
+
+	} // detail namespace
+
+	// Mapper Dispatch Benchmark | Cost of a PPU pattern fetch through the virtual Mapper, a per-access std::visit and a hoisted std::visit
+	inline void run_mapper_benchmark(u32 accesses = 1u << 26) {
+		std::vector<u8> program(0x20000), character(0x20000);
+		for (u32 i{ 0 }; i < character.size(); ++i) {
+			character[i] = static_cast<u8>(i * 7 + (i >> 8));
+		}
+
+		std::cout << "Mapper Benchmark [" << accesses << " pattern fetches]\n";
+		for (u16 mapper_id : { 0, 1, 4 }) {
+			auto card = detail::make_card(mapper_id, program, character);
+			detail::benchmark_mapper(NES::Cartridge::MapperRegistry::instance().name(mapper_id), *card, accesses);
+		}
+	}
+}
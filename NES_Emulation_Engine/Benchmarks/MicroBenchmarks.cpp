@@ -0,0 +1,253 @@
+#include "Benchmark.h"
+#include "MapperBenchmark.h"
+#include "../System/Console.h"
+#include "../Cartridge/iNES1.0/M_000_NROM.h"
+
+namespace NES::Benchmarks {
+	namespace {
+
+		// Synthetic Opcode Mixes | Endless loops at $8000, written out byte by byte like the programs in CpuTest.h
+		struct Program {
+			const char*		name;
+			std::vector<u8>	code;
+		};
+
+		const std::vector<Program>& programs() {
+			static const std::vector<Program> mixes = {
+				{ "alu", { // Register-only arithmetic and logic
+					0xA2, 0x00,			// $8000 LDX #$00
+					0xA0, 0x10,			// $8002 LDY #$10
+					0x18,				// $8004 CLC
+					0x69, 0x03,			// $8005 ADC #$03
+					0x29, 0x7F,			// $8007 AND #$7F
+					0x49, 0x55,			// $8009 EOR #$55
+					0x0A,				// $800B ASL A
+					0x4A,				// $800C LSR A
+					0xE8,				// $800D INX
+					0x88,				// $800E DEY
+					0xD0, 0xF3,			// $800F BNE $8004
+					0x4C, 0x00, 0x80,	// $8011 JMP $8000
+				} },
+				{ "memory", { // Zero page, absolute indexed and indirect indexed loads and stores
+					0xA2, 0x00,			// $8000 LDX #$00
+					0xBD, 0x00, 0x02,	// $8002 LDA $0200,X
+					0x9D, 0x00, 0x03,	// $8005 STA $0300,X
+					0xA5, 0x10,			// $8008 LDA $10
+					0x71, 0x20,			// $800A ADC ($20),Y
+					0x85, 0x11,			// $800C STA $11
+					0xE6, 0x12,			// $800E INC $12
+					0xE8,				// $8010 INX
+					0xD0, 0xEF,			// $8011 BNE $8002
+					0x4C, 0x00, 0x80,	// $8013 JMP $8000
+				} },
+				{ "control", { // Subroutines, stack and taken/untaken branches
+					0xA2, 0x20,			// $8000 LDX #$20
+					0x20, 0x10, 0x80,	// $8002 JSR $8010
+					0x48,				// $8005 PHA
+					0x68,				// $8006 PLA
+					0xCA,				// $8007 DEX
+					0xD0, 0xF8,			// $8008 BNE $8002
+					0x4C, 0x00, 0x80,	// $800A JMP $8000
+					0xEA, 0xEA, 0xEA,	// $800D NOP [padding]
+					0xC9, 0x00,			// $8010 CMP #$00
+					0xF0, 0x01,			// $8012 BEQ $8015
+					0xEA,				// $8014 NOP
+					0x60,				// $8015 RTS
+				} },
+			};
+			return mixes;
+		}
+
+		// Synthetic NROM Cartridge | 32KB PRG-ROM with the program at $8000, NMI/IRQ on an RTI, 8KB CHR-ROM with a fixed pattern.
+		// The card only views the buffers, so the fixture owns them.
+		struct Fixture {
+			std::vector<u8>		program = std::vector<u8>(0x8000, 0xEA);
+			std::vector<u8>		character = std::vector<u8>(0x2000);
+			System::Console		console;
+
+			explicit Fixture(const std::vector<u8>& code = {}) {
+				std::copy(code.begin(), code.end(), program.begin());
+				program[0x7FF0] = 0x40; // $FFF0 RTI
+				const u16 vectors[3] = { 0xFFF0, 0x8000, 0xFFF0 }; // NMI, Reset, IRQ/BRK
+				for (u32 i{ 0 }; i < 3; ++i) {
+					program[0x7FFA + i * 2] = vectors[i] & 0xFF;
+					program[0x7FFB + i * 2] = vectors[i] >> 8;
+				}
+				for (u32 i{ 0 }; i < character.size(); ++i) {
+					character[i] = static_cast<u8>(i * 7 + (i >> 8));
+				}
+				console.insert_cartridge(std::shared_ptr<Cartridge::GameCard>(detail::make_card(0, program, character)));
+			}
+		};
+
+		// Instructions the program executes in its first cycles after reset | Deterministic, so a separate counting pass is exact
+		u64 count_instructions(const Program& program, u64 cycles) {
+			Fixture fixture(program.code);
+			CPU::R6502& cpu = fixture.console.cpu();
+			const u64 start = cpu.get_cycle();
+
+			u64 instructions{ 0 };
+			while (cpu.get_cycle() - start < cycles) {
+				cpu.step();
+				++instructions;
+			}
+			return instructions;
+		}
+
+		void add_instruction_rate(const Program& program, Result* result) {
+			if (!result) return;
+			const double seconds = result->ns_per_op * result->ops * 1e-9;
+			result->instructions_per_second = count_instructions(program, result->ops) / seconds;
+		}
+
+		void benchmark_cpu(Suite& suite) {
+			for (const Program& program : programs()) {
+				Fixture fixture(program.code);
+				CPU::R6502& cpu = fixture.console.cpu();
+
+				// One call per CPU cycle, the way a cycle-stepped front end drives it
+				add_instruction_rate(program, suite.run(std::string("cpu/clock/") + program.name, "cycle", 4'000'000, [&](u64 ops) {
+					cpu.reset();
+					for (u64 i{ 0 }; i < ops; ++i) cpu.clock();
+				}));
+				// Cycle-budgeted batch, the way the Console drives it
+				add_instruction_rate(program, suite.run(std::string("cpu/run_cycles/") + program.name, "cycle", 4'000'000, [&](u64 ops) {
+					cpu.reset();
+					cpu.run_cycles(ops);
+				}));
+			}
+		}
+
+		// Bus decode per region | Addresses stride through the region, every access goes through the page table
+		void benchmark_bus(Suite& suite) {
+			struct Region {
+				const char*	name;
+				u16			base;
+				u16			mask;
+			};
+			constexpr Region regions[] = {
+				{ "ram", 0x0000, 0x1FFF }, // Plain memory page
+				{ "ppu", 0x2000, 0x0007 }, // Handler + PPU catch up check
+				{ "apu_io", 0x4000, 0x0017 }, // Handler + APU registers
+				{ "prg_rom", 0x8000, 0x7FFF }, // Plain memory page [reads], mapper [writes]
+			};
+
+			Fixture fixture;
+			CPU::Bus& bus = fixture.console.bus();
+			for (const Region& region : regions) {
+				suite.run(std::string("bus/read/") + region.name, "read", 16'000'000, [&](u64 ops) {
+					u64 checksum{ 0 };
+					for (u64 i{ 0 }; i < ops; ++i) checksum += bus.read(region.base | ((i * 7) & region.mask));
+					do_not_optimize(checksum);
+				});
+				suite.run(std::string("bus/write/") + region.name, "write", 16'000'000, [&](u64 ops) {
+					for (u64 i{ 0 }; i < ops; ++i) bus.write(region.base | ((i * 7) & region.mask), static_cast<u8>(i));
+				});
+			}
+
+			// OAM DMA | One $4014 write per op, a whole page into OAM | Games do one a frame
+			constexpr Region sources[] = { { "ram", 0x0200, 0 }, { "prg_rom", 0x8000, 0 } };
+			for (const Region& source : sources) {
+				suite.run(std::string("bus/oam_dma/") + source.name, "dma", 2'000'000, [&](u64 ops) {
+					for (u64 i{ 0 }; i < ops; ++i) {
+						bus.write(0x4014, static_cast<u8>(source.base >> 8));
+						do_not_optimize(bus.take_stall_cycles(i));
+					}
+				});
+			}
+		}
+
+		void benchmark_mapper(Suite& suite) {
+			Cartridge::NROM nrom(2, 1); // Concrete type -> the mapping inlines
+			suite.run("mapper/nrom/cpuMapRead", "read", 64'000'000, [&](u64 ops) {
+				u64 checksum{ 0 };
+				for (u64 i{ 0 }; i < ops; ++i) {
+					u32 mapped{ 0 };
+					u8 data{ 0 };
+					if (nrom.cpuMapRead(static_cast<u16>(0x8000 | i), mapped, data)) checksum += mapped;
+				}
+				do_not_optimize(checksum);
+			});
+
+			Fixture fixture;
+			Cartridge::Mapper* mapper = fixture.console.cartridge()->get_mapper().get(); // Through the vtable
+			suite.run("mapper/nrom/cpuMapRead_virtual", "read", 64'000'000, [&](u64 ops) {
+				u64 checksum{ 0 };
+				for (u64 i{ 0 }; i < ops; ++i) {
+					u32 mapped{ 0 };
+					u8 data{ 0 };
+					if (mapper->cpuMapRead(static_cast<u16>(0x8000 | i), mapped, data)) checksum += mapped;
+				}
+				do_not_optimize(checksum);
+			});
+		}
+
+		void benchmark_ram(Suite& suite) {
+			Memory::RAM ram;
+			suite.run("ram/read", "read", 64'000'000, [&](u64 ops) {
+				u64 checksum{ 0 };
+				for (u64 i{ 0 }; i < ops; ++i) checksum += ram.read(static_cast<u16>((i * 7) & 0x1FFF));
+				do_not_optimize(checksum);
+			});
+			suite.run("ram/write", "write", 64'000'000, [&](u64 ops) {
+				for (u64 i{ 0 }; i < ops; ++i) ram.write(static_cast<u16>((i * 7) & 0x1FFF), static_cast<u8>(i));
+				do_not_optimize(ram.read(0x0007));
+			});
+		}
+
+		// PPU Scanlines | A busy screen: every nametable byte, palette entry and sprite in use, background and sprites on.
+		// One op is 341 dots, so vertical blank lines are averaged in like they are in a real frame.
+		void benchmark_ppu(Suite& suite) {
+			Fixture fixture;
+			PPU::R2C02& ppu = *fixture.console.bus().get_ppu();
+
+			ppu.cpubus_write(0x2006, 0x20);
+			ppu.cpubus_write(0x2006, 0x00);
+			for (u32 i{ 0 }; i < 0x0400; ++i) ppu.cpubus_write(0x2007, static_cast<u8>(i * 13)); // Nametable + attributes
+			ppu.cpubus_write(0x2006, 0x3F);
+			ppu.cpubus_write(0x2006, 0x00);
+			for (u32 i{ 0 }; i < 0x20; ++i) ppu.cpubus_write(0x2007, static_cast<u8>(i * 5 + 1));
+
+			ppu.cpubus_write(0x2003, 0x00);
+			for (u32 i{ 0 }; i < 64; ++i) { // Y, tile, attributes, X
+				ppu.cpubus_write(0x2004, static_cast<u8>(i * 3));
+				ppu.cpubus_write(0x2004, static_cast<u8>(i));
+				ppu.cpubus_write(0x2004, static_cast<u8>((i & 0x03) | ((i & 0x04) << 3) | ((i & 0x08) << 3)));
+				ppu.cpubus_write(0x2004, static_cast<u8>(i * 4));
+			}
+			ppu.cpubus_write(0x2005, 0x00);
+			ppu.cpubus_write(0x2005, 0x00);
+			ppu.cpubus_write(0x2000, 0x08); // Sprites from the second pattern table, NMI off
+			ppu.cpubus_write(0x2001, 0x1E); // Background + sprites, left column on
+
+			suite.run("ppu/scanline/render", "scanline", 200'000, [&](u64 ops) { ppu.run(ops * 341); });
+
+			fixture.console.set_rendering(false);
+			suite.run("ppu/scanline/headless", "scanline", 200'000, [&](u64 ops) { ppu.run(ops * 341); });
+		}
+
+		// Save States | A whole snapshot per op, into storage allocated once
+		void benchmark_state(Suite& suite) {
+			Fixture fixture(programs()[1].code);
+			fixture.console.run_cycles(100'000);
+			const auto state = std::make_unique<System::SaveState>();
+
+			suite.run("state/save", "state", 20'000, [&](u64 ops) {
+				for (u64 i{ 0 }; i < ops; ++i) do_not_optimize(fixture.console.save_state(*state));
+			});
+			suite.run("state/load", "state", 20'000, [&](u64 ops) {
+				for (u64 i{ 0 }; i < ops; ++i) do_not_optimize(fixture.console.load_state(*state));
+			});
+		}
+
+	} // Anonymous Namespace
+
+	void run_micro_benchmarks(Suite& suite) {
+		benchmark_cpu(suite);
+		benchmark_bus(suite);
+		benchmark_mapper(suite);
+		benchmark_ram(suite);
+		benchmark_ppu(suite);
+		benchmark_state(suite);
+	}
+}
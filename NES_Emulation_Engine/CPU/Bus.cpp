@@ -17,80 +17,226 @@ namespace NES::CPU {
 
 	} // Anonymous Namespace
 
-	// Writes to the Address Bus
-	void Bus::write(u16 address, u8 data) {
-		assert(address >= 0x0000 && address <= 0xFFFF);
+	// Builds the Page Table | The chip select decode happens once here instead of on every access
+	void Bus::map_pages() {
+		for (u32 page{ 0 }; page < 256; ++page) {
+			const u16 address = page << 8;
+			_read_memory[page] = nullptr;
+			_write_memory[page] = nullptr;
+
+			switch (chip_select(address)) {
+			case 0: // $0000 SRAM/WRAM | 2KB mirrored up to $1FFF
+				_read_memory[page] = _write_memory[page] = _ram->data() + (address & 0x0700);
+				break;
+
+			case 1: // $2000-$0x3FFF PPU
+				_read_handler[page] = &Bus::read_ppu;
+				_write_handler[page] = &Bus::write_ppu;
+				break;
+
+			case 2: // $4000 I/O Registers + Cartridge
+				_read_handler[page] = chip_select_4000(address) ? &Bus::read_cartridge : &Bus::read_io; // $4000-$40FF shares its page with the I/O Registers
+				_write_handler[page] = chip_select_4000(address) ? &Bus::write_cartridge : &Bus::write_io;
+				break;
+
+			case 3: // $6000 Cartridge
+				_read_handler[page] = &Bus::read_cartridge;
+				_write_handler[page] = &Bus::write_cartridge;
+				break;
+
+			default:
+				break;
+			}
+		}
 
-		switch (chip_select(address)) {
-		case 0: // $0000 SRAM/WRAM
-			_ram->write(address, data);
-			break;
+		if (_cartridge_inserted) {
+			map_cartridge(0x4100, 0xFFFF);
+		}
+		if (_code_remapped) _code_remapped(0x00, 0xFF);
+		if (_code_ram_written) _code_ram_written(0x0000, 0x07FF); // Watched pages are plain memory again [or the RAM moved]
+	}
 
-		case 1: // $2000-$0x3FFF PPU
-			_ppu->write(address, data);
-			break; 
+	void Bus::insert_cartridge(std::shared_ptr<NES::Cartridge::GameCard> card) {
+		_cartridge = card;
+		_cartridge_inserted = (card != nullptr);
 
-		case 2: // $4000 I/O Registers + Cartridge
-			if (chip_select_4000(address)) { // $4020-5FFF Cartridge
-				_cartridge->cpu_write(address, data);
-			} else { // $4000-401F I/O Registers
+		_irq_source = nullptr;
+		if (_cartridge_inserted) {
+			_cartridge->get_mapper()->set_bank_switch_callback([this](u16 start, u16 end) { map_cartridge(start, end); });
+			if (_cartridge->get_mapper()->has_irq()) _irq_source = _cartridge->get_mapper().get();
+		}
+		schedule_mapper_irq();
+		_ppu->connect_cartridge(card);
+		map_pages();
+	}
 
-			}
-			break; 
+	// PRG-ROM pages get a direct pointer, the rest stay on the cartridge handler | Writes always go to the mapper [bank registers]
+	void Bus::map_cartridge(u16 start, u16 end) {
+		if (!_cartridge_inserted) return;
 
-		case 3: // $6000 Cartridge
-			_cartridge->cpu_write(address, data);
-			break;
+		const u32 first = std::max<u32>(start >> 8, 0x41);
+		for (u32 page{ first }; page <= (end >> 8); ++page) {
+			_read_memory[page] = _cartridge->cpu_read_page(page << 8);
+		}
+		if (_code_remapped) _code_remapped(static_cast<u16>(first), end >> 8);
+	}
 
-		default:
-			break;
+	void Bus::watch_ram(u8 page) {
+		const u8* memory = _read_memory[page];
+		for (u32 mirror{ 0 }; mirror < 0x20; ++mirror) { // $0000-$1FFF
+			if (_read_memory[mirror] != memory) continue;
+			_write_memory[mirror] = nullptr;
+			_write_handler[mirror] = &Bus::write_watched_ram;
 		}
 	}
 
-	// Reads from the Address Bus
-	u8 Bus::read(u16 address, bool bReadOnly) {
-		//assert(address); Can't assert, I'm using the whole range...
-		assert(address >= 0x0000 && address <= 0xFFFF);
+	// Writes to a RAM page holding decoded code
+	void Bus::write_watched_ram(u16 address, u8 data) {
+		const u16 offset = address & 0x07FF;
+		_ram->data()[offset] = data;
+		if (_code_ram_written) _code_ram_written(offset, offset);
+	}
 
-		switch (chip_select(address)) {
-		case 0: // $0000 SRAM/WRAM
-			return _ram->read(address);
+	void Bus::save_state(State& state) const {
+		state.cpu_cycle = _cpu_cycle;
+		state.synced_cycle = _synced_cycle;
+		state.apu_cycle = _apu_cycle;
+		state.nmi_cycle = _nmi_cycle;
+		state.irq_cycle = _irq_cycle;
+		state.dma_cycle = _dma_cycle;
+		state.stall_cycles = _stall_cycles;
+		for (u32 port{ 0 }; port < 2; ++port) _controllers[port].save_state(state.controllers[port]);
+		std::copy_n(_ram->data(), state.ram.size(), state.ram.begin());
+	}
 
-		case 1: // $2000-$0x3FFF PPU
-			return _ppu->read(address);
+	void Bus::load_state(const State& state) {
+		_cpu_cycle = state.cpu_cycle;
+		_synced_cycle = state.synced_cycle;
+		_apu_cycle = state.apu_cycle;
+		_nmi_cycle = state.nmi_cycle;
+		_irq_cycle = state.irq_cycle;
+		_dma_cycle = state.dma_cycle;
+		_stall_cycles = state.stall_cycles;
+		_mapper_irq_cycle = _irq_source ? 0 : UINT64_MAX; // Predicted again at the first poll, from the restored counter [not part of the snapshot]
+		for (u32 port{ 0 }; port < 2; ++port) _controllers[port].load_state(state.controllers[port]);
+		std::copy(state.ram.begin(), state.ram.end(), _ram->data());
+		if (_code_ram_written) _code_ram_written(0x0000, 0x07FF);
+		map_cartridge(0x4100, 0xFFFF); // The restored banks may differ from the ones the page table points at
+	}
 
-		case 2: // $4000 I/O Registers + Cartridge
-			if (chip_select_4000(address)) // $4020-5FFF Cartridge
-				return _cartridge->cpu_read(address);
-			else { // $4000-401F I/O Registers
+	// Reads from the PPU Registers
+	u8 Bus::read_ppu(u16 address) {
+		++_device_accesses;
+		catch_up_ppu();
+		return _ppu->cpubus_read(address);
+	}
 
-			}
-			break;
+	// Writes to the PPU Registers
+	void Bus::write_ppu(u16 address, u8 data) {
+		++_device_accesses;
+		catch_up_ppu();
+		_ppu->cpubus_write(address, data);
+		schedule_nmi(); // PPUCTRL can raise NMI right away
+	}
+
+	// Reads from the Page at $4000 -> I/O Registers + Cartridge
+	u8 Bus::read_io(u16 address) {
+		if (chip_select_4000(address)) { // $4020-40FF Cartridge
+			return read_cartridge(address);
+		}
 
-		case 3: // $6000 Cartridge
+		// $4000-401F I/O Registers
+		++_device_accesses;
+		if (address == 0x4015) { // APU Status
+			catch_up_apu();
+			const u8 status = _apu->cpubus_read(address);
+			schedule_irq(); // Reading acknowledges the frame IRQ
+			return status;
+		}
+		if (address == 0x4016 || address == 0x4017) { // Controllers | The upper bits are open bus, the address' high byte on most boards
+			return 0x40 | _controllers[address & 1].read();
+		}
+		return 0x00;
+	}
+
+	// Writes to the Page at $4000 -> I/O Registers + Cartridge
+	void Bus::write_io(u16 address, u8 data) {
+		if (chip_select_4000(address)) { // $4020-40FF Cartridge
+			write_cartridge(address, data);
+			return;
+		}
+
+		// $4000-401F I/O Registers
+		++_device_accesses;
+		if (address == 0x4014) { // OAM DMA
+			oam_dma(data);
+			return;
+		}
+		if (address == 0x4016) { // Controller strobe, both ports
+			for (NES::Input::Controller& controller : _controllers) controller.write_strobe(data & 0x01);
+			return;
+		}
+		if (address <= 0x4013 || address == 0x4015 || address == 0x4017) { // APU
+			catch_up_apu();
+			_apu->cpubus_write(address, data);
+			schedule_irq();
+		}
+	}
+
+	// OAM DMA | $XX00-$XXFF into OAM in one go, the CPU is charged the 513/514 cycles instead of stepping through them.
+	// RAM and PRG-ROM pages are copied straight from the page table, the rest [PRG-RAM, I/O] is read byte by byte like the DMA unit does.
+	void Bus::oam_dma(u8 page) {
+		catch_up_ppu(); // OAM as it was when the write happened
+		if (const u8* memory = _read_memory[page]) {
+			_ppu->oam_dma(memory);
+		} else {
+			std::array<u8, 256> data;
+			for (u32 i{ 0 }; i < 256; ++i) data[i] = read(static_cast<u16>((page << 8) | i));
+			_ppu->oam_dma(data.data());
+		}
+		_stall_cycles += 513;
+		_oam_dma_started = true;
+	}
+
+	// Reads from the Cartridge pages that are not plain PRG-ROM
+	u8 Bus::read_cartridge(u16 address) {
 #if !(CPU_TEST | RAM_TEST)
-			return _cartridge->cpu_read(address);
+		return _cartridge_inserted ? _cartridge->cpu_read(address) : 0x00;
 #else
-			switch (address) {
+		switch (address) {
 
-			// NMI Handler Address:
-			case 0xFFFA: return 0x00;
-			case 0xFFFB: return 0x00;
+		// NMI Handler Address:
+		case 0xFFFA: return 0x00;
+		case 0xFFFB: return 0x00;
 
-			// Program Address:
-			case 0xFFFC: return 0x00;
-			case 0xFFFD: return 0x00;
+		// Program Address:
+		case 0xFFFC: return 0x00;
+		case 0xFFFD: return 0x00;
 
-			// IRQ Handler Address:
-			case 0xFFFE: return 0x00;
-			case 0xFFFF: return 0x07;
+		// IRQ Handler Address:
+		case 0xFFFE: return 0x00;
+		case 0xFFFF: return 0x07;
 
-			default: break;
-			}
+		default: return 0x00;
+		}
 #endif
+	}
 
-		default:
-			return 0x00; // Address Out of Range | Like how would this even happen? address range for uint_16 -> [0x0000, 0xFFFF] ??
+	// Writes to the Cartridge -> PRG-RAM or Mapper Registers
+	// A register write [CHR banks, mirroring, IRQ counter, PRG banks the DMC fetches from] changes what every cycle not yet
+	// caught up would see -> a sync point like the PPU registers. PRG-RAM at $6000-$7FFF is plain storage and stays lazy.
+	void Bus::write_cartridge(u16 address, u8 data) {
+		if (!_cartridge_inserted) return;
+		const bool registers = address < 0x6000 || address >= 0x8000;
+		if (registers) {
+			++_device_accesses;
+			catch_up();
+		}
+		_cartridge->cpu_write(address, data);
+		if (registers) {
+			schedule_nmi();
+			schedule_irq();
+			schedule_mapper_irq();
 		}
 	}
-}
\ No newline at end of file
+}
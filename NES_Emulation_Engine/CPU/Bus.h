@@ -3,7 +3,9 @@
 #include "../Common/CommonHeaders.h"
 #include "../Memory/RAM.h"
 #include "../PPU/R2C02.h"
+#include "../APU/R2A03.h"
 #include "../Cartridge/Cartridge.h"
+#include "../Input/Controller.h"
 #include "../Common/CpuTest.h"
 
 namespace NES::CPU {
@@ -13,11 +15,18 @@ namespace NES::CPU {
 		Bus() {
 			_ram = new NES::Memory::RAM();
 			_ppu = new NES::PPU::R2C02();
+			_apu = new NES::APU::R2A03();
+			_apu->set_dma_reader([this](u16 address) { // DMC sample fetch | Halt, dummy, alignment and read cycle
+				_stall_cycles += 4;
+				return read(address);
+			});
+			map_pages();
 		}
 
 		~Bus() { // Delete Pointers
 			delete _ram;
 			delete _ppu;
+			delete _apu;
 		}
 
 		void reset() {
@@ -40,32 +49,236 @@ namespace NES::CPU {
 			TEST_PROGRAM_BRANCH
 #endif // CPU_TEST
 
+			if (_code_ram_written) _code_ram_written(0x0000, 0x07FF); // The test programs above are written behind the Bus' back
 		}
 
 		// Control Bus Function -> To signal if the cpu is reading or writing
 
 		void set_cartridge_inserted(bool value) { _cartridge_inserted = value; }
+		void insert_cartridge(std::shared_ptr<NES::Cartridge::GameCard> card);
 
 		void disassembleRAM() { _ram->disassemble_wram(); }
 		void disassembleRAM(u32 start, u32 end) { // Disassembler - [Start, End)
 			_ram->disassemble_wram(start, end); 
 		}
 
+		// Lazy Synchronization | The CPU publishes its master cycle, devices are only brought up to it on I/O accesses or at the end of a run.
+		// Between instructions that is the start of the next one [interrupt polls]. Before an instruction's data access the CPU moves it
+		// to the bus cycle of that access [access_offset in OpcodeTable.h], so a register read or write reaches a device on its real cycle.
+		void set_cpu_cycle(u64 cycle) { _cpu_cycle = cycle; }
+		void next_cpu_cycle() { ++_cpu_cycle; } // Read-Modify-Write | Each write comes one cycle after the previous access
+		[[nodiscard]] u64 get_cpu_cycle() const { return _cpu_cycle; }
+
+		// Ticks the devices in one batch up to the CPU's master cycle | Returns the CPU cycles the PPU caught up
+		u64 catch_up() {
+			catch_up_apu();
+			return catch_up_ppu();
+		}
+
+		// PPU [and with it the mapper's scanline counter] | Caught up on every PPU register access and NMI poll
+		u64 catch_up_ppu() {
+			const u64 cycles = _cpu_cycle - _synced_cycle;
+			if (cycles) {
+				_ppu->run(cycles * 3); // The PPU runs 3 dots per CPU cycle [NTSC]
+				_synced_cycle = _cpu_cycle;
+				schedule_nmi();
+				schedule_mapper_irq();
+			}
+			return cycles;
+		}
+
+		// APU | Only its own registers and IRQ line need it in sync, so it runs in much longer batches than the PPU
+		void catch_up_apu() {
+			if (_cpu_cycle != _apu_cycle) {
+				_apu->run(_cpu_cycle - _apu_cycle);
+				_apu_cycle = _cpu_cycle;
+				schedule_irq();
+			}
+		}
+
+		// NMI Line | The PPU can only raise NMI at the start of vertical blank or on a PPUCTRL write, so the CPU polls it for free
+		// until the predicted cycle and only then catches the PPU up.
+		[[nodiscard]] bool nmi_asserted() {
+			if (_cpu_cycle < _nmi_cycle) return false;
+			catch_up_ppu();
+			const bool nmi = _ppu->poll_nmi();
+			schedule_nmi();
+			return nmi;
+		}
+
+		// DMC DMA | Sample fetches happen as the APU runs, so it is caught up at the predicted fetch cycle whatever the interrupt
+		// disable flag -> the fetch reads the PRG bank mapped at that time and its stall lands on the instruction running then.
+		void poll_dma() {
+			if (_cpu_cycle >= _dma_cycle) catch_up_apu();
+		}
+
+		// IRQ Line | Level-sensitive, polled by the CPU between instructions. The APU is predicted like NMI, and so is the board's
+		// scanline counter [from the clocks it has left]: the PPU is only caught up once the counter can have run out.
+		[[nodiscard]] bool irq_asserted() {
+			if (_cpu_cycle >= _irq_cycle) {
+				catch_up_apu();
+				if (_apu->irq()) return true;
+			}
+			if (_cpu_cycle < _mapper_irq_cycle) return false;
+			catch_up_ppu();
+			return _irq_source->irq_state();
+		}
+
 		// Writes Data to the Address Location on the Bus
-		void write(u16 address, u8 data);
+		void write(u16 address, u8 data) {
+			if (u8* memory = _write_memory[address >> 8]) { // Plain memory -> single indexed store
+				memory[address & 0x00FF] = data;
+				return;
+			}
+			(this->*_write_handler[address >> 8])(address, data);
+		}
+
 		// Reads Data from the Address Location on the Bus
-		[[nodiscard]]u8 read(u16 address, bool bReadOnly = false);
+		[[nodiscard]]u8 read(u16 address, bool bReadOnly = false) {
+			if (const u8* memory = _read_memory[address >> 8]) { // Plain memory -> single indexed load
+				return memory[address & 0x00FF];
+			}
+			return (this->*_read_handler[address >> 8])(address);
+		}
+
+		// Device Accesses | Counts the accesses that reached the PPU, APU, controllers or mapper registers. Code running without
+		// interrupt polls [R6502::run_block] ends after an instruction that moved it: the access may have moved the interrupt horizon or started a DMA.
+		[[nodiscard]] u64 device_accesses() const { return _device_accesses; }
+
+		// DMA Stalls | Cycles stolen from the CPU since the last call [OAM DMA, DMC fetches], charged by the CPU to the current instruction.
+		// end_cycle is the cycle that instruction ends on: OAM DMA halts the CPU right after the $4014 write and waits one more cycle
+		// when that is an odd [put] cycle -> 513 or 514.
+		[[nodiscard]] u64 take_stall_cycles(u64 end_cycle) {
+			u64 cycles = _stall_cycles;
+			if (_oam_dma_started) {
+				cycles += end_cycle & 1;
+				_oam_dma_started = false;
+			}
+			_stall_cycles = 0;
+			return cycles;
+		}
+
+		[[nodiscard]] NES::PPU::R2C02* get_ppu() { return _ppu; }
+		[[nodiscard]] NES::APU::R2A03* get_apu() { return _apu; }
+		[[nodiscard]] NES::Memory::RAM* get_ram() { return _ram; }
+		// Moves the 2KB RAM to storage owned by the caller [Memory::RAM::attach] and points the page table at it
+		void attach_ram(u8* storage) {
+			_ram->attach(storage);
+			map_pages();
+		}
+		[[nodiscard]] NES::Input::Controller& get_controller(u32 port) { return _controllers[port & 1]; } // 0 -> $4016, 1 -> $4017
+
+		// Refreshes the page table entries of the cartridge for [start, end] | Called by the mapper on bank switches
+		void map_cartridge(u16 start, u16 end);
+
+		// Code Watch | Lets the CPU keep pre-decoded code [R6502 instruction cache] in step with the memory it came from.
+		// remapped(first, last) -> pages [first, last] may now point at other memory [bank switch], all 256 when the page table
+		// is rebuilt [the cartridge or the RAM storage may be new, host pointers seen before mean nothing].
+		// ram_written(first, last) -> RAM bytes [first, last] (offsets into the 2KB) changed, either by a write to a watched page or all at once.
+		void set_code_listener(std::function<void(u16, u16)> remapped, std::function<void(u16, u16)> ram_written) {
+			_code_remapped = std::move(remapped);
+			_code_ram_written = std::move(ram_written);
+		}
+		// Host pointer of the plain memory at the page, nullptr for handler pages
+		[[nodiscard]] const u8* memory_page(u8 page) const { return _read_memory[page]; }
+		// Routes the writes to the RAM page and its mirrors through write_watched_ram until the page table is rebuilt
+		void watch_ram(u8 page);
+
+		// Page Table for translated code [R6502 dynarec] | Indexed by the emitted code, nullptr -> handler page [or watched, for writes]
+		[[nodiscard]] const u8* const* read_pages() const { return _read_memory.data(); }
+		[[nodiscard]] u8* const* write_pages() const { return _write_memory.data(); }
+
+		// Interrupt Horizon | Until this cycle, polling NMI [and IRQ unless masked] returns false without catching a device up.
+		// Only I/O accesses move it. DMA ends it: cycles not yet charged belong to the next instruction the interpreter runs,
+		// and a DMC fetch has to happen on its cycle.
+		[[nodiscard]] u64 quiet_until(bool irq_masked) const {
+			if (_stall_cycles || _oam_dma_started) return _cpu_cycle;
+			const u64 quiet = std::min(_nmi_cycle, _dma_cycle);
+			if (irq_masked) return quiet;
+			return std::min({ quiet, _irq_cycle, _mapper_irq_cycle });
+		}
+
+		// Snapshot | The sync points and the 2KB RAM, the devices behind the Bus have their own
+		struct State {
+			u64						cpu_cycle;
+			u64						synced_cycle;
+			u64						apu_cycle;
+			u64						nmi_cycle;
+			u64						irq_cycle;
+			u64						dma_cycle;
+			u64						stall_cycles;
+			std::array<NES::Input::Controller::State, 2>	controllers;
+			std::array<u8, 0x0800>	ram;
+		};
+		void save_state(State& state) const;
+		void load_state(const State& state); // Refreshes the cartridge pages too -> restore the mapper first
 
 	private:
+		using ReadHandler = u8(Bus::*)(u16);
+		using WriteHandler = void(Bus::*)(u16, u8);
+
+		// Page Table | One entry per 256-byte page of the CPU address space.
+		// Plain memory [RAM mirrors, PRG-ROM banks] gets a direct host pointer to the start of the page, everything else [I/O, mapper registers] a handler.
+		std::array<u8*, 256>						_read_memory{};
+		std::array<u8*, 256>						_write_memory{};
+		std::array<ReadHandler, 256>				_read_handler{};
+		std::array<WriteHandler, 256>				_write_handler{};
+
+		void map_pages();
+
+		// Earliest CPU cycle the PPU can have NMI pending | Rounded down, an early check only costs one catch up
+		void schedule_nmi() { _nmi_cycle = _synced_cycle + _ppu->dots_until_nmi() / 3; }
+		// Earliest CPU cycle the APU can pull IRQ, and the cycle of its next DMC fetch
+		void schedule_irq() {
+			const u64 cycles = _apu->cycles_until_irq();
+			_irq_cycle = (cycles == UINT64_MAX) ? UINT64_MAX : _apu_cycle + cycles;
+			const u64 fetch = _apu->cycles_until_dma();
+			_dma_cycle = (fetch == UINT64_MAX) ? UINT64_MAX : _apu_cycle + fetch;
+		}
+		// Earliest CPU cycle the board's scanline counter can pull IRQ | Rounded down like NMI, UINT64_MAX without an IRQ source
+		void schedule_mapper_irq() {
+			const u64 clocks = _irq_source ? _irq_source->scanlines_until_irq() : UINT64_MAX;
+			if (clocks == UINT64_MAX) _mapper_irq_cycle = UINT64_MAX;
+			else _mapper_irq_cycle = _synced_cycle + (clocks ? _ppu->dots_until_scanline_clocks(clocks) / 3 : 0);
+		}
+
+		// Handlers for the pages that are not plain memory
+		u8 read_ppu(u16 address);
+		void write_ppu(u16 address, u8 data);
+		u8 read_io(u16 address);
+		void write_io(u16 address, u8 data);
+		u8 read_cartridge(u16 address);
+		void write_cartridge(u16 address, u8 data);
+		void write_watched_ram(u16 address, u8 data);
+
+		void oam_dma(u8 page);
+
 
 		// R6502 _cpu;
 		// Instance or whatever data is needed by PPU from the cartridge
 		bool										_cartridge_inserted{ false };
 		std::shared_ptr<NES::Cartridge::GameCard>	_cartridge;
+		NES::Cartridge::Mapper*						_irq_source{ nullptr }; // Mapper with a scanline counter [MMC3], pulls the IRQ line
 
 		// I/O Registers
 		NES::PPU::R2C02*							_ppu;
+		NES::APU::R2A03*							_apu;
 		NES::Memory::RAM*							_ram;
+		std::array<NES::Input::Controller, 2>		_controllers;
+
+		std::function<void(u16, u16)>				_code_remapped;
+		std::function<void(u16, u16)>				_code_ram_written;
+
+		u64											_cpu_cycle{ 0 }; // CPU master cycle of the current bus access [instruction start between instructions]
+		u64											_synced_cycle{ 0 }; // CPU cycle the PPU has been caught up to
+		u64											_apu_cycle{ 0 }; // CPU cycle the APU has been caught up to
+		u64											_nmi_cycle{ 0 }; // CPU cycle to poll the PPU's NMI output at
+		u64											_irq_cycle{ 0 }; // CPU cycle to poll the APU's IRQ output at
+		u64											_dma_cycle{ 0 }; // CPU cycle of the next DMC sample fetch
+		u64											_mapper_irq_cycle{ UINT64_MAX }; // CPU cycle to poll the board's IRQ output at
+		u64											_stall_cycles{ 0 }; // DMA cycles not yet charged to the CPU
+		bool										_oam_dma_started{ false }; // Alignment cycle still to add, never set between instructions
+		u64											_device_accesses{ 0 };
 
 	};
 
@@ -0,0 +1,932 @@
+#include "Dynarec.h"
+
+#if CPU_DYNAREC
+
+#include <cstddef>
+#include <cstring>
+
+#include "Bus.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif // _WIN32
+
+namespace NES::CPU {
+	namespace {
+
+		/// x86-64 Assembler ///
+		// Just the forms the translator emits. Jumps are always rel32, labels and jumps out of the block are patched when the code is placed.
+
+		enum Reg : u8 {
+			RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15,
+			NONE = 0xFF
+		};
+
+		// Pinned for the whole block | Scratch: RAX, RCX, RDX
+		constexpr Reg CONTEXT = RBX;
+		constexpr Reg READ = R8; // Bus::read_pages()
+		constexpr Reg WRITE = R9; // Bus::write_pages()
+		constexpr Reg A = R12;
+		constexpr Reg X = R13;
+		constexpr Reg Y = R14;
+		constexpr Reg SP = R15;
+		constexpr Reg NZ = RBP; // Lazy N/Z [below]
+		constexpr Reg CARRY = R10; // 0/1
+		constexpr Reg OVERFLOW = R11; // 0/1
+		constexpr Reg CYCLES = RDI; // Dynamic cycles [OOPS], the static ones are added at the exits
+		constexpr Reg COUNT = RSI; // Instructions of the passes before this one
+
+		// Lazy N/Z | The value the interpreter would derive the flags from, kept as is: Z = (NZ & 0x7FFF) == 0, N = (NZ & 0x8080) != 0.
+		// Loads and logic keep the 8-bit result. ADC/SBC keep the 9-bit sum [Z is set from it, like the interpreter does], CMP and ORA
+		// build the pair their flags actually are [N from the borrow, Z from the operand's bit 7] with N in bit 15.
+		constexpr u32 zero_mask{ 0x7FFF };
+		constexpr u32 negative_mask{ 0x8080 };
+
+		enum Cond : u8 { O = 0x0, NO = 0x1, B = 0x2, AE = 0x3, E = 0x4, NE = 0x5, BE = 0x6, ABOVE = 0x7 };
+		enum Alu : u8 { ADD = 0, OR = 1, ADC_ = 2, SBB = 3, AND_ = 4, SUB = 5, XOR = 6, CMP_ = 7 };
+		enum Shift : u8 { RCL = 2, RCR = 3, SHL = 4, SHR = 5 };
+
+		struct Mem {
+			Reg		base;
+			Reg		index{ NONE };
+			u8		scale{ 1 };
+			s32		disp{ 0 };
+		};
+
+		struct Label {
+			u32		id;
+		};
+
+		class Assembler {
+		public:
+			[[nodiscard]] u64 size() const { return _bytes.size(); }
+
+			Label label() {
+				_labels.push_back(-1);
+				return { static_cast<u32>(_labels.size() - 1) };
+			}
+			void bind(Label label) { _labels[label.id] = static_cast<s64>(_bytes.size()); }
+
+			void mov64(Reg dst, Reg src) { rr({ 0x89 }, src, dst, true); }
+			void mov32(Reg dst, Reg src) { rr({ 0x89 }, src, dst); }
+			void mov32(Reg dst, u32 value) {
+				rex(false, 0, 0, dst, false);
+				emit(0xB8 + (dst & 7));
+				emit32(value);
+			}
+			void movzx8(Reg dst, Reg src) { rr({ 0x0F, 0xB6 }, dst, src, false, true); }
+			void movzx8(Reg dst, Mem memory) { rm({ 0x0F, 0xB6 }, dst, memory); }
+			void load64(Reg dst, Mem memory) { rm({ 0x8B }, dst, memory, true); }
+			void load32(Reg dst, Mem memory) { rm({ 0x8B }, dst, memory); }
+			void store32(Mem memory, Reg src) { rm({ 0x89 }, src, memory); }
+			void store16(Mem memory, Reg src) { rm({ 0x89 }, src, memory, false, false, true); }
+			void store16(Mem memory, u16 value) {
+				rm({ 0xC7 }, 0, memory, false, false, true);
+				emit(value & 0xFF);
+				emit(value >> 8);
+			}
+			void store8(Mem memory, Reg src) { rm({ 0x88 }, src, memory, false, true); }
+			void store8(Mem memory, u8 value) {
+				rm({ 0xC6 }, 0, memory);
+				emit(value);
+			}
+			void lea32(Reg dst, Mem memory) { rm({ 0x8D }, dst, memory); }
+
+			void alu32(Alu op, Reg dst, Reg src) { rr({ static_cast<u8>(0x01 | op << 3) }, src, dst); }
+			void alu32(Alu op, Reg dst, u32 value) {
+				if (value < 0x80) {
+					rr({ 0x83 }, op, dst);
+					emit(static_cast<u8>(value));
+				} else {
+					rr({ 0x81 }, op, dst);
+					emit32(value);
+				}
+			}
+			void alu32(Alu op, Reg dst, Mem memory) { rm({ static_cast<u8>(0x03 | op << 3) }, dst, memory); }
+			void alu8(Alu op, Reg dst, Reg src) { rr({ static_cast<u8>(0x00 | op << 3) }, src, dst, false, true); }
+			void alu8(Alu op, Reg dst, u8 value) {
+				rr({ 0x80 }, op, dst, false, true);
+				emit(value);
+			}
+			void alu8(Alu op, Reg dst, Mem memory) { rm({ static_cast<u8>(0x02 | op << 3) }, dst, memory, false, true); }
+			void shift32(Shift op, Reg dst, u8 count) {
+				rr({ 0xC1 }, op, dst);
+				emit(count);
+			}
+			void shift8(Shift op, Reg dst) { rr({ 0xD0 }, op, dst, false, true); } // By one
+			void inc8(Reg dst) { rr({ 0xFE }, 0, dst, false, true); }
+			void dec8(Reg dst) { rr({ 0xFE }, 1, dst, false, true); }
+			void test32(Reg a, Reg b) { rr({ 0x85 }, b, a); }
+			void test32(Reg a, u32 value) {
+				rr({ 0xF7 }, 0, a);
+				emit32(value);
+			}
+			void test64(Reg a, Reg b) { rr({ 0x85 }, b, a, true); }
+			void setcc(Cond cond, Reg dst) { rr({ 0x0F, static_cast<u8>(0x90 | cond) }, 0, dst, false, true); }
+			void bt0(Reg reg) { // CF = bit 0
+				rr({ 0x0F, 0xBA }, 4, reg);
+				emit(0);
+			}
+			void cmc() { emit(0xF5); }
+
+			void push(Reg reg) {
+				if (reg >= R8) emit(0x41);
+				emit(0x50 + (reg & 7));
+			}
+			void pop(Reg reg) {
+				if (reg >= R8) emit(0x41);
+				emit(0x58 + (reg & 7));
+			}
+			void ret() { emit(0xC3); }
+			void jmp(Reg reg) { rr({ 0xFF }, 4, reg); }
+			void jmp(Label label) {
+				emit(0xE9);
+				rel32(label);
+			}
+			void jcc(Cond cond, Label label) {
+				emit(0x0F);
+				emit(0x80 | cond);
+				rel32(label);
+			}
+			void jmp(const u8* target) { // Outside the block -> patched by place()
+				emit(0xE9);
+				_outside.push_back({ static_cast<u32>(_bytes.size()), target });
+				emit32(0);
+			}
+
+			// Copies the code to its final address and patches the jumps
+			void place(u8* destination) const {
+				std::memcpy(destination, _bytes.data(), _bytes.size());
+				for (const auto& [position, label] : _fixups) {
+					patch(destination + position, destination + _labels[label]);
+				}
+				for (const auto& [position, target] : _outside) {
+					patch(destination + position, target);
+				}
+			}
+
+		private:
+			std::vector<u8>								_bytes;
+			std::vector<s64>							_labels;
+			std::vector<std::pair<u32, u32>>			_fixups; // rel32 position, label
+			std::vector<std::pair<u32, const u8*>>		_outside; // rel32 position, target
+
+			void emit(u8 value) { _bytes.push_back(value); }
+			void emit32(u32 value) {
+				for (u32 i{ 0 }; i < 4; ++i) emit(static_cast<u8>(value >> (i * 8)));
+			}
+			void rel32(Label label) {
+				_fixups.push_back({ static_cast<u32>(_bytes.size()), label.id });
+				emit32(0);
+			}
+			static void patch(u8* position, const u8* target) {
+				const s32 relative = static_cast<s32>(target - (position + 4));
+				std::memcpy(position, &relative, sizeof(relative));
+			}
+
+			// REX | byte -> an 8-bit register operand in 4..7, which means SPL..DIL with a REX and AH..BH without
+			void rex(bool wide, u8 reg, u8 index, u8 base, bool byte) {
+				const u8 value = 0x40 | (wide << 3) | (((reg >> 3) & 1) << 2) | (((index >> 3) & 1) << 1) | ((base >> 3) & 1);
+				if (value != 0x40 || byte) emit(value);
+			}
+
+			static bool byte_needs_rex(u8 reg) { return reg >= RSP && reg <= RDI; }
+
+			// opcode reg, rm [register direct] | reg may be an opcode extension
+			void rr(std::initializer_list<u8> opcode, u8 reg, u8 rm, bool wide = false, bool byte = false, bool word = false) {
+				if (word) emit(0x66);
+				rex(wide, reg, 0, rm, byte && (byte_needs_rex(reg) || byte_needs_rex(rm)));
+				for (const u8 value : opcode) emit(value);
+				emit(0xC0 | ((reg & 7) << 3) | (rm & 7));
+			}
+
+			// opcode reg, [base + index * scale + disp]
+			void rm(std::initializer_list<u8> opcode, u8 reg, Mem memory, bool wide = false, bool byte = false, bool word = false) {
+				const bool indexed = memory.index != NONE;
+				if (word) emit(0x66);
+				rex(wide, reg, indexed ? memory.index : 0, memory.base, byte && byte_needs_rex(reg));
+				for (const u8 value : opcode) emit(value);
+
+				const bool disp8 = memory.disp >= -128 && memory.disp < 128;
+				const u8 mod = (memory.disp == 0 && (memory.base & 7) != RBP) ? 0 : disp8 ? 1 : 2; // RBP/R13 as base always need a displacement
+				if (!indexed && (memory.base & 7) != RSP) {
+					emit((mod << 6) | ((reg & 7) << 3) | (memory.base & 7));
+				} else { // SIB | RSP/R12 as base always need one
+					const u8 scale = memory.scale == 8 ? 3 : memory.scale == 4 ? 2 : memory.scale == 2 ? 1 : 0;
+					emit((mod << 6) | ((reg & 7) << 3) | RSP);
+					emit((scale << 6) | ((indexed ? memory.index & 7 : RSP) << 3) | (memory.base & 7));
+				}
+				if (mod == 1) emit(static_cast<u8>(memory.disp));
+				if (mod == 2) emit32(static_cast<u32>(memory.disp));
+			}
+		};
+
+		/// Translator ///
+
+		constexpr u32 code_buffer_size{ 4u << 20 };
+		constexpr u32 max_block_length{ 32 }; // Instructions
+		constexpr u32 max_block_bytes{ 8192 }; // Host code, far above what 32 instructions take
+
+		Mem field(std::size_t offset) { return { CONTEXT, NONE, 1, static_cast<s32>(offset) }; }
+
+		// Status register from the pinned flags and the bits no translated instruction changes [I, D, B, U]
+		void materialize_status(Assembler& code, Reg dst) {
+			code.movzx8(dst, field(offsetof(Dynarec::Context, status_register)));
+			code.alu32(AND_, dst, 0x3C);
+			code.alu32(OR, dst, CARRY);
+			code.mov32(RCX, OVERFLOW);
+			code.shift32(SHL, RCX, 6);
+			code.alu32(OR, dst, RCX);
+			code.test32(NZ, zero_mask);
+			code.setcc(E, RCX);
+			code.movzx8(RCX, RCX);
+			code.shift32(SHL, RCX, 1);
+			code.alu32(OR, dst, RCX);
+			code.test32(NZ, negative_mask);
+			code.setcc(NE, RCX);
+			code.movzx8(RCX, RCX);
+			code.shift32(SHL, RCX, 7);
+			code.alu32(OR, dst, RCX);
+		}
+
+		enum class Access : u8 { None, Read, Write, Modify };
+
+		constexpr Access access(Operation operation, AddressMode mode) {
+			if (mode == AddressMode::IMP || mode == AddressMode::IMM || mode == AddressMode::REL) return Access::None;
+			switch (operation) {
+			case Operation::ADC: case Operation::AND: case Operation::BIT: case Operation::CMP: case Operation::CPX: case Operation::CPY:
+			case Operation::EOR: case Operation::LDA: case Operation::LDX: case Operation::LDY: case Operation::ORA: case Operation::SBC:
+				return Access::Read;
+			case Operation::STA: case Operation::STX: case Operation::STY:
+				return Access::Write;
+			case Operation::ASL: case Operation::LSR: case Operation::ROL: case Operation::ROR: case Operation::INC: case Operation::DEC:
+				return Access::Modify;
+			default: // NOP, JMP, JSR -> the address is not read
+				return Access::None;
+			}
+		}
+
+		constexpr bool is_branch(Operation operation) {
+			switch (operation) {
+			case Operation::BCC: case Operation::BCS: case Operation::BEQ: case Operation::BMI:
+			case Operation::BNE: case Operation::BPL: case Operation::BVC: case Operation::BVS:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		constexpr bool ends_block(Operation operation) {
+			return is_branch(operation) || operation == Operation::JMP || operation == Operation::JSR || operation == Operation::RTS;
+		}
+
+		struct Instruction {
+			u16			address;
+			u16			operand;
+			u8			opcode;
+			u8			length;
+			OpcodeInfo	info;
+		};
+
+		// Left to the interpreter | The interrupt disable flag and its delay, interrupts, illegal opcodes and fixed addresses that are never plain memory
+		bool translatable(const Instruction& instruction) {
+			switch (instruction.info.operation) {
+			case Operation::BRK: case Operation::CLD: case Operation::CLI: case Operation::PLP:
+			case Operation::RTI: case Operation::SED: case Operation::SEI: case Operation::XXX:
+				return false; // CLD/SED only because D is kept out of the pinned flags, games set it once
+			default:
+				break;
+			}
+
+			const AddressMode mode = instruction.info.mode;
+			const bool absolute = mode == AddressMode::ABS || mode == AddressMode::ABX || mode == AddressMode::ABY;
+			const Access kind = access(instruction.info.operation, mode);
+			if ((absolute && kind != Access::None) || mode == AddressMode::IND) {
+				const u16 address = instruction.operand;
+				if (address >= 0x2000 && address < 0x8000) return false; // I/O, expansion, PRG-RAM -> handler pages
+				if (address >= 0x8000 && (kind == Access::Write || kind == Access::Modify)) return false; // Mapper registers
+			}
+			return true;
+		}
+
+		class Translator {
+		public:
+			Translator(const std::vector<Instruction>& instructions, const u8* leave) : _instructions(instructions), _leave(leave) {}
+
+			// Emits the block | Returns its worst-case cycles for one pass
+			u16 translate() {
+				_start = _code.label();
+				_code.bind(_start);
+
+				for (const Instruction& instruction : _instructions) _max_cycles += instruction.info.cycles + oops_cycles(instruction);
+
+				u32 cycles{ 0 };
+				for (u32 k{ 0 }; k < _instructions.size(); ++k) {
+					_cycles_before = cycles;
+					_current = k;
+					emit(_instructions[k]);
+					cycles += _instructions[k].info.cycles;
+				}
+
+				const Instruction& last = _instructions.back();
+				if (!ends_block(last.info.operation)) { // Ran into something the interpreter has to do
+					exit_to(static_cast<u16>(last.address + last.length), cycles, static_cast<u32>(_instructions.size()));
+				}
+
+				for (u32 k{ 0 }; k < _exits.size(); ++k) { // Before instruction k, nothing of it done
+					if (!_exits[k].second) continue;
+					_code.bind(_exits[k].first);
+					exit_to(_instructions[k].address, _exit_cycles[k], k);
+				}
+				return static_cast<u16>(_max_cycles);
+			}
+
+			[[nodiscard]] const Assembler& code() const { return _code; }
+
+		private:
+			const std::vector<Instruction>&		_instructions;
+			const u8*							_leave;
+			Assembler							_code;
+			Label								_start{};
+			u32									_max_cycles{ 0 };
+			u32									_cycles_before{ 0 }; // Static cycles of the instructions before the current one
+			u32									_current{ 0 };
+			std::vector<std::pair<Label, bool>>	_exits; // Per instruction, used or not
+			std::vector<u32>					_exit_cycles;
+
+			// Worst case on top of the base cycles
+			static u32 oops_cycles(const Instruction& instruction) {
+				const OpcodeInfo& info = instruction.info;
+				if (is_branch(info.operation)) {
+					const u16 next = instruction.address + instruction.length;
+					return ((branch_target(instruction) >> 8) != (next >> 8)) ? 2 : 1;
+				}
+				const bool indexed = info.mode == AddressMode::ABX || info.mode == AddressMode::ABY || info.mode == AddressMode::IZY;
+				return (indexed && has_page_cross_penalty(info.operation)) ? 1 : 0;
+			}
+
+			static u16 branch_target(const Instruction& instruction) {
+				const u16 relative = (instruction.operand & 0x80) ? (instruction.operand | 0xFF00) : instruction.operand;
+				return static_cast<u16>(instruction.address + instruction.length + relative);
+			}
+
+			// Leaves before the current instruction
+			Label exit() {
+				if (_exits.size() <= _current) {
+					_exits.resize(_current + 1, { Label{}, false });
+					_exit_cycles.resize(_current + 1, 0);
+				}
+				if (!_exits[_current].second) _exits[_current] = { _code.label(), true };
+				_exit_cycles[_current] = _cycles_before;
+				return _exits[_current].first;
+			}
+
+			void exit_to(u16 address, u32 cycles, u32 count) {
+				_code.store16(field(offsetof(Dynarec::Context, program_counter)), address);
+				finish_pass(cycles, count);
+				_code.jmp(_leave);
+			}
+
+			void finish_pass(u32 cycles, u32 count) {
+				if (cycles) _code.alu32(ADD, CYCLES, cycles);
+				if (count) _code.alu32(ADD, COUNT, count);
+			}
+
+			// Control goes to a fixed address after the instructions so far + this one | Back to the start -> another pass if the budget allows
+			void go_to(u16 target, u32 cycles) {
+				const u32 count = _current + 1;
+				if (target != _instructions.front().address) {
+					exit_to(target, cycles, count);
+					return;
+				}
+				finish_pass(cycles, count);
+				_code.lea32(RAX, { CYCLES, NONE, 1, static_cast<s32>(_max_cycles) });
+				_code.alu32(CMP_, RAX, field(offsetof(Dynarec::Context, budget)));
+				_code.jcc(BE, _start);
+				_code.store16(field(offsetof(Dynarec::Context, program_counter)), target);
+				_code.jmp(_leave);
+			}
+
+			void check(Label exit) {
+				_code.test64(RAX, RAX);
+				_code.jcc(E, exit);
+			}
+
+			// Host address of the operand | Leaves before the instruction when the page is not plain memory, or for writes when it is watched
+			Mem memory(const Instruction& instruction, bool write) {
+				const Reg table = write ? WRITE : READ;
+				const u16 operand = instruction.operand;
+				const AddressMode mode = instruction.info.mode;
+				const bool penalty = has_page_cross_penalty(instruction.info.operation);
+				bool oops{ false };
+
+				switch (mode) {
+				case AddressMode::ZP0:
+					_code.load64(RAX, { table });
+					if (write) check(exit());
+					return { RAX, NONE, 1, operand & 0xFF };
+				case AddressMode::ZPX: case AddressMode::ZPY:
+					_code.lea32(RCX, { mode == AddressMode::ZPX ? X : Y, NONE, 1, operand & 0xFF });
+					_code.movzx8(RCX, RCX);
+					_code.load64(RAX, { table });
+					if (write) check(exit());
+					return { RAX, RCX };
+				case AddressMode::ABS:
+				case AddressMode::IND: { // The pointer of JMP ($xxxx) | Both its bytes are on one page, the glitch sees to that
+					const u8 page = operand >> 8;
+					_code.load64(RAX, { table, NONE, 1, page * 8 });
+					if (write || page >= 0x20) check(exit()); // RAM always reads as plain memory
+					return { RAX, NONE, 1, operand & 0xFF };
+				}
+				case AddressMode::ABX: case AddressMode::ABY: {
+					const Reg index = mode == AddressMode::ABX ? X : Y;
+					_code.lea32(RCX, { index, NONE, 1, operand });
+					_code.alu32(AND_, RCX, 0xFFFF);
+					if (penalty && (operand & 0xFF)) { // Crosses when index > $FF - low byte
+						_code.alu32(CMP_, index, 0xFFu - (operand & 0xFF));
+						_code.setcc(ABOVE, RDX);
+						_code.movzx8(RDX, RDX);
+						oops = true;
+					}
+					break;
+				}
+				case AddressMode::IZX:
+					_code.load64(RDX, { READ });
+					_code.lea32(RAX, { X, NONE, 1, operand & 0xFF });
+					_code.movzx8(RAX, RAX);
+					_code.movzx8(RCX, { RDX, RAX });
+					_code.inc8(RAX); // Pointer wraps around within the Zero Page
+					_code.movzx8(RAX, { RDX, RAX });
+					_code.shift32(SHL, RAX, 8);
+					_code.alu32(OR, RCX, RAX);
+					break;
+				case AddressMode::IZY:
+					_code.load64(RDX, { READ });
+					_code.movzx8(RCX, { RDX, NONE, 1, operand & 0xFF });
+					_code.movzx8(RAX, { RDX, NONE, 1, (operand + 1) & 0xFF });
+					_code.shift32(SHL, RAX, 8);
+					_code.alu32(OR, RCX, RAX);
+					if (penalty) { // Carry out of the low byte
+						_code.mov32(RAX, RCX);
+						_code.alu8(ADD, RAX, Y);
+						_code.setcc(B, RDX);
+						_code.movzx8(RDX, RDX);
+						oops = true;
+					}
+					_code.alu32(ADD, RCX, Y);
+					_code.alu32(AND_, RCX, 0xFFFF);
+					break;
+				default:
+					break;
+				}
+
+				// Page only known at run time
+				_code.mov32(RAX, RCX);
+				_code.shift32(SHR, RAX, 8);
+				_code.load64(RAX, { table, RAX, 8 });
+				check(exit());
+				_code.movzx8(RCX, RCX);
+				if (oops) _code.alu32(ADD, CYCLES, RDX);
+				return { RAX, RCX };
+			}
+
+			// Operand of a read | Immediate or the memory behind the address
+			struct Value {
+				bool	immediate;
+				u8		value;
+				Mem		memory;
+			};
+
+			Value read(const Instruction& instruction) {
+				if (instruction.info.mode == AddressMode::IMM) return { true, static_cast<u8>(instruction.operand), {} };
+				return { false, 0, memory(instruction, false) };
+			}
+
+			void load(Reg dst, const Value& value) {
+				if (value.immediate) _code.mov32(dst, value.value);
+				else _code.movzx8(dst, value.memory);
+			}
+
+			void alu8(Alu op, Reg dst, const Value& value) {
+				if (value.immediate) _code.alu8(op, dst, value.value);
+				else _code.alu8(op, dst, value.memory);
+			}
+
+			// ADC/SBC | NZ = the 9-bit sum -> Z only for a sum of zero without carry out, like the interpreter
+			void sum_flags() {
+				_code.mov32(NZ, CARRY);
+				_code.shift32(SHL, NZ, 8);
+				_code.alu32(OR, NZ, A);
+			}
+
+			// CMP/CPX/CPY | Z from the difference, N from the borrow [interpreter: N = temp & 0xFF00], C = no borrow
+			void compare(Reg reg, const Instruction& instruction) {
+				load(RAX, read(instruction));
+				_code.mov32(RCX, reg);
+				_code.alu32(SUB, RCX, RAX);
+				_code.setcc(AE, CARRY);
+				_code.mov32(NZ, RCX);
+				_code.alu32(AND_, NZ, 0x8000); // Negative difference -> bit 15 set
+				_code.test32(RCX, RCX);
+				_code.setcc(NE, RCX);
+				_code.movzx8(RCX, RCX);
+				_code.alu32(OR, NZ, RCX);
+			}
+
+			// Read-modify-write on A or memory | op works on an 8-bit register, the carry comes out of the host's CF
+			template<typename Modify>
+			void modify(const Instruction& instruction, Modify&& op) {
+				if (instruction.info.mode == AddressMode::IMP) {
+					op(A);
+					_code.setcc(B, CARRY);
+					_code.mov32(NZ, A);
+					return;
+				}
+				const Mem target = memory(instruction, true); // Plain write page -> RAM, read through the same pointer
+				_code.movzx8(RDX, target);
+				op(RDX);
+				_code.setcc(B, CARRY);
+				_code.store8(target, RDX);
+				_code.mov32(NZ, RDX);
+			}
+
+			void push(Reg value) { // Stack page written through the page table -> leaves when it is watched
+				_code.load64(RAX, { WRITE, NONE, 1, 0x01 * 8 });
+				check(exit());
+				_code.store8({ RAX, SP }, value);
+				_code.dec8(SP);
+			}
+
+			void pull(Reg dst) {
+				_code.inc8(SP);
+				_code.load64(RAX, { READ, NONE, 1, 0x01 * 8 });
+				_code.movzx8(dst, { RAX, SP });
+			}
+
+			void branch(const Instruction& instruction, Reg flag, u32 mask, bool taken_if_set) {
+				const Label not_taken = _code.label();
+				if (mask) _code.test32(flag, mask);
+				else _code.test32(flag, flag);
+				_code.jcc(taken_if_set ? E : NE, not_taken);
+				const u16 next = instruction.address + instruction.length;
+				const u16 target = branch_target(instruction);
+				go_to(target, _cycles_before + instruction.info.cycles + (((target >> 8) != (next >> 8)) ? 2 : 1));
+				_code.bind(not_taken);
+				exit_to(next, _cycles_before + instruction.info.cycles, _current + 1);
+			}
+
+			void emit(const Instruction& instruction) {
+				using enum Operation;
+				const u32 cycles = _cycles_before + instruction.info.cycles; // Static cycles up to the end of this one
+
+				switch (instruction.info.operation) {
+				case LDA: load(A, read(instruction)); _code.mov32(NZ, A); break;
+				case LDX: load(X, read(instruction)); _code.mov32(NZ, X); break;
+				case LDY: load(Y, read(instruction)); _code.mov32(NZ, Y); break;
+				case STA: _code.store8(memory(instruction, true), A); break;
+				case STX: _code.store8(memory(instruction, true), X); break;
+				case STY: _code.store8(memory(instruction, true), Y); break;
+
+				case AND: alu8(AND_, A, read(instruction)); _code.mov32(NZ, A); break;
+				case EOR: alu8(XOR, A, read(instruction)); _code.mov32(NZ, A); break;
+				case ORA: // Interpreter: Z = bit 7 of the operand, N stays
+					load(RAX, read(instruction));
+					_code.alu32(OR, A, RAX);
+					_code.test32(NZ, negative_mask);
+					_code.setcc(NE, RCX);
+					_code.movzx8(RCX, RCX);
+					_code.shift32(SHL, RCX, 15);
+					_code.shift32(SHR, RAX, 7);
+					_code.alu32(XOR, RAX, 1);
+					_code.alu32(OR, RCX, RAX);
+					_code.mov32(NZ, RCX);
+					break;
+				case ADC: {
+					const Value value = read(instruction);
+					_code.bt0(CARRY);
+					alu8(ADC_, A, value);
+					_code.setcc(B, CARRY);
+					_code.setcc(O, OVERFLOW);
+					sum_flags();
+					break;
+				}
+				case SBC: { // A + ~M + C = A - M - borrow
+					const Value value = read(instruction);
+					_code.bt0(CARRY);
+					_code.cmc();
+					alu8(SBB, A, value);
+					_code.setcc(AE, CARRY);
+					_code.setcc(O, OVERFLOW);
+					sum_flags();
+					break;
+				}
+				case CMP: compare(A, instruction); break;
+				case CPX: compare(X, instruction); break;
+				case CPY: compare(Y, instruction); break;
+				case BIT: // Interpreter: N, V and Z all from A & M
+					load(RAX, read(instruction));
+					_code.alu32(AND_, RAX, A);
+					_code.mov32(NZ, RAX);
+					_code.shift32(SHR, RAX, 6);
+					_code.alu32(AND_, RAX, 1);
+					_code.mov32(OVERFLOW, RAX);
+					break;
+
+				case ASL: modify(instruction, [this](Reg reg) { _code.alu8(ADD, reg, reg); }); break;
+				case LSR: modify(instruction, [this](Reg reg) { _code.shift8(SHR, reg); }); break;
+				case ROL: modify(instruction, [this](Reg reg) { _code.bt0(CARRY); _code.shift8(RCL, reg); }); break;
+				case ROR: modify(instruction, [this](Reg reg) { _code.bt0(CARRY); _code.shift8(RCR, reg); }); break;
+				case INC: case DEC: {
+					const Mem target = memory(instruction, true);
+					_code.movzx8(RDX, target);
+					if (instruction.info.operation == INC) _code.inc8(RDX);
+					else _code.dec8(RDX);
+					_code.store8(target, RDX);
+					_code.mov32(NZ, RDX);
+					break;
+				}
+				case INX: _code.inc8(X); _code.mov32(NZ, X); break;
+				case INY: _code.inc8(Y); _code.mov32(NZ, Y); break;
+				case DEX: _code.dec8(X); _code.mov32(NZ, X); break;
+				case DEY: _code.dec8(Y); _code.mov32(NZ, Y); break;
+
+				case TAX: _code.mov32(X, A); _code.mov32(NZ, X); break;
+				case TAY: _code.mov32(Y, A); _code.mov32(NZ, Y); break;
+				case TSX: _code.mov32(X, SP); _code.mov32(NZ, X); break;
+				case TXA: _code.mov32(A, X); _code.mov32(NZ, A); break;
+				case TYA: _code.mov32(A, Y); _code.mov32(NZ, A); break;
+				case TXS: _code.mov32(SP, X); break;
+
+				case CLC: _code.alu32(XOR, CARRY, CARRY); break;
+				case SEC: _code.mov32(CARRY, 1); break;
+				case CLV: _code.alu32(XOR, OVERFLOW, OVERFLOW); break;
+
+				case PHA: push(A); break;
+				case PHP:
+					materialize_status(_code, RDX);
+					_code.alu32(OR, RDX, 0x30);
+					push(RDX);
+					break;
+				case PLA: pull(A); _code.mov32(NZ, A); break;
+
+				case NOP: // Illegal NOPs with an address only pay the OOPS cycle, nothing is read
+					if (instruction.info.mode == AddressMode::ABX && has_page_cross_penalty(NOP) && (instruction.operand & 0xFF)) {
+						_code.alu32(CMP_, X, 0xFFu - (instruction.operand & 0xFF));
+						_code.setcc(ABOVE, RDX);
+						_code.movzx8(RDX, RDX);
+						_code.alu32(ADD, CYCLES, RDX);
+					}
+					break;
+
+				case BCC: branch(instruction, CARRY, 0, false); break;
+				case BCS: branch(instruction, CARRY, 0, true); break;
+				case BNE: branch(instruction, NZ, zero_mask, true); break;
+				case BEQ: branch(instruction, NZ, zero_mask, false); break;
+				case BPL: branch(instruction, NZ, negative_mask, false); break;
+				case BMI: branch(instruction, NZ, negative_mask, true); break;
+				case BVC: branch(instruction, OVERFLOW, 0, false); break;
+				case BVS: branch(instruction, OVERFLOW, 0, true); break;
+
+				case JMP:
+					if (instruction.info.mode == AddressMode::ABS) {
+						go_to(instruction.operand, cycles);
+					} else { // ($xxxx) with the page boundary glitch -> the high byte comes from the start of the same page
+						const Mem pointer = memory(instruction, false);
+						const u8 high = ((instruction.operand & 0xFF) == 0xFF) ? 0x00 : static_cast<u8>((instruction.operand & 0xFF) + 1);
+						_code.movzx8(RCX, pointer);
+						_code.movzx8(RDX, { RAX, NONE, 1, high });
+						_code.shift32(SHL, RDX, 8);
+						_code.alu32(OR, RCX, RDX);
+						_code.store16(field(offsetof(Dynarec::Context, program_counter)), RCX);
+						finish_pass(cycles, _current + 1);
+						_code.jmp(_leave);
+					}
+					break;
+				case JSR: { // Pushes the address of the next instruction, RTS pulls it back as it is [switch core]
+					const u16 next = instruction.address + instruction.length;
+					_code.load64(RAX, { WRITE, NONE, 1, 0x01 * 8 });
+					check(exit());
+					_code.store8({ RAX, SP }, static_cast<u8>(next >> 8));
+					_code.dec8(SP);
+					_code.store8({ RAX, SP }, static_cast<u8>(next & 0xFF));
+					_code.dec8(SP);
+					go_to(instruction.operand, cycles);
+					break;
+				}
+				case RTS:
+					pull(RCX);
+					pull(RDX);
+					_code.shift32(SHL, RDX, 8);
+					_code.alu32(OR, RCX, RDX);
+					_code.store16(field(offsetof(Dynarec::Context, program_counter)), RCX);
+					finish_pass(cycles, _current + 1);
+					_code.jmp(_leave);
+					break;
+
+				default: // Filtered out by translatable()
+					break;
+				}
+			}
+		};
+
+	} // Anonymous Namespace
+
+	Dynarec::Dynarec(Bus* bus) : _bus(bus) {
+		for (Entry& entry : _untranslatable.entries) entry.heat = never;
+	}
+
+	namespace {
+
+		void release(u8* memory, u64 size) {
+#if defined(_WIN32)
+			VirtualFree(memory, 0, MEM_RELEASE);
+#else
+			munmap(memory, size);
+#endif // _WIN32
+		}
+
+		bool protect(u8* memory, u64 size, bool executable) {
+#if defined(_WIN32)
+			DWORD previous{ 0 };
+			if (!VirtualProtect(memory, size, executable ? PAGE_EXECUTE_READ : PAGE_READWRITE, &previous)) return false;
+			if (executable) FlushInstructionCache(GetCurrentProcess(), memory, size);
+			return true;
+#else
+			return mprotect(memory, size, executable ? PROT_READ | PROT_EXEC : PROT_READ | PROT_WRITE) == 0;
+#endif // _WIN32
+		}
+
+	} // Anonymous Namespace
+
+	Dynarec::~Dynarec() {
+		if (_code) release(_code, _code_size);
+	}
+
+	// Executable buffer + the enter/leave stubs every block shares
+	bool Dynarec::allocate() {
+#if defined(_WIN32)
+		void* memory = VirtualAlloc(nullptr, code_buffer_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		if (!memory) return false;
+#else
+		void* memory = mmap(nullptr, code_buffer_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED) return false;
+#endif // _WIN32
+
+		constexpr Reg saved[] = { RBX, RBP, RSI, RDI, R12, R13, R14, R15 }; // Callee-saved in either ABI [+ RSI/RDI on Windows]
+#if defined(_WIN32)
+		constexpr Reg context_argument = RCX, code_argument = RDX;
+#else
+		constexpr Reg context_argument = RDI, code_argument = RSI;
+#endif // _WIN32
+
+		// void enter(Context*, const u8* code)
+		Assembler enter;
+		for (const Reg reg : saved) enter.push(reg);
+		enter.mov64(CONTEXT, context_argument);
+		enter.mov64(RAX, code_argument);
+		enter.load64(READ, field(offsetof(Context, read_memory)));
+		enter.load64(WRITE, field(offsetof(Context, write_memory)));
+		enter.movzx8(A, field(offsetof(Context, accumulator)));
+		enter.movzx8(X, field(offsetof(Context, x_register)));
+		enter.movzx8(Y, field(offsetof(Context, y_register)));
+		enter.movzx8(SP, field(offsetof(Context, stack_pointer)));
+		enter.movzx8(RDX, field(offsetof(Context, status_register)));
+		enter.mov32(CARRY, RDX);
+		enter.alu32(AND_, CARRY, 1);
+		enter.mov32(OVERFLOW, RDX);
+		enter.shift32(SHR, OVERFLOW, 6);
+		enter.alu32(AND_, OVERFLOW, 1);
+		enter.mov32(NZ, RDX); // Z clear -> 1
+		enter.shift32(SHR, NZ, 1);
+		enter.alu32(AND_, NZ, 1);
+		enter.alu32(XOR, NZ, 1);
+		enter.alu32(AND_, RDX, 0x80); // N -> bit 15
+		enter.shift32(SHL, RDX, 8);
+		enter.alu32(OR, NZ, RDX);
+		enter.alu32(XOR, CYCLES, CYCLES);
+		enter.alu32(XOR, COUNT, COUNT);
+		enter.jmp(RAX);
+
+		Assembler leave;
+		leave.store8(field(offsetof(Context, accumulator)), A);
+		leave.store8(field(offsetof(Context, x_register)), X);
+		leave.store8(field(offsetof(Context, y_register)), Y);
+		leave.store8(field(offsetof(Context, stack_pointer)), SP);
+		materialize_status(leave, RDX);
+		leave.store8(field(offsetof(Context, status_register)), RDX);
+		leave.store32(field(offsetof(Context, cycles)), CYCLES);
+		leave.store32(field(offsetof(Context, instructions)), COUNT);
+		for (u32 i{ std::size(saved) }; i-- > 0;) leave.pop(saved[i]);
+		leave.ret();
+
+		u8* code = static_cast<u8*>(memory);
+		enter.place(code);
+		leave.place(code + enter.size());
+		if (!protect(code, code_buffer_size, true)) { // No executable memory here -> interpreter only
+			release(code, code_buffer_size);
+			return false;
+		}
+
+		_code = code;
+		_code_size = code_buffer_size;
+		_stubs_size = _code_used = enter.size() + leave.size();
+		_enter = reinterpret_cast<EnterFunction>(_code);
+		_leave = _code + enter.size();
+		return true;
+	}
+
+	// Translations for the memory now mapped at the CPU page | RAM and handler pages get none
+	Dynarec::Page* Dynarec::map_page(u8 page) {
+		const u8* memory = page >= 0x20 ? _bus->memory_page(page) : nullptr; // Plain memory above RAM -> PRG-ROM
+		Page* translated{ &_untranslatable };
+		if (memory) {
+			std::unique_ptr<Page>& slot = _translated[{ memory, page }];
+			if (!slot) {
+				slot = std::make_unique<Page>();
+				slot->memory = memory;
+			}
+			translated = slot.get();
+		}
+		_pages[page] = translated;
+		return translated;
+	}
+
+	const Dynarec::Block* Dynarec::translate(Page& page, u16 address) {
+		page.entries[address & 0xFF].heat = never; // Until it succeeds -> a failed translation is not tried again
+		if (!_code && !allocate()) return nullptr;
+
+		std::vector<Instruction> instructions;
+		for (u32 offset{ address & 0x00FFu }; offset < 256 && instructions.size() < max_block_length;) {
+			const u8 opcode = page.memory[offset];
+			const u8 length = instruction_length(opcode);
+			if (offset + length > 256) break; // The operand is on the next page, which can be mapped on its own
+
+			Instruction instruction{};
+			instruction.address = static_cast<u16>((address & 0xFF00) | offset);
+			instruction.operand = (length > 1 ? page.memory[offset + 1] : 0x00) | (length > 2 ? page.memory[offset + 2] << 8 : 0x00);
+			instruction.opcode = opcode;
+			instruction.length = length;
+			instruction.info = opcode_table[opcode];
+			if (!translatable(instruction)) break;
+
+			instructions.push_back(instruction);
+			if (ends_block(instruction.info.operation)) break;
+			offset += length;
+		}
+		if (instructions.empty()) return nullptr;
+
+		Translator translator(instructions, _leave);
+		const u16 max_cycles = translator.translate();
+		const Assembler& code = translator.code();
+		if (code.size() > max_block_bytes) return nullptr;
+		if (_code_used + code.size() > _code_size) { // Full -> start over, the page just translated goes too
+			flush();
+			return nullptr;
+		}
+
+		u8* destination = _code + _code_used;
+		if (!protect(_code, _code_size, false)) return nullptr;
+		code.place(destination);
+		if (!protect(_code, _code_size, true)) return nullptr;
+		_code_used += code.size();
+
+		Block& block = _blocks.emplace_back();
+		block.code = destination;
+		block.address = address;
+		block.max_cycles = max_cycles;
+		block.length = static_cast<u8>(instructions.size());
+		page.entries[address & 0xFF].block = &block;
+		++_counters.blocks;
+		return &block;
+	}
+
+	void Dynarec::discard(const Block& block) {
+		for (auto& [key, page] : _translated) {
+			Entry& entry = page->entries[block.address & 0xFF];
+			if (entry.block == &block) entry = { nullptr, never };
+		}
+	}
+
+	void Dynarec::remapped(u16 first, u16 last) {
+		if (first == 0x00 && last == 0xFF) {
+			flush();
+			return;
+		}
+		for (u32 page{ first }; page <= last; ++page) _pages[page] = nullptr;
+	}
+
+	void Dynarec::flush() {
+		_pages.fill(nullptr);
+		_translated.clear();
+		_blocks.clear();
+		_code_used = _stubs_size;
+		_counters.blocks = 0;
+		++_counters.flushes;
+	}
+}
+
+#endif // CPU_DYNAREC
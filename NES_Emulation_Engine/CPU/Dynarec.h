@@ -0,0 +1,128 @@
+#pragma once
+
+#include <deque>
+#include <map>
+
+#include "../Common/CommonHeaders.h"
+#include "OpcodeTable.h"
+
+namespace NES::CPU {
+	class Bus;
+
+	// Dynamic Recompiler [CPU_DYNAREC] | Hot basic blocks of PRG-ROM are translated to x86-64 and run next to the R6502 interpreter.
+	// A block is straight-line code up to the first branch, jump, call or return, inside one 256-byte page. While it runs the 6502 registers
+	// live in host registers and the flags are lazy: C and V are kept as 0/1, N and Z are only materialized from the last result at the exit.
+	// Exactness rests on three rules:
+	//  - Memory is touched only through the Bus page table. An access that finds a handler page [I/O $2000-$401F, mapper registers, PRG-RAM]
+	//    or a watched RAM page [instruction cache] leaves the block before the instruction, which the interpreter then runs itself.
+	//  - The interpreter only enters a block when none of its interrupt polls could fire or catch a device up, and when the whole block
+	//    [every OOPS cycle and taken branch] fits in the cycle budget. A block branching back to its start rechecks the budget per pass.
+	//  - Instructions that touch the interrupt disable flag, BRK/RTI and illegal opcodes end the block, as does any fixed address that
+	//    is never plain memory -> PPU/APU sync and interrupt timing stay exactly the interpreter's.
+	// RAM code [self-modifying or copied there] is never translated, it runs on the interpreter and its instruction cache.
+	class Dynarec {
+	public:
+		enum class Mode : u8 {
+			Off,
+			On,
+			Verify, // Every block also runs on the interpreter, from the same state, and the results are compared
+		};
+
+		// Guest state in and out of a block | Standard layout, the emitted code reaches the fields by offset
+		struct Context {
+			const u8* const*	read_memory{ nullptr }; // Bus page tables
+			u8* const*			write_memory{ nullptr };
+			u32					budget{ 0 }; // Cycles the block may start instructions within
+			u32					cycles{ 0 }; // Out -> cycles taken
+			u32					instructions{ 0 }; // Out -> instructions run, 0 if the first one had to leave
+			u16					program_counter{ 0 };
+			u8					accumulator{ 0 };
+			u8					x_register{ 0 };
+			u8					y_register{ 0 };
+			u8					stack_pointer{ 0 };
+			u8					status_register{ 0 };
+		};
+
+		struct Block {
+			const u8*	code{ nullptr }; // Host code
+			u16			address{ 0 }; // CPU address of the first instruction
+			u16			max_cycles{ 0 }; // One pass with every OOPS cycle and taken branch
+			u8			length{ 0 }; // Instructions in one pass
+		};
+
+		struct Counters {
+			u64		blocks{ 0 }; // Translated since the last flush
+			u64		flushes{ 0 }; // Code buffer full or page table rebuilt
+			u64		native_instructions{ 0 };
+			u64		interpreted_instructions{ 0 };
+			u64		verified{ 0 }; // Block runs compared against the interpreter
+			u64		mismatches{ 0 };
+			u16		first_mismatch{ 0 }; // Address of the first block that disagreed
+		};
+
+		explicit Dynarec(Bus* bus);
+		~Dynarec();
+		Dynarec(const Dynarec&) = delete;
+		Dynarec& operator=(const Dynarec&) = delete;
+
+		// Translated block at the address | nullptr while it is cold, or if it cannot be translated
+		const Block* find(u16 address) {
+			Page* page = _pages[address >> 8];
+			if (!page) [[unlikely]] page = map_page(static_cast<u8>(address >> 8));
+			Entry& entry = page->entries[address & 0xFF];
+			if (entry.block) [[likely]] return entry.block;
+			if (entry.heat == never) return nullptr;
+			if (++entry.heat < hot) return nullptr;
+			return translate(*page, address);
+		}
+
+		void run(const Block& block, Context& context) const { _enter(&context, block.code); }
+
+		// The block disagreed with the interpreter -> it is dropped and its address is never translated again
+		void discard(const Block& block);
+
+		// Pages [first, last] may hold other memory now [Bus::set_code_listener] | All 256 -> maybe another cartridge, everything goes
+		void remapped(u16 first, u16 last);
+
+		[[nodiscard]] Counters& counters() { return _counters; }
+		[[nodiscard]] const Counters& counters() const { return _counters; }
+
+	private:
+		static constexpr u8 hot{ 8 }; // Entries into an address before it is translated
+		static constexpr u8 never{ 0xFF };
+
+		struct Entry {
+			const Block*	block{ nullptr };
+			u8				heat{ 0 };
+		};
+
+		// Translations of one host page of PRG-ROM, as seen at one CPU page | The code has the CPU addresses in it [returns, branches]
+		struct Page {
+			const u8*					memory{ nullptr };
+			std::array<Entry, 256>		entries{};
+		};
+
+		using EnterFunction = void(*)(Context*, const u8*);
+
+		Page* map_page(u8 page);
+		const Block* translate(Page& page, u16 address);
+		bool allocate();
+		void flush();
+
+		Bus*											_bus{ nullptr };
+		std::array<Page*, 256>							_pages{}; // CPU page -> translations of the memory mapped there
+		std::map<std::pair<const u8*, u8>, std::unique_ptr<Page>>	_translated; // By host page and CPU page
+		Page											_untranslatable; // RAM and handler pages, every entry never
+		std::deque<Block>								_blocks;
+
+		// Executable buffer | Enter/leave stubs first, then the blocks. Writable only while a block is emitted [W^X].
+		u8*												_code{ nullptr };
+		u64												_code_size{ 0 };
+		u64												_code_used{ 0 };
+		u64												_stubs_size{ 0 };
+		EnterFunction									_enter{ nullptr };
+		const u8*										_leave{ nullptr };
+
+		Counters										_counters;
+	};
+}
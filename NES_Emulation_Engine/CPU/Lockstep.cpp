@@ -0,0 +1,468 @@
+#include "Lockstep.h"
+
+// Lockstep Kernels
+// One kernel per opcode, instantiated from opcode_table [OpcodeTable.h] like the switch core, looping over the lanes of its group.
+// Registers, flags, cycles and the scratch fields follow R6502::operate [R6502_SwitchCore.cpp], quirks included [ORA, BIT, compares].
+// Memory goes through the lane's page table: a handler page ends the kernel for that lane before anything was changed.
+
+namespace NES::CPU {
+	namespace {
+
+		// Change the interrupt disable flag or go through the interrupt vector -> the interrupt horizon would no longer hold
+		constexpr bool has_kernel(Operation operation) {
+			switch (operation) {
+			case Operation::BRK: case Operation::RTI: case Operation::CLI: case Operation::SEI: case Operation::PLP:
+				return false;
+			default:
+				return true;
+			}
+		}
+
+		constexpr bool reads_operand(Operation operation) {
+			switch (operation) {
+			case Operation::ADC: case Operation::AND: case Operation::BIT: case Operation::CMP: case Operation::CPX: case Operation::CPY:
+			case Operation::EOR: case Operation::LDA: case Operation::LDX: case Operation::LDY: case Operation::ORA: case Operation::SBC:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		inline void set_flag(u8& status, u8 flag, bool value) {
+			if (value) status |= flag;
+			else status &= ~flag;
+		}
+
+		inline void load_flags(u8& status, u8 value) {
+			set_flag(status, R6502::Z, value == 0);
+			set_flag(status, R6502::N, value >> 7);
+		}
+
+	} // Anonymous Namespace
+
+	template<u8 Opcode>
+	inline bool Lockstep::run_lane(u32 lane) {
+		using enum Operation;
+		constexpr OpcodeInfo info = opcode_table[Opcode];
+		constexpr Operation op = info.operation;
+		constexpr AddressMode mode = info.mode;
+
+		const u8* const* reads = _read_pages[lane];
+		u8* const* writes = _write_pages[lane];
+		auto read = [reads](u16 address, u8& value) {
+			const u8* page = reads[address >> 8];
+			if (!page) return false;
+			value = page[address & 0x00FF];
+			return true;
+		};
+
+		u16 pc = _pc[lane] + 1; // Past the opcode
+		u8 a = _a[lane], x = _x[lane], y = _y[lane], sp = _sp[lane], p = _p[lane], data = _data[lane];
+		u16 address = _address_abs[lane], relative = _address_rel[lane];
+		bool page_crossed{ false };
+
+		// Addressing [R6502::fetch_address]
+		if constexpr (mode == AddressMode::IMM) {
+			address = pc++;
+		} else if constexpr (mode != AddressMode::IMP) {
+			u8 low{ 0 }, high{ 0 };
+			if (!read(pc++, low)) return false;
+			u16 operand = low;
+			if constexpr (mode == AddressMode::ABS || mode == AddressMode::ABX || mode == AddressMode::ABY || mode == AddressMode::IND) {
+				if (!read(pc++, high)) return false;
+				operand |= high << 8;
+			}
+
+			if constexpr (mode == AddressMode::ZP0) {
+				address = operand & 0x00FF;
+			} else if constexpr (mode == AddressMode::ZPX) {
+				address = (operand + x) & 0x00FF;
+			} else if constexpr (mode == AddressMode::ZPY) {
+				address = (operand + y) & 0x00FF;
+			} else if constexpr (mode == AddressMode::REL) {
+				relative = operand;
+				if (relative & 0x80) relative |= 0xFF00;
+			} else if constexpr (mode == AddressMode::ABS) {
+				address = operand;
+			} else if constexpr (mode == AddressMode::ABX || mode == AddressMode::ABY) {
+				address = operand + (mode == AddressMode::ABX ? x : y);
+				page_crossed = (operand >> 8) != (address >> 8);
+			} else if constexpr (mode == AddressMode::IND) { // Page Boundary Glitch included
+				if (!read((operand & 0x00FF) == 0x00FF ? operand & 0xFF00 : operand + 1, high) || !read(operand, low)) return false;
+				address = (high << 8) | low;
+			} else if constexpr (mode == AddressMode::IZX) {
+				if (!read((u16)(operand + x) & 0x00FF, low) || !read((u16)(operand + x + 1) & 0x00FF, high)) return false;
+				address = (high << 8) | low;
+			} else if constexpr (mode == AddressMode::IZY) {
+				if (!read(operand & 0x00FF, low) || !read((operand + 1) & 0x00FF, high)) return false;
+				address = ((high << 8) | low) + y;
+				page_crossed = high != (address >> 8);
+			}
+		}
+
+		// Every memory access of the operation checked before anything changes
+		u8 value{ 0 };
+		if constexpr (reads_operand(op)) {
+			if (!read(address, value)) return false;
+		}
+		constexpr bool rmw = is_read_modify_write(info);
+		constexpr bool store = op == STA || op == STX || op == STY;
+		u8* target{ nullptr };
+		if constexpr (rmw || store) {
+			if (!(target = writes[address >> 8])) return false;
+			if constexpr (rmw) {
+				if (!read(address, value)) return false;
+			}
+		}
+		constexpr u8 pushes = op == JSR ? 2 : (op == PHA || op == PHP) ? 1 : 0;
+		u8* stack{ nullptr };
+		if constexpr (pushes || op == PLA || op == RTS) {
+			if (!(stack = writes[0x01])) return false; // Page 1 is RAM, only a watch keeps it from being plain
+		}
+
+		// Operation [R6502::operate]
+		u8 cycles = info.cycles;
+		auto branch = [&](bool condition) {
+			if (!condition) return;
+			address = pc;
+			pc += relative;
+			cycles += ((pc >> 8) != (address >> 8)) ? 2 : 1;
+		};
+		auto shift = [&](auto operation) { // Accumulator or memory
+			data = rmw ? value : a;
+			data = operation(data);
+			if constexpr (rmw) target[address & 0x00FF] = data;
+			else a = data;
+			load_flags(p, data);
+		};
+		auto compare = [&](u8 reg) {
+			u16 temp = reg - value;
+			set_flag(p, R6502::Z, temp == 0);
+			set_flag(p, R6502::C, !(temp & 0xFF00));
+			set_flag(p, R6502::N, temp & 0xFF00);
+		};
+		auto push = [&](u8 byte) { stack[sp--] = byte; };
+		auto pull = [&]() { return stack[++sp]; };
+
+		if constexpr (op == ADC) {
+			data = value;
+			u16 temp = a + data + (p & R6502::C);
+			set_flag(p, R6502::C, temp > 255);
+			set_flag(p, R6502::Z, temp == 0);
+			set_flag(p, R6502::N, temp & 0x80);
+			set_flag(p, R6502::V, (~((u16)a ^ (u16)data) & ((u16)a ^ (u16)temp)) & 0x0080);
+			a = temp & 0x00FF;
+		} else if constexpr (op == AND) {
+			data = value;
+			a &= data;
+			load_flags(p, a);
+		} else if constexpr (op == ASL) {
+			shift([&](u8 v) -> u8 { set_flag(p, R6502::C, v & 0x80); return (v << 1) & 0xFE; });
+		} else if constexpr (op == BCC) {
+			branch(!(p & R6502::C));
+		} else if constexpr (op == BCS) {
+			branch(p & R6502::C);
+		} else if constexpr (op == BEQ) {
+			branch(p & R6502::Z);
+		} else if constexpr (op == BIT) {
+			data = value & a;
+			set_flag(p, R6502::Z, data == 0);
+			set_flag(p, R6502::V, data & 0b01000000);
+			set_flag(p, R6502::N, data & 0b10000000);
+		} else if constexpr (op == BMI) {
+			branch(p & R6502::N);
+		} else if constexpr (op == BNE) {
+			branch(!(p & R6502::Z));
+		} else if constexpr (op == BPL) {
+			branch(!(p & R6502::N));
+		} else if constexpr (op == BVC) {
+			branch(!(p & R6502::V));
+		} else if constexpr (op == BVS) {
+			branch(p & R6502::V);
+		} else if constexpr (op == CLC) {
+			set_flag(p, R6502::C, false);
+		} else if constexpr (op == CLD) {
+			set_flag(p, R6502::D, false);
+		} else if constexpr (op == CLV) {
+			set_flag(p, R6502::V, false);
+		} else if constexpr (op == CMP) {
+			compare(a);
+		} else if constexpr (op == CPX) {
+			compare(x);
+		} else if constexpr (op == CPY) {
+			compare(y);
+		} else if constexpr (op == DEC) {
+			shift([](u8 v) -> u8 { return v - 1; });
+		} else if constexpr (op == DEX) {
+			load_flags(p, --x);
+		} else if constexpr (op == DEY) {
+			load_flags(p, --y);
+		} else if constexpr (op == EOR) {
+			data = value;
+			a ^= data;
+			load_flags(p, a);
+		} else if constexpr (op == INC) {
+			shift([](u8 v) -> u8 { return v + 1; });
+		} else if constexpr (op == INX) {
+			load_flags(p, ++x);
+		} else if constexpr (op == INY) {
+			load_flags(p, ++y);
+		} else if constexpr (op == JMP) {
+			pc = address;
+		} else if constexpr (op == JSR) {
+			push((pc >> 8) & 0x00FF);
+			data = pc & 0x00FF;
+			push(data);
+			pc = address;
+		} else if constexpr (op == LDA) {
+			a = value;
+			load_flags(p, a);
+		} else if constexpr (op == LDX) {
+			x = value;
+			load_flags(p, x);
+		} else if constexpr (op == LDY) {
+			y = value;
+			load_flags(p, y);
+		} else if constexpr (op == LSR) {
+			shift([&](u8 v) -> u8 { set_flag(p, R6502::C, v & 0x01); return v >> 1; });
+		} else if constexpr (op == NOP || op == XXX) {
+			// Addressing only
+		} else if constexpr (op == ORA) {
+			data = value;
+			a |= data;
+			set_flag(p, R6502::Z, a == 0);
+			set_flag(p, R6502::Z, data >> 7);
+		} else if constexpr (op == PHA) {
+			data = a;
+			push(data);
+		} else if constexpr (op == PHP) {
+			data = p | 0x30;
+			push(data);
+		} else if constexpr (op == PLA) {
+			a = pull();
+			load_flags(p, a);
+		} else if constexpr (op == ROL) {
+			shift([&](u8 v) -> u8 { const u8 carry = p & R6502::C; set_flag(p, R6502::C, v & 0x80); return ((v << 1) & 0xFE) | carry; });
+		} else if constexpr (op == ROR) {
+			shift([&](u8 v) -> u8 { const u8 carry = (p & R6502::C) << 7; set_flag(p, R6502::C, v & 0x01); return ((v >> 1) & 0x7F) | carry; });
+		} else if constexpr (op == RTS) {
+			pc = pull();
+			pc |= pull() << 8;
+		} else if constexpr (op == SBC) {
+			const u16 inverted = value ^ 0x00FF;
+			u16 temp = a + inverted + (p & R6502::C);
+			set_flag(p, R6502::C, temp > 0x00FF);
+			set_flag(p, R6502::Z, temp == 0);
+			set_flag(p, R6502::V, (((u16)temp ^ inverted) & ((u16)a ^ (u16)temp)) & 0x0080);
+			set_flag(p, R6502::N, temp & 0x80);
+			a = temp & 0x00FF;
+		} else if constexpr (op == SEC) {
+			set_flag(p, R6502::C, true);
+		} else if constexpr (op == SED) {
+			set_flag(p, R6502::D, true);
+		} else if constexpr (op == STA || op == STX || op == STY) {
+			data = op == STA ? a : op == STX ? x : y;
+			target[address & 0x00FF] = data;
+		} else if constexpr (op == TAX) {
+			x = a;
+			load_flags(p, x);
+		} else if constexpr (op == TAY) {
+			y = a;
+			load_flags(p, y);
+		} else if constexpr (op == TSX) {
+			x = sp;
+			load_flags(p, x);
+		} else if constexpr (op == TXA) {
+			a = x;
+			load_flags(p, a);
+		} else if constexpr (op == TXS) {
+			sp = x;
+		} else if constexpr (op == TYA) {
+			a = y;
+			load_flags(p, a);
+		}
+
+		if constexpr (has_page_cross_penalty(op)) {
+			cycles += page_crossed; // [OOPS Cycle]
+		}
+
+		// Only what the operation can have changed goes back [the arrays of the other registers stay untouched]
+		constexpr bool shifts_accumulator = mode == AddressMode::IMP && (op == ASL || op == LSR || op == ROL || op == ROR);
+		constexpr bool branches = mode == AddressMode::REL;
+		constexpr bool keeps_flags = store || branches || op == JMP || op == JSR || op == RTS || op == PHA || op == PHP
+			|| op == NOP || op == XXX || op == TXS;
+		_cycle[lane] += cycles;
+		_pc[lane] = pc;
+		_opcode[lane] = Opcode;
+		if constexpr (op == ADC || op == AND || op == EOR || op == ORA || op == SBC || op == LDA || op == PLA || op == TXA || op == TYA || shifts_accumulator) _a[lane] = a;
+		if constexpr (op == LDX || op == TAX || op == TSX || op == INX || op == DEX) _x[lane] = x;
+		if constexpr (op == LDY || op == TAY || op == INY || op == DEY) _y[lane] = y;
+		if constexpr (pushes || op == PLA || op == RTS || op == TXS) _sp[lane] = sp;
+		if constexpr (!keeps_flags) _p[lane] = p;
+		if constexpr (op == ADC || op == AND || op == BIT || op == EOR || op == ORA || op == JSR || op == PHA || op == PHP || store || rmw || shifts_accumulator) {
+			_data[lane] = data;
+		}
+		if constexpr (mode != AddressMode::IMP) _address_abs[lane] = address; // Branches -> only changed when taken
+		if constexpr (branches) _address_rel[lane] = relative;
+		return true;
+	}
+
+	template<u8 Opcode>
+	void Lockstep::run_group(Lockstep& lockstep, std::span<const u32> lanes) {
+		for (const u32 lane : lanes) {
+			if (!lockstep.run_lane<Opcode>(lane)) lockstep._scalar.push_back(lane);
+		}
+	}
+
+	const std::array<Lockstep::GroupKernel, 256> Lockstep::_kernels = []<std::size_t... Opcodes>(std::index_sequence<Opcodes...>) {
+		return std::array<Lockstep::GroupKernel, 256>{
+			(has_kernel(opcode_table[Opcodes].operation) ? &Lockstep::run_group<static_cast<u8>(Opcodes)> : nullptr)...
+		};
+	}(std::make_index_sequence<256>{});
+
+	void Lockstep::bind(std::span<CPU::R6502* const> cpus) {
+		_cpus.assign(cpus.begin(), cpus.end());
+		const u32 lanes = size();
+		_buses.resize(lanes);
+		_read_pages.resize(lanes);
+		_write_pages.resize(lanes);
+		for (u32 lane{ 0 }; lane < lanes; ++lane) {
+			_buses[lane] = _cpus[lane]->GetBus();
+			_read_pages[lane] = _buses[lane]->read_pages();
+			_write_pages[lane] = _buses[lane]->write_pages();
+		}
+
+		for (auto* registers : { &_a, &_x, &_y, &_sp, &_p, &_opcode, &_data, &_delayed }) registers->assign(lanes, 0);
+		for (auto* registers : { &_pc, &_address_abs, &_address_rel }) registers->assign(lanes, 0);
+		for (auto* registers : { &_cycle, &_target, &_horizon }) registers->assign(lanes, 0);
+		refresh();
+		_active.reserve(lanes);
+		_fetched.reserve(lanes);
+		_fetched_opcodes.reserve(lanes);
+		_grouped.reserve(lanes);
+		_scalar.reserve(lanes);
+	}
+
+	void Lockstep::run_until(std::span<const u64> target_cycles) {
+		_active.clear();
+		for (u32 lane{ 0 }; lane < size(); ++lane) {
+			load_lane(lane);
+			_target[lane] = target_cycles[lane];
+			if (_cycle[lane] >= _target[lane]) continue;
+			update_horizon(lane);
+			_active.push_back(lane);
+		}
+
+		while (true) {
+			// Fetch | Lanes whose next instruction a kernel may run, the rest to step(), lanes at their target out
+			_fetched.clear();
+			_fetched_opcodes.clear();
+			_scalar.clear();
+			u64 active{ 0 };
+			for (const u32 lane : _active) {
+				if (_cycle[lane] >= _target[lane]) continue;
+				_active[active++] = lane;
+
+				const u8* page = _read_pages[lane][_pc[lane] >> 8];
+				if (!page || _cycle[lane] >= _horizon[lane] || _delayed[lane]) {
+					_scalar.push_back(lane);
+					continue;
+				}
+				const u8 opcode = page[_pc[lane] & 0x00FF];
+				if (!_kernels[opcode]) {
+					_scalar.push_back(lane);
+					continue;
+				}
+				if (!_group_size[opcode]++) _opcodes.push_back(opcode);
+				_fetched.push_back(lane);
+				_fetched_opcodes.push_back(opcode);
+			}
+			_active.resize(active);
+			if (_active.empty()) break;
+			++_counters.rounds;
+
+			// Group by opcode [counting sort], then one kernel run per group | Lanes still in lockstep are one group already
+			if (_opcodes.size() == 1) _grouped.swap(_fetched);
+			else group_by_opcode();
+
+			u32 start{ 0 };
+			for (const u8 opcode : _opcodes) {
+				const u32 count = _group_size[opcode];
+				const u64 scalar = _scalar.size();
+				_kernels[opcode](*this, std::span<const u32>(_grouped).subspan(start, count));
+				_counters.lockstep_instructions += count - (_scalar.size() - scalar);
+				++_counters.groups;
+				_group_size[opcode] = 0;
+				start += count;
+			}
+			_opcodes.clear();
+
+			for (const u32 lane : _scalar) step_lane(lane);
+			_counters.scalar_instructions += _scalar.size();
+		}
+
+		for (u32 lane{ 0 }; lane < size(); ++lane) {
+			store_lane(lane);
+			_cpus[lane]->run_until(_cycle[lane]); // Runs nothing, catches the devices up like the end of run_until
+		}
+	}
+
+	void Lockstep::group_by_opcode() {
+		u32 start{ 0 };
+		for (const u8 opcode : _opcodes) {
+			_group_start[opcode] = start;
+			start += _group_size[opcode];
+		}
+		_grouped.resize(_fetched.size());
+		for (u64 i{ 0 }; i < _fetched.size(); ++i) _grouped[_group_start[_fetched_opcodes[i]]++] = _fetched[i];
+	}
+
+	void Lockstep::load_lane(u32 lane) {
+		R6502::State state;
+		_cpus[lane]->save_state(state);
+		_cycle[lane] = state.total_cycles;
+		_pc[lane] = state.program_counter;
+		_a[lane] = state.accumulator;
+		_x[lane] = state.x_register;
+		_y[lane] = state.y_register;
+		_sp[lane] = state.stack_pointer;
+		_p[lane] = state.status_register;
+		_opcode[lane] = state.opcode;
+		_data[lane] = state.data;
+		_address_abs[lane] = state.address_abs;
+		_address_rel[lane] = state.address_rel;
+		_delayed[lane] = state.delay_change;
+	}
+
+	void Lockstep::store_lane(u32 lane) {
+		R6502::State state;
+		_cpus[lane]->save_state(state);
+		state.total_cycles = _cycle[lane];
+		state.program_counter = _pc[lane];
+		state.cycles = 0; // Like run_until, pending clock() cycles are counted already
+		state.accumulator = _a[lane];
+		state.x_register = _x[lane];
+		state.y_register = _y[lane];
+		state.stack_pointer = _sp[lane];
+		state.status_register = _p[lane];
+		state.opcode = _opcode[lane];
+		state.data = _data[lane];
+		state.address_abs = _address_abs[lane];
+		state.address_rel = _address_rel[lane];
+		_cpus[lane]->load_state(state);
+	}
+
+	void Lockstep::step_lane(u32 lane) {
+		store_lane(lane);
+		_cpus[lane]->step();
+		load_lane(lane);
+		update_horizon(lane);
+	}
+
+	// Like R6502::run_block, from the cycle the next instruction starts on
+	void Lockstep::update_horizon(u32 lane) {
+		Bus& bus = *_buses[lane];
+		bus.set_cpu_cycle(_cycle[lane]);
+		_horizon[lane] = std::min(_target[lane], bus.quiet_until(_p[lane] & R6502::I));
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <span>
+
+#include "../Common/CommonHeaders.h"
+#include "R6502.h"
+
+namespace NES::CPU {
+
+	// Lockstep Stepper | N R6502s [separate machines, usually one ROM with different input] stepped together, one instruction per lane per round.
+	// While run_until() runs, the lanes' registers live here as structure of arrays. Every round fetches each lane's next opcode,
+	// groups the lanes by opcode and runs one kernel per opcode over its group: the same instruction on every lane, one after the other,
+	// on the registers of each lane and through its own page table [plain memory only, RAM and PRG-ROM]. A lane alone on its opcode
+	// [divergent code] is a group of one.
+	//
+	// Scalar Fallback -> a lane leaves the kernels for one instruction on its own R6502 [R6502::step] when the kernel could not do it
+	// the way step() would: an access to a handler page [PPU, APU, controllers, mapper registers, watched RAM], the interrupt horizon
+	// reached [Bus::quiet_until -> an interrupt or DMA may be due], an interrupt disable change pending, or BRK/RTI/CLI/SEI/PLP.
+	// The kernels follow R6502_SwitchCore.cpp operation for operation, so a lane ends every run in the state its R6502 would have reached alone.
+	class Lockstep {
+	public:
+		struct Counters {
+			u64		rounds{ 0 };
+			u64		groups{ 0 }; // Kernel runs, one per opcode per round
+			u64		lockstep_instructions{ 0 }; // Run by a kernel [lockstep_instructions / groups -> lanes per kernel run]
+			u64		scalar_instructions{ 0 }; // Run by R6502::step, interrupt entries included
+		};
+
+		// The CPUs of the lanes, in lane order | Each must stay alive and attached to its Bus while bound
+		void bind(std::span<CPU::R6502* const> cpus);
+
+		[[nodiscard]] u32 size() const { return static_cast<u32>(_cpus.size()); }
+
+		// Runs every lane to at least its target cycle, like R6502::run_until on each | Lanes already there are left alone.
+		// The registers are copied in at the start and back out at the end, the R6502s hold them between runs.
+		void run_until(std::span<const u64> target_cycles);
+
+		// Registers from the R6502s again, after they were changed outside run_until [load_state]
+		void refresh() { for (u32 lane{ 0 }; lane < size(); ++lane) load_lane(lane); }
+
+		// Registers of every lane as of the end of the last run
+		[[nodiscard]] std::span<const u64> cycle() const { return _cycle; }
+		[[nodiscard]] std::span<const u16> pc() const { return _pc; }
+		[[nodiscard]] std::span<const u8> a() const { return _a; }
+		[[nodiscard]] std::span<const u8> x() const { return _x; }
+		[[nodiscard]] std::span<const u8> y() const { return _y; }
+		[[nodiscard]] std::span<const u8> sp() const { return _sp; }
+		[[nodiscard]] std::span<const u8> p() const { return _p; }
+
+		[[nodiscard]] const Counters& counters() const { return _counters; }
+		void reset_counters() { _counters = {}; }
+
+	private:
+		using GroupKernel = void(*)(Lockstep&, std::span<const u32>);
+
+		template<u8 Opcode> static void run_group(Lockstep& lockstep, std::span<const u32> lanes);
+		template<u8 Opcode> bool run_lane(u32 lane); // false -> nothing changed, the lane falls back to step()
+
+		void load_lane(u32 lane); // SoA <- R6502
+		void store_lane(u32 lane); // R6502 <- SoA
+		void step_lane(u32 lane); // One instruction on the lane's R6502
+		void update_horizon(u32 lane);
+		void group_by_opcode(); // _fetched -> _grouped
+
+		static const std::array<GroupKernel, 256> _kernels; // nullptr -> always step()
+
+		std::vector<CPU::R6502*>		_cpus;
+		std::vector<CPU::Bus*>			_buses;
+		std::vector<const u8* const*>	_read_pages; // Bus::read_pages of each lane, updated in place on bank switches
+		std::vector<u8* const*>			_write_pages;
+
+		// Registers
+		std::vector<u64>	_cycle;
+		std::vector<u16>	_pc;
+		std::vector<u8>		_a;
+		std::vector<u8>		_x;
+		std::vector<u8>		_y;
+		std::vector<u8>		_sp;
+		std::vector<u8>		_p;
+		// Scratch the R6502 keeps in its save state [R6502::State], kept so a lane's state does not depend on how it was run
+		std::vector<u8>		_opcode;
+		std::vector<u8>		_data;
+		std::vector<u16>	_address_abs;
+		std::vector<u16>	_address_rel;
+
+		std::vector<u64>	_target;
+		std::vector<u64>	_horizon; // The kernels may start instructions before this cycle
+		std::vector<u8>		_delayed; // Interrupt disable change pending -> the next instruction on step()
+
+		// Per round
+		std::vector<u32>		_active; // Lanes short of their target
+		std::vector<u32>		_fetched; // Lanes with a kernel for their opcode
+		std::vector<u8>			_fetched_opcodes; // Theirs, in the same order
+		std::vector<u32>		_grouped; // _fetched sorted by opcode
+		std::vector<u32>		_scalar; // Lanes going to step() this round
+		std::vector<u8>			_opcodes; // Distinct opcodes fetched this round, in first-seen order
+		std::array<u32, 256>	_group_size{};
+		std::array<u32, 256>	_group_start{};
+
+		Counters	_counters;
+	};
+}
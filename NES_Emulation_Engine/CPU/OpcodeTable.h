@@ -0,0 +1,396 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+// Single source of truth for the R-MOS6502 instruction set.
+// Both execution cores are generated from this table:
+//  - the member-function-pointer core builds R6502::_lookup from it at start-up.
+//  - the switch-dispatched core instantiates one fully inlined case per opcode from it at compile time.
+namespace NES::CPU {
+
+	// Addressing Modes | https://www.nesdev.org/wiki/CPU_addressing_modes
+	enum class AddressMode : u8 {
+		IMP, // Implicit/Implied/Accumulator
+		IMM, // #$00
+		ZP0, // $00
+		ZPX, // $00, X
+		ZPY, // $00, Y
+		REL, // $0000 [Relative to Program-Counter]
+		ABS, // $0000
+		ABX, // $0000, X
+		ABY, // $0000, Y
+		IND, // ($0000)
+		IZX, // ($00, X)
+		IZY, // ($00), Y
+
+		count
+	};
+
+	// OPCODES/Instructions: https://www.nesdev.org/wiki/Instruction_reference | https://www.oxyron.de/html/opcodes02.html
+	enum class Operation : u8 {
+		ADC, AND, ASL, BCC, BCS, BEQ, BIT, BMI, BNE, BPL, BRK, BVC, BVS, CLC,
+		CLD, CLI, CLV, CMP, CPX, CPY, DEC, DEX, DEY, EOR, INC, INX, INY, JMP,
+		JSR, LDA, LDX, LDY, LSR, NOP, ORA, PHA, PHP, PLA, PLP, ROL, ROR, RTI,
+		RTS, SBC, SEC, SED, SEI, STA, STX, STY, TAX, TAY, TSX, TXA, TXS, TYA,
+
+		XXX, // Illegal Opcodes
+
+		count
+	};
+
+	struct OpcodeInfo {
+		Operation	operation = Operation::XXX;
+		AddressMode	mode = AddressMode::IMP;
+		u8			cycles = 2;
+	};
+
+	namespace detail {
+		using Op = Operation;
+		using AM = AddressMode;
+	} // detail namespace
+
+	// Lookup Table Map for R-MOS6502 Instructions | Row-Major 16x16 -> [opcode >> 4][opcode & 0x0F]
+	// NOTE: * -> add 1 cycle if page boundary is crossed and/or add 1 cycle on branches if taken.
+	inline constexpr std::array<OpcodeInfo, 256> opcode_table{ {
+		// 0x
+		{ detail::Op::BRK, detail::AM::IMM, 7 },
+		{ detail::Op::ORA, detail::AM::IZX, 6 },
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZX, 8 }, // Illegal -> SLO
+		{ detail::Op::NOP, detail::AM::ZP0, 3 }, // Illegal -> NOP
+		{ detail::Op::ORA, detail::AM::ZP0, 3 },
+		{ detail::Op::ASL, detail::AM::ZP0, 5 },
+		{ detail::Op::XXX, detail::AM::ZP0, 5 }, // Illegal -> SLO
+		{ detail::Op::PHP, detail::AM::IMP, 3 },
+		{ detail::Op::ORA, detail::AM::IMM, 2 },
+		{ detail::Op::ASL, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> ANC
+		{ detail::Op::NOP, detail::AM::ABS, 4 }, // Illegal -> NOP
+		{ detail::Op::ORA, detail::AM::ABS, 4 },
+		{ detail::Op::ASL, detail::AM::ABS, 6 },
+		{ detail::Op::XXX, detail::AM::ABS, 6 }, // Illegal -> SLO
+
+		// 1x
+		{ detail::Op::BPL, detail::AM::REL, 2 }, // *
+		{ detail::Op::ORA, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 8 }, // Illegal -> SLO
+		{ detail::Op::NOP, detail::AM::ZPX, 4 }, // Illegal -> NOP
+		{ detail::Op::ORA, detail::AM::ZPX, 4 },
+		{ detail::Op::ASL, detail::AM::ZPX, 6 },
+		{ detail::Op::XXX, detail::AM::ZPX, 6 }, // Illegal -> SLO
+		{ detail::Op::CLC, detail::AM::IMP, 2 },
+		{ detail::Op::ORA, detail::AM::ABY, 4 }, // *
+		{ detail::Op::NOP, detail::AM::IMP, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::ABY, 7 }, // Illegal -> SLO
+		{ detail::Op::NOP, detail::AM::ABX, 4 }, // Illegal -> NOP | *
+		{ detail::Op::ORA, detail::AM::ABX, 4 }, // *
+		{ detail::Op::ASL, detail::AM::ABX, 7 },
+		{ detail::Op::XXX, detail::AM::ABX, 7 }, // Illegal -> SLO
+
+		// 2x
+		{ detail::Op::JSR, detail::AM::ABS, 6 },
+		{ detail::Op::AND, detail::AM::IZX, 6 },
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZX, 8 }, // Illegal -> RLA
+		{ detail::Op::BIT, detail::AM::ZP0, 3 },
+		{ detail::Op::AND, detail::AM::ZP0, 3 },
+		{ detail::Op::ROL, detail::AM::ZP0, 5 },
+		{ detail::Op::XXX, detail::AM::ZP0, 5 }, // Illegal -> RLA
+		{ detail::Op::PLP, detail::AM::IMP, 4 },
+		{ detail::Op::AND, detail::AM::IMM, 2 },
+		{ detail::Op::ROL, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> ANC
+		{ detail::Op::BIT, detail::AM::ABS, 4 },
+		{ detail::Op::AND, detail::AM::ABS, 4 },
+		{ detail::Op::ROL, detail::AM::ABS, 6 },
+		{ detail::Op::XXX, detail::AM::ABS, 6 }, // Illegal -> RLA
+
+		// 3x
+		{ detail::Op::BMI, detail::AM::REL, 2 }, // *
+		{ detail::Op::AND, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 8 }, // Illegal -> RLA
+		{ detail::Op::NOP, detail::AM::ZPX, 4 }, // Illegal -> NOP
+		{ detail::Op::AND, detail::AM::ZPX, 4 },
+		{ detail::Op::ROL, detail::AM::ZPX, 6 },
+		{ detail::Op::XXX, detail::AM::ZPX, 6 }, // Illegal -> RLA
+		{ detail::Op::SEC, detail::AM::IMP, 2 },
+		{ detail::Op::AND, detail::AM::ABY, 4 }, // *
+		{ detail::Op::NOP, detail::AM::IMP, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::ABY, 7 }, // Illegal -> RLA
+		{ detail::Op::NOP, detail::AM::ABX, 4 }, // Illegal -> NOP | *
+		{ detail::Op::AND, detail::AM::ABX, 4 }, // *
+		{ detail::Op::ROL, detail::AM::ABX, 7 },
+		{ detail::Op::XXX, detail::AM::ABX, 7 }, // Illegal -> RLA
+
+		// 4x
+		{ detail::Op::RTI, detail::AM::IMP, 6 },
+		{ detail::Op::EOR, detail::AM::IZX, 6 },
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZX, 8 }, // Illegal -> SRE
+		{ detail::Op::NOP, detail::AM::ZP0, 3 }, // Illegal -> NOP
+		{ detail::Op::EOR, detail::AM::ZP0, 3 },
+		{ detail::Op::LSR, detail::AM::ZP0, 5 },
+		{ detail::Op::XXX, detail::AM::ZP0, 5 }, // Illegal -> SRE
+		{ detail::Op::PHA, detail::AM::IMP, 3 },
+		{ detail::Op::EOR, detail::AM::IMM, 2 },
+		{ detail::Op::LSR, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> ALR
+		{ detail::Op::JMP, detail::AM::ABS, 3 },
+		{ detail::Op::EOR, detail::AM::ABS, 4 },
+		{ detail::Op::LSR, detail::AM::ABS, 6 },
+		{ detail::Op::XXX, detail::AM::ABS, 6 }, // Illegal -> SRE
+
+		// 5x
+		{ detail::Op::BVC, detail::AM::REL, 2 }, // *
+		{ detail::Op::EOR, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 8 }, // Illegal -> SRE
+		{ detail::Op::NOP, detail::AM::ZPX, 4 }, // Illegal -> NOP
+		{ detail::Op::EOR, detail::AM::ZPX, 4 },
+		{ detail::Op::LSR, detail::AM::ZPX, 6 },
+		{ detail::Op::XXX, detail::AM::ZPX, 6 }, // Illegal -> SRE
+		{ detail::Op::CLI, detail::AM::IMP, 2 },
+		{ detail::Op::EOR, detail::AM::ABY, 4 }, // *
+		{ detail::Op::NOP, detail::AM::IMP, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::ABY, 7 }, // Illegal -> SRE
+		{ detail::Op::NOP, detail::AM::ABX, 4 }, // Illegal -> NOP | *
+		{ detail::Op::EOR, detail::AM::ABX, 4 }, // *
+		{ detail::Op::LSR, detail::AM::ABX, 7 },
+		{ detail::Op::XXX, detail::AM::ABX, 7 }, // Illegal -> SRE
+
+		// 6x
+		{ detail::Op::RTS, detail::AM::IMP, 6 },
+		{ detail::Op::ADC, detail::AM::IZX, 6 },
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZX, 8 }, // Illegal -> RRA
+		{ detail::Op::NOP, detail::AM::ZP0, 3 }, // Illegal -> NOP
+		{ detail::Op::ADC, detail::AM::ZP0, 3 },
+		{ detail::Op::ROR, detail::AM::ZP0, 5 },
+		{ detail::Op::XXX, detail::AM::ZP0, 5 }, // Illegal -> RRA
+		{ detail::Op::PLA, detail::AM::IMP, 4 },
+		{ detail::Op::ADC, detail::AM::IMM, 2 },
+		{ detail::Op::ROR, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> ARR
+		{ detail::Op::JMP, detail::AM::IND, 5 },
+		{ detail::Op::ADC, detail::AM::ABS, 4 },
+		{ detail::Op::ROR, detail::AM::ABS, 6 },
+		{ detail::Op::XXX, detail::AM::ABS, 6 }, // Illegal -> RRA
+
+		// 7x
+		{ detail::Op::BVS, detail::AM::REL, 2 }, // *
+		{ detail::Op::ADC, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 8 }, // Illegal -> RRA
+		{ detail::Op::NOP, detail::AM::ZPX, 4 }, // Illegal -> NOP
+		{ detail::Op::ADC, detail::AM::ZPX, 4 },
+		{ detail::Op::ROR, detail::AM::ZPX, 6 },
+		{ detail::Op::XXX, detail::AM::ZPX, 6 }, // Illegal -> RRA
+		{ detail::Op::SEI, detail::AM::IMP, 2 },
+		{ detail::Op::ADC, detail::AM::ABY, 4 }, // *
+		{ detail::Op::NOP, detail::AM::IMP, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::ABY, 7 }, // Illegal -> RRA
+		{ detail::Op::NOP, detail::AM::ABX, 4 }, // Illegal -> NOP | *
+		{ detail::Op::ADC, detail::AM::ABX, 4 }, // *
+		{ detail::Op::ROR, detail::AM::ABX, 7 },
+		{ detail::Op::XXX, detail::AM::ABX, 7 }, // Illegal -> RRA
+
+		// 8x
+		{ detail::Op::NOP, detail::AM::IMM, 2 }, // Illegal -> NOP
+		{ detail::Op::STA, detail::AM::IZX, 6 },
+		{ detail::Op::NOP, detail::AM::IMM, 2 }, // Illegal -> NOP
+		{ detail::Op::NOP, detail::AM::IZX, 6 }, // Illegal -> SAX
+		{ detail::Op::STY, detail::AM::ZP0, 3 },
+		{ detail::Op::STA, detail::AM::ZP0, 3 },
+		{ detail::Op::STX, detail::AM::ZP0, 3 },
+		{ detail::Op::NOP, detail::AM::ZP0, 3 }, // Illegal -> SAX
+		{ detail::Op::DEY, detail::AM::IMP, 2 },
+		{ detail::Op::NOP, detail::AM::IMM, 2 }, // Illegal -> NOP
+		{ detail::Op::TXA, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> XAA | RED
+		{ detail::Op::STY, detail::AM::ABS, 4 },
+		{ detail::Op::STA, detail::AM::ABS, 4 },
+		{ detail::Op::STX, detail::AM::ABS, 4 },
+		{ detail::Op::NOP, detail::AM::ABS, 4 }, // Illegal -> SAX
+
+		// 9x
+		{ detail::Op::BCC, detail::AM::REL, 2 }, // *
+		{ detail::Op::STA, detail::AM::IZY, 6 },
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 6 }, // Illegal -> AHX | BLUE
+		{ detail::Op::STY, detail::AM::ZPX, 4 },
+		{ detail::Op::STA, detail::AM::ZPX, 4 },
+		{ detail::Op::STX, detail::AM::ZPY, 4 },
+		{ detail::Op::XXX, detail::AM::ZPY, 4 }, // Illegal -> SAX
+		{ detail::Op::TYA, detail::AM::IMP, 2 },
+		{ detail::Op::STA, detail::AM::ABY, 5 },
+		{ detail::Op::TXS, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::ABY, 5 }, // Illegal -> TAS | BLUE
+		{ detail::Op::XXX, detail::AM::ABX, 5 }, // Illegal -> SHY | BLUE
+		{ detail::Op::STA, detail::AM::ABX, 5 },
+		{ detail::Op::XXX, detail::AM::ABY, 5 }, // Illegal -> SHX | BLUE
+		{ detail::Op::XXX, detail::AM::ABY, 5 }, // Illegal -> AHX | BLUE
+
+		// Ax
+		{ detail::Op::LDY, detail::AM::IMM, 2 },
+		{ detail::Op::LDA, detail::AM::IZX, 6 },
+		{ detail::Op::LDX, detail::AM::IMM, 2 },
+		{ detail::Op::XXX, detail::AM::IZX, 6 }, // Illegal -> LAX
+		{ detail::Op::LDY, detail::AM::ZP0, 3 },
+		{ detail::Op::LDA, detail::AM::ZP0, 3 },
+		{ detail::Op::LDX, detail::AM::ZP0, 3 },
+		{ detail::Op::XXX, detail::AM::ZP0, 3 }, // Illegal -> LAX
+		{ detail::Op::TAY, detail::AM::IMP, 2 },
+		{ detail::Op::LDA, detail::AM::IMM, 2 },
+		{ detail::Op::TAX, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> LAX | RED
+		{ detail::Op::LDY, detail::AM::ABS, 4 },
+		{ detail::Op::LDA, detail::AM::ABS, 4 },
+		{ detail::Op::LDX, detail::AM::ABS, 4 },
+		{ detail::Op::XXX, detail::AM::ABS, 4 }, // Illegal -> LAX
+
+		// Bx
+		{ detail::Op::BCS, detail::AM::REL, 2 }, // *
+		{ detail::Op::LDA, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 5 }, // Illegal -> LAX | *
+		{ detail::Op::LDY, detail::AM::ZPX, 4 },
+		{ detail::Op::LDA, detail::AM::ZPX, 4 },
+		{ detail::Op::LDX, detail::AM::ZPY, 4 },
+		{ detail::Op::XXX, detail::AM::ZPY, 4 }, // Illegal -> LAX
+		{ detail::Op::CLV, detail::AM::IMP, 2 },
+		{ detail::Op::LDA, detail::AM::ABY, 4 }, // *
+		{ detail::Op::TSX, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::ABY, 4 }, // Illegal -> LAS | *
+		{ detail::Op::LDY, detail::AM::ABX, 4 }, // *
+		{ detail::Op::LDA, detail::AM::ABX, 4 }, // *
+		{ detail::Op::LDX, detail::AM::ABY, 4 }, // *
+		{ detail::Op::XXX, detail::AM::ABY, 4 }, // Illegal -> LAX | *
+
+		// Cx
+		{ detail::Op::CPY, detail::AM::IMM, 2 },
+		{ detail::Op::CMP, detail::AM::IZX, 6 },
+		{ detail::Op::NOP, detail::AM::IMM, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::IZX, 8 }, // Illegal -> DCP
+		{ detail::Op::CPY, detail::AM::ZP0, 3 },
+		{ detail::Op::CMP, detail::AM::ZP0, 3 },
+		{ detail::Op::DEC, detail::AM::ZP0, 5 },
+		{ detail::Op::XXX, detail::AM::ZP0, 5 }, // Illegal -> DCP
+		{ detail::Op::INY, detail::AM::IMP, 2 },
+		{ detail::Op::CMP, detail::AM::IMM, 2 },
+		{ detail::Op::DEX, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> AXS
+		{ detail::Op::CPY, detail::AM::ABS, 4 },
+		{ detail::Op::CMP, detail::AM::ABS, 4 },
+		{ detail::Op::DEC, detail::AM::ABS, 6 },
+		{ detail::Op::XXX, detail::AM::ABS, 6 }, // Illegal -> DCP
+
+		// Dx
+		{ detail::Op::BNE, detail::AM::REL, 2 }, // *
+		{ detail::Op::CMP, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 8 }, // Illegal -> DCP
+		{ detail::Op::NOP, detail::AM::ZPX, 4 }, // Illegal -> NOP
+		{ detail::Op::CMP, detail::AM::ZPX, 4 },
+		{ detail::Op::DEC, detail::AM::ZPX, 6 },
+		{ detail::Op::XXX, detail::AM::ZPX, 6 }, // Illegal -> DCP
+		{ detail::Op::CLD, detail::AM::IMP, 2 },
+		{ detail::Op::CMP, detail::AM::ABY, 4 }, // *
+		{ detail::Op::NOP, detail::AM::IMP, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::ABY, 7 }, // Illegal -> DCP
+		{ detail::Op::NOP, detail::AM::ABX, 4 }, // Illegal -> NOP | *
+		{ detail::Op::CMP, detail::AM::ABX, 4 }, // *
+		{ detail::Op::DEC, detail::AM::ABX, 7 },
+		{ detail::Op::XXX, detail::AM::ABX, 7 }, // Illegal -> DCP
+
+		// Ex
+		{ detail::Op::CPX, detail::AM::IMM, 2 },
+		{ detail::Op::SBC, detail::AM::IZX, 6 },
+		{ detail::Op::NOP, detail::AM::IMM, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::IZX, 8 }, // Illegal -> ISC
+		{ detail::Op::CPX, detail::AM::ZP0, 3 },
+		{ detail::Op::SBC, detail::AM::ZP0, 3 },
+		{ detail::Op::INC, detail::AM::ZP0, 5 },
+		{ detail::Op::XXX, detail::AM::ZP0, 5 }, // Illegal -> ISC
+		{ detail::Op::INX, detail::AM::IMP, 2 },
+		{ detail::Op::SBC, detail::AM::IMM, 2 },
+		{ detail::Op::NOP, detail::AM::IMP, 2 },
+		{ detail::Op::XXX, detail::AM::IMM, 2 }, // Illegal -> SBC
+		{ detail::Op::CPX, detail::AM::ABS, 4 },
+		{ detail::Op::SBC, detail::AM::ABS, 4 },
+		{ detail::Op::INC, detail::AM::ABS, 6 },
+		{ detail::Op::XXX, detail::AM::ABS, 6 }, // Illegal -> ISC
+
+		// Fx
+		{ detail::Op::BEQ, detail::AM::REL, 2 }, // *
+		{ detail::Op::SBC, detail::AM::IZY, 5 }, // *
+		{}, // Illegal -> KIL
+		{ detail::Op::XXX, detail::AM::IZY, 8 }, // Illegal -> ISC
+		{ detail::Op::NOP, detail::AM::ZPX, 4 }, // Illegal -> NOP
+		{ detail::Op::SBC, detail::AM::ZPX, 4 },
+		{ detail::Op::INC, detail::AM::ZPX, 6 },
+		{ detail::Op::XXX, detail::AM::ZPX, 6 }, // Illegal -> ISC
+		{ detail::Op::SED, detail::AM::IMP, 2 },
+		{ detail::Op::SBC, detail::AM::ABY, 4 }, // *
+		{ detail::Op::NOP, detail::AM::IMP, 2 }, // Illegal -> NOP
+		{ detail::Op::XXX, detail::AM::ABY, 7 }, // Illegal -> ISC
+		{ detail::Op::NOP, detail::AM::ABX, 4 }, // Illegal -> NOP | *
+		{ detail::Op::SBC, detail::AM::ABX, 4 }, // *
+		{ detail::Op::INC, detail::AM::ABX, 7 },
+		{ detail::Op::XXX, detail::AM::ABX, 7 }, // Illegal -> ISC
+	} };
+
+	// Mnemonics live apart from the hot table, so the table stays 3 bytes per opcode.
+	inline constexpr std::array<const char*, static_cast<u8>(Operation::count)> operation_names{
+		"ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK", "BVC", "BVS", "CLC",
+		"CLD", "CLI", "CLV", "CMP", "CPX", "CPY", "DEC", "DEX", "DEY", "EOR", "INC", "INX", "INY", "JMP",
+		"JSR", "LDA", "LDX", "LDY", "LSR", "NOP", "ORA", "PHA", "PHP", "PLA", "PLP", "ROL", "ROR", "RTI",
+		"RTS", "SBC", "SEC", "SED", "SEI", "STA", "STX", "STY", "TAX", "TAY", "TSX", "TXA", "TXS", "TYA",
+		"???",
+	};
+
+	[[nodiscard]] constexpr const char* opcode_name(u8 opcode) {
+		return operation_names[static_cast<u8>(opcode_table[opcode].operation)];
+	}
+
+	// Bytes the instruction takes, opcode included
+	[[nodiscard]] constexpr u8 instruction_length(u8 opcode) {
+		switch (opcode_table[opcode].mode) {
+		case AddressMode::IMP: return 1;
+		case AddressMode::ABS: case AddressMode::ABX: case AddressMode::ABY: case AddressMode::IND: return 3;
+		default: return 2;
+		}
+	}
+
+	// Read instructions pay the [OOPS Cycle] when an indexed address crosses a page; stores and read-modify-write always pay it in their base count.
+	[[nodiscard]] constexpr bool has_page_cross_penalty(Operation operation) {
+		switch (operation) {
+		case Operation::ADC: case Operation::AND: case Operation::CMP: case Operation::EOR:
+		case Operation::LDA: case Operation::LDX: case Operation::LDY: case Operation::NOP:
+		case Operation::ORA: case Operation::SBC:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// Read-Modify-Write on memory -> read, write back the old value, write the new one [the accumulator forms touch no bus]
+	[[nodiscard]] constexpr bool is_read_modify_write(const OpcodeInfo& info) {
+		switch (info.operation) {
+		case Operation::ASL: case Operation::DEC: case Operation::INC: case Operation::LSR: case Operation::ROL: case Operation::ROR:
+			return info.mode != AddressMode::IMP;
+		default:
+			return false;
+		}
+	}
+
+	// Bus cycle of the instruction's data access, counted from its opcode fetch [0] | Devices behind I/O pages catch up to it.
+	// Reads and writes happen on the last cycle [one later with the OOPS cycle]. Read-modify-write reads 3 cycles before the end
+	// and writes on each of the two cycles after. Instructions without a data access get their last cycle as well.
+	[[nodiscard]] constexpr u8 access_offset(const OpcodeInfo& info) {
+		return is_read_modify_write(info) ? info.cycles - 3 : info.cycles - 1;
+	}
+
+	static_assert(sizeof(OpcodeInfo) == 3, "OpcodeInfo should stay packed, it is the hot dispatch table.");
+}
@@ -1,37 +1,6 @@
 #include "R6502.h"
 
-#if CPU_TEST
-#include <iostream>
-#endif // CPU_TEST
-
-
 namespace NES::CPU {
-	namespace {
-
-		const char hexChar[] = "0123456789ABCDEF";
-
-		std::string hexString(u32 value, u8 length) {
-			std::string t(length, '0');
-
-			for (int i{ length - 1 }; i >= 0; --i, value >>= 4) {
-				t[i] = hexChar[value & 0xF];
-			}
-
-			return "0x" + t;
-		}
-
-		std::string binString(u32 value, u8 length) {
-			std::string t(length, '0');
-
-			for (int i{ length - 1 }; i >= 0; --i, value >>= 1) {
-				t[i] = value & 0x1 ? '1' : '0';
-			}
-
-			return "0b" + t;
-		}
-
-	} // anonymous namespace
-
 	// WARNING: If the opcodes and addressing modes are not implemented, then linker will throw a LINK2019 code while assigning their function pointer to lookup.
 
 	// OPDCODES/Instructions | TODO: Put all read into _data from addressing modes to opcodes
@@ -47,66 +16,33 @@ namespace NES::CPU {
 
 		_accumulator = temp & 0x00FF;
 
-#if CPU_TEST
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Overflow Flag: " << hexString(GetFlag(StateFlags::V), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
-		return 1;
+		return 0;
 	}
 
 	// Bitwise AND
 	u8 R6502::AND() { // A = A & memory | ANDs a memory value and the accumulator, bit by bit.
-#if CPU_TEST
-		std::cout << "Bitwise AND: \n";
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		_data = read_memory(_address_abs);
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
+		_data = read_memory(_address_abs); // Latched in both builds, the flags below are derived from it
 		_accumulator &= _data;
-#else
-		_accumulator &= read_memory(_address_abs);
-#endif
 
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::N, _accumulator >> 7);
 
-#if CPU_TEST
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
 	// Equivalent to multiplying an unsigned value by 2, with carry indicating overflow. | read-modify-write instruction -> Costs extra cycle [first writes the original data in the location, then writes the modified data]
 	u8 R6502::ASL() { // Arithmetic Shift Left | shifts all of the bits of a memory value or the accumulator one position to the left, moving the value of each bit into the next bit. Bit 7 is shifted into the carry flag, and 0 is shifted into bit 0.
-		_data = (this->*read)(_address_abs, false); // Read
-		(this->*write)(_address_abs); // Additional -> writes the original value
-
-#if CPU_TEST
-		std::cout << "Arithmetic Shift Left: " << "\n";
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-#endif
+		_data = read_operand(); // Read
+		write_operand(); // Additional -> writes the original value
 
 		SetFlag(StateFlags::C, _data & 0x80);
 		_data <<= 1; // Modify
 		_data &= 0xFE;
-		(this->*write)(_address_abs); // Write
+		write_operand(); // Write
 
 		SetFlag(StateFlags::Z, _data == 0);
 		SetFlag(StateFlags::N, _data >> 7);
 
-#if CPU_TEST
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -114,89 +50,46 @@ namespace NES::CPU {
 
 	// Branch if Carry Clear | BLT - Branch if Less Than
 	u8 R6502::BCC() {
-#if CPU_TEST
-		std::cout << "Branch if Carry Clear: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (!GetFlag(StateFlags::C)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
 		return 0; // Jump/Branch Not Taken
 	}
 
 	// Branch if Carry Set
 	u8 R6502::BCS() {
-#if CPU_TEST
-		std::cout << "Branch if Carry Set: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (GetFlag(StateFlags::C)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
 		return 0; // Jump/Branch Not Taken
 	}
 
 	// Branch if Equal
 	u8 R6502::BEQ() {
-#if CPU_TEST
-		std::cout << "Branch if Equal: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (GetFlag(StateFlags::Z)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
-
 		return 0; // Jump/Branch Not Taken
 	}
 	/// END ///
@@ -210,12 +103,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::V, _data & 0b01000000);
 		SetFlag(StateFlags::N, _data & 0b10000000);
 
-#if CPU_TEST
-		std::cout << "Bit Test for Status Register: " << "\n";
-		std::cout << "Bit Test Result: " << binString(_accumulator, 8) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -223,91 +110,46 @@ namespace NES::CPU {
 
 	// Branch if Minus
 	u8 R6502::BMI() {
-#if CPU_TEST
-		std::cout << "Branch if Minus: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::N), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (GetFlag(StateFlags::N)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
-
 		return 0; // Jump/Branch Not Taken
 	}
 
 	// Branch if Not Equal
 	u8 R6502::BNE() {
-#if CPU_TEST
-		std::cout << "Branch if Not Equal: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (!GetFlag(StateFlags::Z)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
-
 		return 0; // Jump/Branch Not Taken
 	}
 
 	// Branch if Plus
 	u8 R6502::BPL() {
-#if CPU_TEST
-		std::cout << "Branch if Plus: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::N), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (!GetFlag(StateFlags::N)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
-
 		return 0; // Jump/Branch Not Taken
 	}
 	/// END ///
@@ -319,16 +161,6 @@ namespace NES::CPU {
 		_address_abs = 0xFFFE;  // IRQ/BRK vector, which may point at a mapper's interrupt handler (or, less often, a handler for APU interrupts) | $FFFE$FFFF
 		interrupt();
 
-#if CPU_TEST
-		std::cout << "BREAK [BRK]: " << "\n";
-		std::cout << "Stack Pointer Before BRK: " << hexString(_stack_pointer + 3, 2) << "\n";
-		std::cout << "Program Counter: " << hexString(_program_counter, 4) << "\n";
-		std::cout << "Stack Pointer After BRK: " << hexString(_stack_pointer, 2) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-
-		DisassembleRAM(0x01B0, 0x0200);
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -336,61 +168,31 @@ namespace NES::CPU {
 
 	// Branch if Overflow Clear
 	u8 R6502::BVC() {
-#if CPU_TEST
-		std::cout << "Branch if Overflow Clear: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::V), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (!GetFlag(StateFlags::V)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
-
 		return 0; // Jump/Branch Not Taken
 	}
 
 	// Branch if Overflow Set
 	u8 R6502::BVS() {
-#if CPU_TEST
-		std::cout << "Branch if Overflow Set: " << "\n";
-		std::cout << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << _program_counter << " " << hexString(_program_counter, 4) << "\n";
-		std::cout << _address_rel << " " << hexString(_address_rel, 2) << "\n";
-#endif
 		if (GetFlag(StateFlags::V)) {
 			_address_abs = _program_counter;
 			_program_counter += _address_rel;
 
-#if CPU_TEST
-			std::cout << "Branch Taken: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif
-
 			if ((_program_counter >> 8) != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 2;
+				return 2; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
 			return 1; // Jump/Branch Taken
 		}
 
-#if CPU_TEST
-		std::cout << "Branch Not Taken! " << "\n\n";
-#endif
-
 		return 0; // Jump/Branch Not Taken
 	}
 	/// END ///
@@ -401,11 +203,6 @@ namespace NES::CPU {
 	u8 R6502::CLC() { // clears the carry flag. | C = 0
 		SetFlag(StateFlags::C, false);
 
-#if CPU_TEST
-		std::cout << "Clear Carry Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -413,23 +210,13 @@ namespace NES::CPU {
 	u8 R6502::CLD() { // clears the decimal flag. | D = 0
 		SetFlag(StateFlags::D, false);
 
-#if CPU_TEST
-		std::cout << "Clear Decimal Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
 	// Clear Interrupt Disable
 	u8 R6502::CLI() {
 		_delay_change_value = 0;
-		delay_assign = &R6502::assign_delay_interrupt_disable_change; // The effect of changing Interrupt Disable [I] flag is delayed 1 instruction, because the flag is changed after IRQ is polled, delaying the effect until IRQ is polled in the next instruction like with CLI and SEI.
-
-#if CPU_TEST
-		std::cout << "Clear Interrupt Disable Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
+		_delay_assign = true; // The effect of changing Interrupt Disable [I] flag is delayed 1 instruction, because the flag is changed after IRQ is polled, delaying the effect until IRQ is polled in the next instruction like with CLI and SEI.
 
 		return 0;
 	}
@@ -438,11 +225,6 @@ namespace NES::CPU {
 	u8 R6502::CLV() {
 		SetFlag(StateFlags::V, false);
 
-#if CPU_TEST
-		std::cout << "Clear Overflow Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 	/// END ///
@@ -456,15 +238,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::C, ((temp & 0x00FF) >= 0) && (!(temp & 0xFF00)));
 		SetFlag(StateFlags::N, temp & 0xFF00); // result bit 7
 
-#if CPU_TEST
-		std::cout << "Compare A [CMP]: " << "\n";
-		std::cout << "Value: " << hexString(temp, 2) << "\n";
-		std::cout << "Equal: " << GetFlag(StateFlags::Z) << "\n";
-		std::cout << "Greater Than: " << GetFlag(StateFlags::C) << "\n";
-		std::cout << "Negative : " << GetFlag(StateFlags::N) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -475,15 +248,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::C, ((temp & 0x00FF) >= 0) && (!(temp & 0xFF00)));
 		SetFlag(StateFlags::N, temp & 0xFF00); // result bit 7
 
-#if CPU_TEST
-		std::cout << "Compare X [CPX]: " << "\n";
-		std::cout << "Value: " << hexString(temp, 2) << "\n";
-		std::cout << "Equal: " << GetFlag(StateFlags::Z) << "\n";
-		std::cout << "Greater Than: " << GetFlag(StateFlags::C) << "\n";
-		std::cout << "Negative : " << GetFlag(StateFlags::N) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -494,15 +258,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::C, ((temp & 0x00FF) >= 0) && (!(temp & 0xFF00)));
 		SetFlag(StateFlags::N, temp & 0xFF00); // result bit 7
 
-#if CPU_TEST
-		std::cout << "Compare Y [CPY]: " << "\n";
-		std::cout << "Value: " << hexString(temp, 2) << "\n";
-		std::cout << "Equal: " << GetFlag(StateFlags::Z) << "\n";
-		std::cout << "Greater Than: " << GetFlag(StateFlags::C) << "\n";
-		std::cout << "Negative : " << GetFlag(StateFlags::N) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 	/// END ///
@@ -512,21 +267,16 @@ namespace NES::CPU {
 	// Decrement Memory
 	u8 R6502::DEC() { // memory = memory - 1 | Read-Modify-Write Instruction
 		_data = read_memory(_address_abs); // Read
+		_bus->next_cpu_cycle();
 		write_memory(_address_abs); // Additional -> writes the original value
 		
 		--_data; // Modify
+		_bus->next_cpu_cycle();
 		write_memory(_address_abs); // Write
 
 		SetFlag(StateFlags::Z, _data == 0);
 		SetFlag(StateFlags::N, _data >> 7);
 
-#if CPU_TEST
-		std::cout << "Decrement Memory Value: " << _data + 1 << " " << hexString(_data + 1, 2) << " in Memory: " << hexString(_address_abs, 4) << "\n";
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -536,13 +286,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _x_register == 0);
 		SetFlag(StateFlags::N, _x_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Decrement X Register: " << "\n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	} 
 
@@ -552,13 +295,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _y_register == 0);
 		SetFlag(StateFlags::N, _y_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Decrement Y Register: " << "\n";
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 	/// END ///
@@ -566,25 +302,12 @@ namespace NES::CPU {
 	// Bitwise Exclusive OR
 	u8 R6502::EOR() { // A = A ^ memory
 
-#if CPU_TEST
-		std::cout << "Bitwise Exclusive OR: \n";
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		_data = read_memory(_address_abs);
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
+		_data = read_memory(_address_abs); // Latched in both builds, the flags below are derived from it
 		_accumulator ^= _data;
-#else
-		_accumulator ^= read_memory(_address_abs);
-#endif
 
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::N, _accumulator >> 7);
 
-#if CPU_TEST
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -593,21 +316,16 @@ namespace NES::CPU {
 	// Increment Memory
 	u8 R6502::INC() { // memory = memory + 1 | Read-Modify-Write Instruction
 		_data = read_memory(_address_abs); // Read
+		_bus->next_cpu_cycle();
 		write_memory(_address_abs); // Additional -> writes the original value
 
 		++_data; // Modify
+		_bus->next_cpu_cycle();
 		write_memory(_address_abs); // Write
 
 		SetFlag(StateFlags::Z, _data == 0);
 		SetFlag(StateFlags::N, _data >> 7);
 
-#if CPU_TEST
-		std::cout << "Increment Memory Value: " << hexString(_data - 1, 2) << " in Memory: " << hexString(_address_abs, 4) << "\n";
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -617,13 +335,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _x_register == 0);
 		SetFlag(StateFlags::N, _x_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Increment X Register: " << "\n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -633,13 +344,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _y_register == 0);
 		SetFlag(StateFlags::N, _y_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Increment Y Register: " << "\n";
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 	/// END ///
@@ -648,9 +352,6 @@ namespace NES::CPU {
 	u8 R6502::JMP() {
 		_program_counter = _address_abs; // jump
 
-#if CPU_TEST
-		std::cout << "Jump To: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-#endif // CPU_TEST
 		return 0;
 	}
 
@@ -666,11 +367,6 @@ namespace NES::CPU {
 
 		_program_counter = _address_abs; // jump
 
-#if CPU_TEST
-		std::cout << "Jump To Subroutine At: " << _program_counter << " " << hexString(_program_counter, 4) << "\n\n";
-
-		DisassembleRAM(0x01B0, 0x0200);
-#endif // CPU_TEST
 		return 0;
 	}
 
@@ -683,12 +379,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::N, _accumulator >> 7);
 
-#if CPU_TEST
-		std::cout << "Accumulator: " << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z),1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N),1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -698,12 +388,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _x_register == 0);
 		SetFlag(StateFlags::N, _x_register >> 7);
 
-#if CPU_TEST
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -713,41 +397,23 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _y_register == 0);
 		SetFlag(StateFlags::N, _y_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 	/// END ///
 
 	// Logical Shift Right
 	u8 R6502::LSR() { // value = value >> 1 or 0 -> [76543210] -> C
-		_data = (this->*read)(_address_abs, false); // Read
-		(this->*write)(_address_abs); // Additional -> writes the original value
-
-#if CPU_TEST
-		std::cout << "Logical Shift Right: " << "\n";
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-#endif
+		_data = read_operand(); // Read
+		write_operand(); // Additional -> writes the original value
 
 		SetFlag(StateFlags::C, _data & 0x01);
 		_data >>= 1; // Modify
 		//_data &= 0x7F;
-		(this->*write)(_address_abs); // Write
+		write_operand(); // Write
 
 		SetFlag(StateFlags::Z, _data == 0);
 		SetFlag(StateFlags::N, _data >> 7);
 
-#if CPU_TEST
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -757,35 +423,18 @@ namespace NES::CPU {
 		// This instruction can be useful when writing timed code to delay for a desired amount of time, 
 		// as padding to ensure something does or does not cross a page, or to disable code in a binary.
 
-#if CPU_TEST
-		std::cout << "NO OPERATION! " << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
 	// Bitwise OR
 	u8 R6502::ORA() { // A = A | memory
 
-#if CPU_TEST
-		std::cout << "Bitwise OR: \n";
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		_data = read_memory(_address_abs);
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
+		_data = read_memory(_address_abs); // Latched in both builds, the flags below are derived from it
 		_accumulator |= _data;
-#else
-		_accumulator |= read_memory(_address_abs);
-#endif
 
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::Z, _data >> 7);
 
-#if CPU_TEST
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -797,16 +446,6 @@ namespace NES::CPU {
 		write_memory(0x0100 + _stack_pointer);
 		--_stack_pointer; // Decrement Stack
 
-#if CPU_TEST
-		std::cout << "Push Accumulator [PHA]: " << "\n";
-		std::cout << "Stack Pointer Before PHA: " << hexString(_stack_pointer + 1, 2) << "\n";
-		std::cout << "Accumulator: " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Stack Pointer After PHA: " << hexString(_stack_pointer, 2) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-
-		DisassembleRAM(0x01B0, 0x0200);
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -816,16 +455,6 @@ namespace NES::CPU {
 		write_memory(0x0100 + _stack_pointer);
 		--_stack_pointer; // Decrement Stack
 
-#if CPU_TEST
-		std::cout << "Push Processor Status [PHP]: " << "\n";
-		std::cout << "Stack Pointer Before PHP: " << hexString(_stack_pointer + 1, 2) << "\n";
-		std::cout << "Status Register before Push: " << binString(_status_register, 8) << "\n";
-		_status_register = 0x00; // Extreme, but for testing
-		std::cout << "Stack Pointer After PHP: " << hexString(_stack_pointer, 2) << "\n\n";
-
-		DisassembleRAM(0x01B0, 0x0200);
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -837,44 +466,21 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::N, _accumulator & 0x80);
 
-#if CPU_TEST
-		std::cout << "Pull Accumulator [PLA]: " << "\n";
-		std::cout << "Stack Pointer Before PLA: " << hexString(_stack_pointer - 1, 2) << "\n";
-		std::cout << "Accumulator: " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Stack Pointer After PLA: " << hexString(_stack_pointer, 2) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-
-		DisassembleRAM(0x01B0, 0x0200);
-#endif // CPU_TEST
-
 		return 0;
 	}
 
 	// Pull Processor Status
 	u8 R6502::PLP() { // SP = SP + 1 | NVxxDIZC = ($0100 + SP)
 
-#if CPU_TEST
-		std::cout << "Status Register before Pull: " << binString(_status_register, 8) << "\n";
-#endif
-
 		++_stack_pointer;
 		_data = read_memory(0x0100 + _stack_pointer) & 0xCF;
 		_data |= StateFlags::U;
 
 		_delay_change_value = (_data & StateFlags::I) >> 2;
 		_data &= ~StateFlags::I;
-		delay_assign = &R6502::assign_delay_interrupt_disable_change; // The effect of changing Interrupt Disable [I] flag is delayed 1 instruction, because the flag is changed after IRQ is polled, delaying the effect until IRQ is polled in the next instruction like with CLI and SEI.
+		_delay_assign = true; // The effect of changing Interrupt Disable [I] flag is delayed 1 instruction, because the flag is changed after IRQ is polled, delaying the effect until IRQ is polled in the next instruction like with CLI and SEI.
 		
-		_status_register |= _data; clock();
-
-#if CPU_TEST
-		std::cout << "Pull Processor Status [PLP]: " << "\n";
-		std::cout << "Stack Pointer Before PLP: " << hexString(_stack_pointer - 1, 2) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n";
-		std::cout << "Stack Pointer After PLP: " << hexString(_stack_pointer, 2) << "\n\n";
-
-		DisassembleRAM(0x01B0, 0x0200);
-#endif // CPU_TEST
+		_status_register |= _data;
 
 		return 0;
 	}
@@ -882,64 +488,38 @@ namespace NES::CPU {
 
 	// Rotate Left
 	u8 R6502::ROL() {
-		_data = (this->*read)(_address_abs, false); // Read
-		(this->*write)(_address_abs); // Additional -> writes the original value
-
-#if CPU_TEST
-		std::cout << "Rotate Left: " << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-#endif
+		_data = read_operand(); // Read
+		write_operand(); // Additional -> writes the original value
 
 		u8 temp = GetFlag(StateFlags::C);
 		SetFlag(StateFlags::C, _data & 0x80);
 		_data <<= 1; // Modify
 		_data &= 0xFE;
 		_data |= temp;
-		(this->*write)(_address_abs); // Write
+		write_operand(); // Write
 
 		SetFlag(StateFlags::Z, _data == 0);
 		SetFlag(StateFlags::N, _data >> 7);
 
-#if CPU_TEST
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
 	// Rotate Right
 	u8 R6502::ROR() {
-		_data = (this->*read)(_address_abs, false); // Read
-		(this->*write)(_address_abs); // Additional -> writes the original value
-
-#if CPU_TEST
-		std::cout << "Rotate Right: " << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-#endif
+		_data = read_operand(); // Read
+		write_operand(); // Additional -> writes the original value
 
 		u8 temp = GetFlag(StateFlags::C) << 7;
 		SetFlag(StateFlags::C, _data & 0x01);
 		_data >>= 1; // Modify
 		_data &= 0x7F;
 		_data |= temp;
-		(this->*write)(_address_abs); // Write
+		write_operand(); // Write
 		temp = GetFlag(StateFlags::C);
 
 		SetFlag(StateFlags::Z, _data == 0);
 		SetFlag(StateFlags::N, _data >> 7);
 
-#if CPU_TEST
-		std::cout << _data << " " << hexString(_data, 2) << "\n";
-		std::cout << "Carry Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -957,14 +537,6 @@ namespace NES::CPU {
 		++_stack_pointer;
 		_program_counter |= (u16)read_memory(0x0100 + _stack_pointer) << 8; // Address - High
 
-#if CPU_TEST
-		std::cout << "Return From Interrupt [RTI]: " << "\n";
-		std::cout << "Stack Pointer Before RTI: " << hexString(_stack_pointer + 3, 2) << "\n";
-		std::cout << "Program Counter: " << hexString(_program_counter, 4) << "\n";
-		std::cout << "Stack Pointer After RTI: " << hexString(_stack_pointer, 2) << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -977,11 +549,6 @@ namespace NES::CPU {
 
 		// ++_program_counter; it happens during JSR, due to the way i've programmed the increment of PC
 
-#if CPU_TEST
-		std::cout << "Return From Subroutine [RTS]: " << "\n";
-		std::cout << "Program Counter: " << hexString(_program_counter, 4) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -989,16 +556,7 @@ namespace NES::CPU {
 	// 0 -> Borrow
 	// 1 -> No Borrow
 	u8 R6502::SBC() { // A = A - memory - ~C or A = A + ~memory + C
-#if CPU_TEST
-		u16 value = (u16)read_memory(_address_abs); // NOT/Invert
-		std::cout << "Subtract with Carry: \n";
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << value << " " << hexString(value, 2) << "\n";
-
-		value ^= 0x00FF; // Invert
-#else
 		u16 value = ((u16)read_memory(_address_abs)) ^ 0x00FF; // NOT/Invert
-#endif		
 		u16 temp = _accumulator + value + GetFlag(StateFlags::C);
 
 		// Handle Overflow
@@ -1009,15 +567,7 @@ namespace NES::CPU {
 
 		_accumulator = temp & 0x00FF;
 
-#if CPU_TEST
-		std::cout << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "Borrow (Carry) Flag: " << hexString(GetFlag(StateFlags::C), 1) << "\n";
-		std::cout << "Zero Flag: " << hexString(GetFlag(StateFlags::Z), 1) << "\n";
-		std::cout << "Overflow Flag: " << hexString(GetFlag(StateFlags::V), 1) << "\n";
-		std::cout << "Negative Flag: " << hexString(GetFlag(StateFlags::N), 1) << "\n\n";
-#endif // CPU_TEST
-
-		return 1;
+		return 0;
 	}
 
 	/// Set STATUS FLAGS ///
@@ -1026,11 +576,6 @@ namespace NES::CPU {
 	u8 R6502::SEC() { // C = 1
 		SetFlag(StateFlags::C, true);
 
-#if CPU_TEST
-		std::cout << "Set Carry Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1038,23 +583,13 @@ namespace NES::CPU {
 	u8 R6502::SED() { // D = 1
 		SetFlag(StateFlags::D, true);
 
-#if CPU_TEST
-		std::cout << "Set Decimal Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
 	// Set Interrupt Disable
 	u8 R6502::SEI() { // I = 1
 		_delay_change_value = 1;
-		delay_assign = &R6502::assign_delay_interrupt_disable_change; // The effect of changing Interrupt Disable [I] flag is delayed 1 instruction, because the flag is changed after IRQ is polled, delaying the effect until IRQ is polled in the next instruction like with CLI and SEI.
-
-#if CPU_TEST
-		std::cout << "Set Interrupt Disable Status: " << "\n";
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
-#endif // CPU_TEST
+		_delay_assign = true; // The effect of changing Interrupt Disable [I] flag is delayed 1 instruction, because the flag is changed after IRQ is polled, delaying the effect until IRQ is polled in the next instruction like with CLI and SEI.
 
 		return 0;
 	}
@@ -1067,10 +602,6 @@ namespace NES::CPU {
 		_data = _accumulator;
 		write_memory(_address_abs);
 
-#if CPU_TEST
-		std::cout << "Storing Accumulator value: " << _accumulator << " " << hexString(_accumulator, 2) << " in: " << hexString(_address_abs, 4) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1079,10 +610,6 @@ namespace NES::CPU {
 		_data = _x_register;
 		write_memory(_address_abs);
 
-#if CPU_TEST
-		std::cout << "Storing X Register value: " << _x_register << " " << hexString(_x_register, 2) << " in: " << hexString(_address_abs, 4) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1091,10 +618,6 @@ namespace NES::CPU {
 		_data = _y_register;
 		write_memory(_address_abs);
 
-#if CPU_TEST
-		std::cout << "Storing Y Register value: " << _y_register << " " << hexString(_y_register, 2) << " in: " << hexString(_address_abs, 4) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1106,13 +629,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _x_register == 0);
 		SetFlag(StateFlags::N, _x_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Copy Accumulator to X Register: \n";
-		std::cout << "Accumulator: " << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1122,13 +638,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _y_register == 0);
 		SetFlag(StateFlags::N, _y_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Copy Accumulator to Y Register: \n";
-		std::cout << "Accumulator: " << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1138,12 +647,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _x_register == 0);
 		SetFlag(StateFlags::N, _x_register >> 7);
 
-#if CPU_TEST
-		std::cout << "Copy Stack Pointer to X Register: \n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Stack Pointer: " << _stack_pointer << " " << hexString(_stack_pointer, 2) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1153,13 +656,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::N, _accumulator >> 7);
 
-#if CPU_TEST
-		std::cout << "Copy X Register to Accumulator: \n";
-		std::cout << "Accumulator: " << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1167,12 +663,6 @@ namespace NES::CPU {
 	u8 R6502::TXS() { // SP = X | copies the X register value to the stack pointer.
 		_stack_pointer = _x_register;
 
-#if CPU_TEST
-		std::cout << "Copy X Register to Stack Pointer: \n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Stack Pointer: " << _stack_pointer << " " << hexString(_stack_pointer, 2) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 
@@ -1182,13 +672,6 @@ namespace NES::CPU {
 		SetFlag(StateFlags::Z, _accumulator == 0);
 		SetFlag(StateFlags::N, _accumulator >> 7);
 
-#if CPU_TEST
-		std::cout << "Copy Y Register to Accumulator: \n";
-		std::cout << "Accumulator: " << _accumulator << " " << hexString(_accumulator, 2) << "\n";
-		std::cout << "X Register: " << _x_register << " " << hexString(_x_register, 2) << "\n";
-		std::cout << "Y Register: " << _y_register << " " << hexString(_y_register, 2) << "\n\n";
-#endif // CPU_TEST
-
 		return 0;
 	}
 	/// END ///
@@ -1196,9 +679,68 @@ namespace NES::CPU {
 	// Illegal Opcodes
 	u8 R6502::XXX() { return 0; }
 
-#if CPU_TEST
-	void R6502::debug_status_register() {
-		std::cout << "Status Register: " << binString(_status_register, 8) << "\n\n";
+	// Builds the member-function-pointer lookup from the shared opcode table
+	std::array<R6502::Instruction, 256> R6502::build_lookup() {
+		constexpr std::array<u8(R6502::*)(void), static_cast<u8>(Operation::count)> operations{
+			&R6502::ADC, &R6502::AND, &R6502::ASL, &R6502::BCC, &R6502::BCS, &R6502::BEQ, &R6502::BIT, &R6502::BMI, &R6502::BNE, &R6502::BPL, &R6502::BRK, &R6502::BVC, &R6502::BVS, &R6502::CLC,
+			&R6502::CLD, &R6502::CLI, &R6502::CLV, &R6502::CMP, &R6502::CPX, &R6502::CPY, &R6502::DEC, &R6502::DEX, &R6502::DEY, &R6502::EOR, &R6502::INC, &R6502::INX, &R6502::INY, &R6502::JMP,
+			&R6502::JSR, &R6502::LDA, &R6502::LDX, &R6502::LDY, &R6502::LSR, &R6502::NOP, &R6502::ORA, &R6502::PHA, &R6502::PHP, &R6502::PLA, &R6502::PLP, &R6502::ROL, &R6502::ROR, &R6502::RTI,
+			&R6502::RTS, &R6502::SBC, &R6502::SEC, &R6502::SED, &R6502::SEI, &R6502::STA, &R6502::STX, &R6502::STY, &R6502::TAX, &R6502::TAY, &R6502::TSX, &R6502::TXA, &R6502::TXS, &R6502::TYA,
+			&R6502::XXX,
+		};
+
+		constexpr std::array<u8(R6502::*)(void), static_cast<u8>(AddressMode::count)> address_modes{
+			&R6502::IMP, &R6502::IMM, &R6502::ZP0, &R6502::ZPX, &R6502::ZPY, &R6502::REL,
+			&R6502::ABS, &R6502::ABX, &R6502::ABY, &R6502::IND, &R6502::IZX, &R6502::IZY,
+		};
+
+		std::array<Instruction, 256> lookup{};
+		for (u32 i{ 0 }; i < lookup.size(); ++i) {
+			lookup[i].opcode = operations[static_cast<u8>(opcode_table[i].operation)];
+			lookup[i].addrmode = address_modes[static_cast<u8>(opcode_table[i].mode)];
+			lookup[i].cycles = opcode_table[i].cycles;
+		}
+		return lookup;
+	}
+
+	const std::array<R6502::Instruction, 256> R6502::_lookup{ R6502::build_lookup() };
+
+	void R6502::save_state(State& state) const {
+		state.total_cycles = _total_cycles;
+		state.program_counter = _program_counter;
+		state.cycles = _cycles;
+		state.address_abs = _address_abs;
+		state.address_rel = _address_rel;
+		state.accumulator = _accumulator;
+		state.x_register = _x_register;
+		state.y_register = _y_register;
+		state.stack_pointer = _stack_pointer;
+		state.status_register = _status_register;
+		state.opcode = _opcode;
+		state.data = _data;
+		state.delay_change_value = _delay_change_value;
+		state.accumulator_operand = _accumulator_operand;
+		state.delay_assign = _delay_assign;
+		state.delay_change = _delay_change;
+	}
+
+	void R6502::load_state(const State& state) {
+		_total_cycles = state.total_cycles;
+		_program_counter = state.program_counter;
+		_cycles = state.cycles;
+		_address_abs = state.address_abs;
+		_address_rel = state.address_rel;
+		_accumulator = state.accumulator;
+		_x_register = state.x_register;
+		_y_register = state.y_register;
+		_stack_pointer = state.stack_pointer;
+		_status_register = state.status_register;
+		_opcode = state.opcode;
+		_data = state.data;
+		_delay_change_value = state.delay_change_value;
+		_accumulator_operand = state.accumulator_operand;
+		_delay_assign = state.delay_assign;
+		_delay_change = state.delay_change;
 	}
-#endif
+
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <unordered_map>
+
 #include "../Common/CommonHeaders.h"
 #include "Bus.h"
+#include "Dynarec.h"
+#include "OpcodeTable.h"
+#include "Trace.h"
 
 // WARNING: If the opcodes and addressing modes are not implemented, then linker will throw a LINK2019 code while assigning their function pointer to lookup.
 
@@ -39,99 +44,79 @@ namespace NES::CPU {
 		// REL -> $0000 [Relative to Program-Counter]
 
 		u8 IMP() { // Implicit/Implied | Instructions like RTS or CLC have no address operand, the destination of results are implied. | Accumulator Address Mode
-			assert (_cycles > 0);
-			read = &R6502::read_accumulator;
-			write = &R6502::write_accumulator;
+			_accumulator_operand = true;
 			return 0;
 		}
 
 		u8 IMM() { // Immediate | Uses the 8-bit operand itself as the value for the operation, rather than fetching a value from another memory address. [operand itself is in a Memory Location]
-			assert(_cycles > 0);
 			_address_abs = _program_counter++; // Reading costs 1 cycle
 			return 0;
 		}
 
 		u8 ZP0() { // Zero-Page | Fetches the value from an 8-bit address on the zero page.
-			assert(_cycles > 0);
 			_address_abs = (read_memory(_program_counter++)) & 0x00FF; // Reading costs 1 cycle
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_accumulator_operand = false;
 			return 0;
 		}
 
 		u8 ZPX() { // Zero-Page Indexed X-Offset | Uses value stored in X-register to index in Zero Page
-			assert(_cycles > 0);
 			_address_abs = (read_memory(_program_counter++)) & 0x00FF; // Reading costs 1 cycle
-			_address_abs += _x_register; clock(); // Reading from X register cost 1 cycle
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_address_abs = (_address_abs + _x_register) & 0x00FF; // Reading from X register cost 1 cycle | Wraps around within the Zero Page
+			_accumulator_operand = false;
 			return 0;
 		}
 
 		u8 ZPY() { // Zero-Page Indexed Y-Offset | Uses value stored in Y-register to index in Zero Page
-			assert(_cycles > 0);
 			_address_abs = (read_memory(_program_counter++)) & 0x00FF; // Reading costs 1 cycle
-			_address_abs += _y_register; clock(); // Reading from Y register cost 1 cycle
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_address_abs = (_address_abs + _y_register) & 0x00FF; // Reading from Y register cost 1 cycle | Wraps around within the Zero Page
+			_accumulator_operand = false;
 			return 0;
 		}
 
 		u8 REL() { // Relative | For Branching Instructions -> can't jump to anywhere in the address range; They can only jump thats in the vicinity of the branch instruction, no more than 127 memory locations
-			assert(_cycles > 0);
 			_address_rel = read_memory(_program_counter++);
 			// NOTE: if sign bit of the unsigned address is 1, then we set all high bits to 1. -> reason, to use binary arithmetic.
 			if (_address_rel & 0x80) _address_rel |= 0xFF00;
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_accumulator_operand = false;
 
 			return 0;
 		}
 
 		u8 ABS() { // Absolute | Fetches a 2-byte address from the program counter
-			assert(_cycles > 0);
 			u16 l_address = read_memory(_program_counter++);// Reading costs 1 cycle
 			u16 h_address = read_memory(_program_counter++);// Reading costs 1 cycle
 			_address_abs = (h_address << 8) | l_address; // h_address shifted 8 bits to the left and OR'ed with l_address
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_accumulator_operand = false;
 			return 0;
 		}
 
 		u8 ABX() { // Absolute Indexed X-Offset | Uses value stored in X-register to offset the absolute address
-			assert(_cycles > 0);
 			u16 l_address = read_memory(_program_counter++); // Reading costs 1 cycle
 			u16 h_address = read_memory(_program_counter++); // Reading costs 1 cycle
 			_address_abs = (h_address << 8) | l_address; // h_address shifted 8 bits to the left and OR'ed with l_address
-			_address_abs += _x_register; clock(); // Reading from X register cost 1 cycle
+			_address_abs += _x_register; // Reading from X register cost 1 cycle
+			_accumulator_operand = false;
 
 			if (h_address != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 1;
+				return 1; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
 			return 0;
 		}
 
 		u8 ABY() { // Absolute Indexed Y-Offset | Uses value stored in Y-register to offset the absolute address
-			assert(_cycles > 0);
 			u16 l_address = read_memory(_program_counter++); // Reading costs 1 cycle
 			u16 h_address = read_memory(_program_counter++); // Reading costs 1 cycle
 			_address_abs = (h_address << 8) | l_address; // h_address shifted 8 bits to the left and OR'ed with l_address
-			_address_abs += _y_register; clock(); // Reading from Y register cost 1 cycle
+			_address_abs += _y_register; // Reading from Y register cost 1 cycle
+			_accumulator_operand = false;
 
 			if (h_address != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 1;
+				return 1; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
 			return 0;
 		}
 
 		u8 IND() { // Indirect | R6502's way of implementing pointers in the NES
-			assert(_cycles > 0);
 			u16 l_address_i = read_memory(_program_counter++); // Reading costs 1 cycle
 			u16 h_address_i = read_memory(_program_counter++); // Reading costs 1 cycle
 			u16 address_i = (h_address_i << 8) | l_address_i; // h_address shifted 8 bits to the left and OR'ed with l_address
@@ -141,41 +126,32 @@ namespace NES::CPU {
 			} else {
 				_address_abs = (read_memory(address_i + 1) << 8) | read_memory(address_i); // Reading costs 2 cycle
 			}
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_accumulator_operand = false;
 			return 0;
 		}
 
 		u8 IZX() { // Indirect Indexed X-Offset | Question: WHY????
-			assert(_cycles > 0);
 			u16 t_i = read_memory(_program_counter++); // Reading costs 1 cycle
-			u16 l_address_i = read_memory((u16)(t_i + (u16)_x_register) * 0x00FF); // Reading costs 1 cycle
-			u16 h_address_i = read_memory((u16)(t_i + (u16)_x_register + 1) * 0x00FF); // Reading costs 1 cycle
+			u16 l_address_i = read_memory((u16)(t_i + (u16)_x_register) & 0x00FF); // Reading costs 1 cycle | Pointer wraps around within the Zero Page
+			u16 h_address_i = read_memory((u16)(t_i + (u16)_x_register + 1) & 0x00FF); // Reading costs 1 cycle
 			_address_abs = (h_address_i << 8) | l_address_i;
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
+			_accumulator_operand = false;
 
 			return 0;
 		}
 
 		u8 IZY() { // Indirect	Indexed Y-Offset | Uses value stored in Y-register to offset the indirect address/ Pointer
-			assert(_cycles > 0);
 			u16 t_i = read_memory(_program_counter++); // Reading costs 1 cycle
 
 			u16 l_address_i = read_memory(t_i & 0x00FF); // Reading costs 1 cycle
 			u16 h_address_i = read_memory((t_i + 1) & 0x00FF); // Reading costs 1 cycle
-			u16 _address_abs = (h_address_i << 8) | l_address_i; // h_address shifted 8 bits to the left and OR'ed with l_address
-			_address_abs += _y_register; clock(); // Reading from Y register cost 1 cycle
-			_data = read_memory(_address_abs); // Reading costs 1 cycle
+			_address_abs = (h_address_i << 8) | l_address_i; // h_address shifted 8 bits to the left and OR'ed with l_address
+			_address_abs += _y_register; // Reading from Y register cost 1 cycle
+			_accumulator_operand = false;
 
-			// TODO: fix this page wrap code
 			if (h_address_i != (_address_abs >> 8)) { // if the memory Page has changed, then 
-				clock(); // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
-				return 1;
+				return 1; // Memory Page Change/Page Wrap Cost 1 cycle [OOPS Cycle]
 			}
-			read = &R6502::read_memory;
-			write = &R6502::write_memory;
-
 			return 0;
 		}
 
@@ -244,24 +220,132 @@ namespace NES::CPU {
 		R6502() { }
 		~R6502() { delete _bus; }
 
-		// External Signals
-		void clock() { // Per Clock Signal
-			if (_cycles == 0) {
-				assert(_cycles == 0);
-				++_cycles; // Since, whenever i read, i use one cpu cycle in the read function
-				_opcode = read_memory(_program_counter++);
+		// Executes one whole instruction | Returns the cycles it took, the master cycle counter advances by the same amount
+		// DMA cycles stolen from the CPU [DMC sample fetches] are charged to the instruction that was running when the Bus saw them.
+		// The sink sees every executed instruction [Trace.h], interrupt entries are not instructions and are not traced.
+		template<TraceSink Sink = NullTrace>
+		u16 step(Sink&& sink = {}) {
+			_bus->set_cpu_cycle(_total_cycles); // Interrupt polls see the start of this instruction, its data access moves it on [access_offset]
+			_bus->poll_dma();
+
+			if (_bus->nmi_asserted()) { // Interrupt lines are sampled between instructions | NMI wins over IRQ
+				nmi();
+				return 8;
+			}
+			if (GetFlag(StateFlags::I) == 0 && _bus->irq_asserted()) {
+				irq();
+				return 7;
+			}
+
+			[[maybe_unused]] TraceRecord record;
+			if constexpr (trace_enabled<Sink>) record = trace_begin();
+
+#if CPU_INSTRUCTION_CACHE
+			u8 cycles;
+			if (const DecodedInstruction* instruction = decoded(_program_counter)) {
+				_opcode = instruction->opcode;
+				_program_counter += instruction->length;
+				cycles = instruction->cycles; // Before the handler, which may write over its own bytes and clear the entry
+				cycles += instruction->handler(*this, instruction->operand);
+			} else { // Handler pages [PRG-RAM, open bus] or an instruction running into the next page
+				_opcode = bus_read(_program_counter++);
+				cycles = execute(_opcode);
+			}
+#elif CPU_SWITCH_CORE
+			_opcode = bus_read(_program_counter++);
+			u8 cycles = execute(_opcode);
+#else
+			_opcode = read_memory(_program_counter++);
+
+			const Instruction& instruction = _lookup[_opcode];
+			u8 page_crossed = (this->*instruction.addrmode)();
+			const bool penalty = has_page_cross_penalty(opcode_table[_opcode].operation);
+			_bus->set_cpu_cycle(_total_cycles + access_offset(opcode_table[_opcode]) + (penalty ? page_crossed : 0));
+			u8 cycles = instruction.cycles + (this->*instruction.opcode)();
+
+			if (penalty) {
+				cycles += page_crossed; // [OOPS Cycle]
+			}
+#endif // CPU_SWITCH_CORE
 
-				_cycles = _lookup[_opcode >> 4][_opcode & 0x0F].cycles;
-				_cycles += (this->*_lookup[_opcode >> 4][_opcode & 0x0F].addrmode)();
-				_cycles += (this->*_lookup[_opcode >> 4][_opcode & 0x0F].opcode)();
+			update_interrupt_disable();
+			const u16 stall = static_cast<u16>(_bus->take_stall_cycles(_total_cycles + cycles));
+			_total_cycles += cycles + stall;
 
-				(this->*delay_change)();
-				(this->*delay_assign)(); // fbrereto -> https://stackoverflow.com/questions/2898316/using-a-member-function-pointer-within-a-class
+			if constexpr (trace_enabled<Sink>) {
+				record.address = _address_abs;
+				record.cycles = static_cast<u16>(cycles + stall);
+				sink(record);
+			}
 
 #if CPU_TEST
-				--_instructions_count;
+			--_instructions_count;
 #endif // CPU_TEST
 
+			return cycles + stall;
+		}
+
+		// Cycle-Budgeted Execution | Whole instructions run against the master cycle counter, other devices catch up once per call.
+		// Returns the exact number of cycles consumed, which can overshoot the target by the tail of the last instruction.
+		template<TraceSink Sink = NullTrace>
+		u64 run_until(u64 target_cycle, Sink&& sink = {}) {
+			const u64 start_cycle = _total_cycles;
+			_cycles = 0; // Pending clock() cycles are already counted by the master cycle counter
+
+			while (_total_cycles < target_cycle) {
+#if CPU_DYNAREC
+				if constexpr (!trace_enabled<Sink>) { // A trace needs every instruction on its own
+					if (_dynarec) {
+						if (run_native(target_cycle)) continue;
+						++_dynarec->counters().interpreted_instructions;
+					}
+				}
+#endif // CPU_DYNAREC
+#if CPU_INSTRUCTION_CACHE
+				if constexpr (!trace_enabled<Sink>) {
+					if (run_block(target_cycle)) continue;
+				}
+#endif // CPU_INSTRUCTION_CACHE
+				step(sink);
+			}
+
+			_bus->set_cpu_cycle(_total_cycles);
+			_bus->catch_up();
+			return _total_cycles - start_cycle;
+		}
+
+		template<TraceSink Sink = NullTrace>
+		u64 run_cycles(u64 cycles, Sink&& sink = {}) { return run_until(_total_cycles + cycles, sink); }
+
+		[[nodiscard]] u64 get_cycle() const { return _total_cycles; } // Master cycle counter -> CPU cycles since reset
+
+		// Snapshot | Everything the CPU carries from one instruction to the next, as plain data [System::SaveState]
+		struct State {
+			u64		total_cycles;
+			u16		program_counter;
+			u16		cycles; // Left for clock()
+			u16		address_abs;
+			u16		address_rel;
+			u8		accumulator;
+			u8		x_register;
+			u8		y_register;
+			u8		stack_pointer;
+			u8		status_register;
+			u8		opcode;
+			u8		data;
+			u8		delay_change_value;
+			bool	accumulator_operand;
+			bool	delay_assign;
+			bool	delay_change;
+		};
+		void save_state(State& state) const;
+		void load_state(const State& state);
+
+		// External Signals
+		template<TraceSink Sink = NullTrace>
+		void clock(Sink&& sink = {}) { // Per Clock Signal
+			if (_cycles == 0) {
+				_cycles = step(sink) - 1; // This clock signal is the first cycle of the instruction
 			} else {
 			// wait for set time
 			--_cycles;
@@ -295,8 +379,10 @@ namespace NES::CPU {
 
 #if CPU_TEST
 			_cycles = 0;
+			_total_cycles = 0;
 #else
 			_cycles = 8; // Since it takes time...
+			_total_cycles = 8;
 #endif // CPU_TEST
 
 			clock();
@@ -316,6 +402,7 @@ namespace NES::CPU {
 				interrupt();
 
 				_cycles = 7; // These take time...
+				_total_cycles += 7;
 			}
 		}
 
@@ -327,11 +414,27 @@ namespace NES::CPU {
 			interrupt();
 
 			_cycles = 8; // These take time...
+			_total_cycles += 8;
 		}
 		/// END INTERRUPTS ///
 
 		Bus* CreateBus() { return new CPU::Bus(); }
-		void SetBus(Bus* bus) { _bus = bus; }
+		void SetBus(Bus* bus) {
+			_bus = bus;
+#if CPU_INSTRUCTION_CACHE
+			_bus->set_code_listener([this](u16 first, u16 last) { code_remapped(first, last); }, [this](u16 first, u16 last) { code_ram_written(first, last); });
+#endif // CPU_INSTRUCTION_CACHE
+#if CPU_DYNAREC
+			set_dynarec(_dynarec_mode);
+#endif // CPU_DYNAREC
+		}
+
+#if CPU_DYNAREC
+		// Dynamic Recompiler [Dynarec.h] | On unless switched off, Verify checks every translated block against the interpreter
+		void set_dynarec(Dynarec::Mode mode);
+		[[nodiscard]] Dynarec::Mode get_dynarec() const { return _dynarec_mode; }
+		[[nodiscard]] const Dynarec::Counters* dynarec_counters() const { return _dynarec ? &_dynarec->counters() : nullptr; }
+#endif // CPU_DYNAREC
 		void AddInstruction(u8 opcode, u8 value){}
 		[[nodiscard]] constexpr Bus* GetBus() { return _bus; }
 
@@ -359,17 +462,17 @@ namespace NES::CPU {
 		u16		_program_counter{ 0x0000 }; // Stores the Address of the next program byte -> Supposed to be an array
 
 		u8		_opcode{ 0x00 };
-		u8		_cycles{ 0 };
+		u16		_cycles{ 0 }; // Cycles left before clock() fetches the next instruction
+		u64		_total_cycles{ 0 }; // Master cycle counter
 		u8		_data{ 0x00 };
 		u8		_ticks{ 0 };
 
 		u16		_address_abs{ 0x0000 }; // Absolute Address
 		u16		_address_rel{ 0x00 }; // Relative Address
 
-		void	(R6502::*write)(u16) {}; // Write Function Pointer
-		u8		(R6502::* read)(u16, bool) {}; // Write Function Pointer
-		void	(R6502::*delay_assign)() = &R6502::do_nothing_like_its_nobodys_business; // Delay Interrupt Disable Change Function Pointer
-		void	(R6502::*delay_change)() = &R6502::do_nothing_like_its_nobodys_business; // Delay Interrupt Disable Change Function Pointer
+		bool	_accumulator_operand{ false }; // Set by the addressing mode -> read/modify/write instructions work on A instead of memory
+		bool	_delay_assign{ false }; // Interrupt Disable change requested by the current instruction
+		bool	_delay_change{ false }; // Interrupt Disable change applied at the end of the next instruction
 		u8		_delay_change_value{ 0 };
 
 #if CPU_TEST
@@ -378,470 +481,101 @@ namespace NES::CPU {
 
 
 		struct Instruction {
-			std::string	  name = "???";
-			u8(R6502::*opcode)(void) = &XXX; // function pointer for the Operation
-			u8(R6502::*addrmode)(void) = &IMP; // function pointer for the Address Mode
+			u8(R6502::*opcode)(void) = &R6502::XXX; // function pointer for the Operation
+			u8(R6502::*addrmode)(void) = &R6502::IMP; // function pointer for the Address Mode
 			u8			  cycles = 2;
 		};
 
-		// Lookup Table Map for R-MOS6502 Instructions
-		const std::array<std::array<R6502::Instruction, 16>, 16> _lookup{ // Row-Major 16x16
-			{ // Array Bracket
-
-			{ // 0x
-				{
-					{ "BRK", &R6502::BRK, &R6502::IMM, 7 },
-					{ "ORA", &R6502::ORA, &R6502::IZX, 6 },
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZX, 8 }, // Illegal -> SLO
-					{ "???", &R6502::NOP, &R6502::ZP0, 3 }, // Illegal -> NOP
-
-					{ "ORA", &R6502::ORA, &R6502::ZP0, 3 },
-					{ "ASL", &R6502::ASL, &R6502::ZP0, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 5 }, // Illegal -> SLO
-
-					{ "PHP", &R6502::PHP, &R6502::IMP, 3 },
-					{ "ORA", &R6502::ORA, &R6502::IMM, 2 },
-					{ "ASL", &R6502::ASL, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> ANC
-					{ "???", &R6502::NOP, &R6502::ABS, 4 }, // Illegal -> NOP
-
-					{ "ORA", &R6502::ORA, &R6502::ABS, 4 },
-					{ "ASL", &R6502::ASL, &R6502::ABS, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 6 }, // Illegal -> SLO
-				}
-			},
-
-			{ // 1x
-				{
-					{ "BPL", &R6502::BPL, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "ORA", &R6502::ORA, &R6502::IZY, 5 },	// * -> Cycle count can increase
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 8 }, // Illegal -> SLO
-					{ "???", &R6502::NOP, &R6502::ZPX, 4 }, // Illegal -> NOP
-
-					{ "ORA", &R6502::ORA, &R6502::ZPX, 4 },
-					{ "ASL", &R6502::ASL, &R6502::ZPX, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ZPX, 6 }, // Illegal -> SLO
-
-					{ "CLC", &R6502::CLC, &R6502::IMP, 2 },
-					{ "ORA", &R6502::ORA, &R6502::ABY, 4 }, // * -> Cycle count can increase
-
-					{ "???", &R6502::NOP, &R6502::IMP, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::ABY, 7 }, // Illegal -> SLO
-					{ "???", &R6502::NOP, &R6502::ABX, 4 }, // Illegal -> NOP | * -> Cycle count can increase
-
-					{ "ORA", &R6502::ORA, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "ASL", &R6502::ASL, &R6502::ABX, 7 },
-
-					{ "???", &R6502::XXX, &R6502::ABX, 7 }, // Illegal -> SLO
-				}
-			},
-
-			{ // 2x 
-				{
-					{ "JSR", &R6502::JSR, &R6502::ABS, 6 },
-					{ "AND", &R6502::AND, &R6502::IZX, 6 },
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZX, 8 }, // Illegal -> RLA
-
-					{ "BIT", &R6502::BIT, &R6502::ZP0, 3 },
-					{ "AND", &R6502::AND, &R6502::ZP0, 3 },
-					{ "ROL", &R6502::ROL, &R6502::ZP0, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 5 }, // Illegal -> RLA
-
-					{ "PLP", &R6502::PLP, &R6502::IMP, 4 },
-					{ "AND", &R6502::AND, &R6502::IMM, 2 },
-					{ "ROL", &R6502::ROL, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> ANC
-
-					{ "BIT", &R6502::BIT, &R6502::ABS, 4 },
-					{ "AND", &R6502::AND, &R6502::ABS, 4 },
-					{ "ROL", &R6502::ROL, &R6502::ABS, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 6 }, // Illegal -> RLA
-				}
-			},
-
-			{ // 3x 
-				{
-					{ "BMI", &R6502::BMI, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "AND", &R6502::AND, &R6502::IZY, 5 },	// * -> Cycle count can increase
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 8 }, // Illegal -> RLA
-					{ "???", &R6502::NOP, &R6502::ZPX, 4 }, // Illegal -> NOP
-
-					{ "AND", &R6502::AND, &R6502::ZPX, 4 },
-					{ "ROL", &R6502::ROL, &R6502::ZPX, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ZPX, 6 }, // Illegal -> RLA
-
-					{ "SEC", &R6502::SEC, &R6502::IMP, 2 },
-					{ "AND", &R6502::AND, &R6502::ABY, 4 }, // * -> Cycle count can increase
-
-					{ "???", &R6502::NOP, &R6502::IMP, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::ABY, 7 }, // Illegal -> RLA
-					{ "???", &R6502::NOP, &R6502::ABX, 4 }, // Illegal -> NOP | * -> Cycle count can increase
-
-					{ "AND", &R6502::AND, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "ROL", &R6502::ROL, &R6502::ABX, 7 },
-
-					{ "???", &R6502::XXX, &R6502::ABX, 7 }, // Illegal -> RLA
-				}
-			},
-
-			{ // 4x 
-				{
-					{ "RTI", &R6502::RTI, &R6502::IMP, 6 },
-					{ "EOR", &R6502::EOR, &R6502::IZX, 6 },
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZX, 8 }, // Illegal -> SRE
-					{ "???", &R6502::NOP, &R6502::ZP0, 3 }, // Illegal -> NOP
-
-					{ "EOR", &R6502::EOR, &R6502::ZP0, 3 },
-					{ "LSR", &R6502::LSR, &R6502::ZP0, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 5 }, // Illegal -> SRE
-
-					{ "PHA", &R6502::PHA, &R6502::IMP, 3 },
-					{ "EOR", &R6502::EOR, &R6502::IMM, 2 },
-					{ "LSR", &R6502::LSR, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> ALR
-
-					{ "JMP", &R6502::JMP, &R6502::ABS, 3 },
-					{ "EOR", &R6502::EOR, &R6502::ABS, 4 },
-					{ "LSR", &R6502::LSR, &R6502::ABS, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 6 }, // Illegal -> SRE
-				}
-			},
-
-			{ // 5x 
-				{
-					{ "BVC", &R6502::BVC, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "EOR", &R6502::EOR, &R6502::IZY, 5 }, // * -> Cycle count can increase
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 8 }, // Illegal -> SRE
-					{ "???", &R6502::NOP, &R6502::ZPX, 4 }, // Illegal -> NOP
-
-					{ "EOR", &R6502::EOR, &R6502::ZPX, 4 },
-					{ "LSR", &R6502::LSR, &R6502::ZPX, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ZPX, 6 }, // Illegal -> SRE
-
-					{ "CLI", &R6502::CLI, &R6502::IMP, 2 },
-					{ "EOR", &R6502::EOR, &R6502::ABY, 4 }, // * -> Cycle count can increase
-
-					{ "???", &R6502::NOP, &R6502::IMP, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::ABY, 7 }, // Illegal -> SRE
-					{ "???", &R6502::NOP, &R6502::ABX, 4 }, // Illegal -> NOP | * -> Cycle count can increase
-
-					{ "EOR", &R6502::EOR, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "LSR", &R6502::LSR, &R6502::ABX, 7 },
-
-					{ "???", &R6502::XXX, &R6502::ABX, 7 }, // Illegal -> SRE
-				}
-			},
-
-			{ // 6x 
-				{
-					{ "RTS", &R6502::RTS, &R6502::IMP, 6 },
-					{ "ADC", &R6502::ADC, &R6502::IZX, 6 },
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZX, 8 }, // Illegal -> RRA
-					{ "???", &R6502::NOP, &R6502::ZP0, 3 }, // Illegal -> NOP
-
-					{ "ADC", &R6502::ADC, &R6502::ZP0, 3 },
-					{ "ROR", &R6502::ROR, &R6502::ZP0, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 5 }, // Illegal -> RRA
-
-					{ "PLA", &R6502::PLA, &R6502::IMP, 4 },
-					{ "ADC", &R6502::ADC, &R6502::IMM, 2 },
-					{ "ROR", &R6502::ROR, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> ARR
-
-					{ "JMP", &R6502::JMP, &R6502::IND, 5 },
-					{ "ADC", &R6502::ADC, &R6502::ABS, 4 },
-					{ "ROR", &R6502::ROR, &R6502::ABS, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 6 }, // Illegal -> RRA
-				}
-			},
-
-			{ // 7x 
-				{
-					{ "BVS", &R6502::BVS, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "ADC", &R6502::ADC, &R6502::IZY, 5 }, // * -> Cycle count can increase
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 8 }, // Illegal -> RRA
-					{ "???", &R6502::NOP, &R6502::ZPX, 4 }, // Illegal -> NOP
-
-					{ "ADC", &R6502::ADC, &R6502::ZPX, 4 },
-					{ "ROR", &R6502::ROR, &R6502::ZPX, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ZPX, 6 }, // Illegal -> RRA
-
-					{ "SEI", &R6502::SEI, &R6502::IMP, 2 },
-					{ "ADC", &R6502::ADC, &R6502::ABY, 4 }, // * -> Cycle count can increase
-
-					{ "???", &R6502::NOP, &R6502::IMP, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::ABY, 7 }, // Illegal -> RRA
-					{ "???", &R6502::NOP, &R6502::ABX, 4 }, // Illegal -> NOP | * -> Cycle count can increase
-
-					{ "ADC", &R6502::ADC, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "ROR", &R6502::ROR, &R6502::ABX, 7 },
-
-					{ "???", &R6502::XXX, &R6502::ABX, 7 }, // Illegal -> RRA
-				}
-			},
-
-			{ // 8x 
-				{
-					{ "???", &R6502::NOP, &R6502::IMM, 2 }, // Illegal -> NOP
-
-					{ "STA", &R6502::STA, &R6502::IZX, 6 },
-
-					{ "???", &R6502::NOP, &R6502::IMM, 2 }, // Illegal -> NOP
-					{ "???", &R6502::NOP, &R6502::IZX, 6 }, // Illegal -> SAX
-
-					{ "STY", &R6502::STY, &R6502::ZP0, 3 },
-					{ "STA", &R6502::STA, &R6502::ZP0, 3 },
-					{ "STX", &R6502::STX, &R6502::ZP0, 3 },
-
-					{ "???", &R6502::NOP, &R6502::ZP0, 3 }, // Illegal -> SAX
-
-					{ "DEY", &R6502::DEY, &R6502::IMP, 2 },
-
-					{ "???", &R6502::NOP, &R6502::IMM, 2 }, // Illegal -> NOP
-
-					{ "TXA", &R6502::TXA, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> XAA | RED
-
-					{ "STY", &R6502::STY, &R6502::ABS, 4 },
-					{ "STA", &R6502::STA, &R6502::ABS, 4 },
-					{ "STX", &R6502::STX, &R6502::ABS, 4 },
-
-					{ "???", &R6502::NOP, &R6502::ABS, 4 }, // Illegal -> SAX
-				}
-			},
-
-			{ // 9x 
-				{
-					{ "BCC", &R6502::BCC, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "STA", &R6502::STA, &R6502::IZY, 6 },
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 6 }, // Illegal -> AHX | BLUE
-
-					{ "STY", &R6502::STY, &R6502::ZPX, 4 },
-					{ "STA", &R6502::STA, &R6502::ZPX, 4 },
-					{ "STX", &R6502::STX, &R6502::ZPY, 4 },
-
-					{ "???", &R6502::XXX, &R6502::ZPY, 4 }, // Illegal -> SAX
-
-					{ "TYA", &R6502::TYA, &R6502::IMP, 2 },
-					{ "STA", &R6502::STA, &R6502::ABY, 5 },
-					{ "TXS", &R6502::TXS, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::ABY, 5 }, // Illegal -> TAS | BLUE
-					{ "???", &R6502::XXX, &R6502::ABX, 5 }, // Illegal -> SHY | BLUE
-
-					{ "STA", &R6502::STA, &R6502::ABX, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ABY, 5 }, // Illegal -> SHX | BLUE
-					{ "???", &R6502::XXX, &R6502::ABY, 5 }, // Illegal -> AHX | BLUE
-				}
-			},
-
-			{ // Ax 
-				{
-					{ "LDY", &R6502::LDY, &R6502::IMM, 2 },
-					{ "LDA", &R6502::LDA, &R6502::IZX, 6 },
-					{ "LDX", &R6502::LDX, &R6502::IMM, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IZX, 6 }, // Illegal -> LAX
-
-					{ "LDY", &R6502::LDY, &R6502::ZP0, 3 },
-					{ "LDA", &R6502::LDA, &R6502::ZP0, 3 },
-					{ "LDX", &R6502::LDX, &R6502::ZP0, 3 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 3 }, // Illegal -> LAX
-
-					{ "TAY", &R6502::TAY, &R6502::IMP, 2 },
-					{ "LDA", &R6502::LDA, &R6502::IMM, 2 },
-					{ "TAX", &R6502::TAX, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> LAX | RED
-
-					{ "LDY", &R6502::LDY, &R6502::ABS, 4 },
-					{ "LDA", &R6502::LDA, &R6502::ABS, 4 },
-					{ "LDX", &R6502::LDX, &R6502::ABS, 4 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 4 }, // Illegal -> LAX
-				}
-			},
-
-			{ // Bx 
-				{
-					{ "BCS", &R6502::BCS, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "LDA", &R6502::LDA, &R6502::IZY, 5 }, // * -> Cycle count can increase
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 5 }, // Illegal -> LAX | * -> Cycle count can increase
-
-					{ "LDY", &R6502::LDY, &R6502::ZPX, 4 },
-					{ "LDA", &R6502::LDA, &R6502::ZPX, 4 },
-					{ "LDX", &R6502::LDX, &R6502::ZPY, 4 },
-
-					{ "???", &R6502::XXX, &R6502::ZPY, 4 }, // Illegal -> LAX
-
-					{ "CLV", &R6502::CLV, &R6502::IMP, 2 },
-					{ "LDA", &R6502::LDA, &R6502::ABY, 4 }, // * -> Cycle count can increase
-					{ "TSX", &R6502::TSX, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::ABY, 4 }, // Illegal -> LAS | // * -> Cycle count can increase
-
-					{ "LDY", &R6502::LDY, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "LDA", &R6502::LDA, &R6502::ABX, 4 },	// * -> Cycle count can increase
-					{ "LDX", &R6502::LDX, &R6502::ABY, 4 },	// * -> Cycle count can increase
-
-					{ "???", &R6502::XXX, &R6502::ABY, 4 }, // Illegal -> LAX | * -> Cycle count can increase
-				}
-			},
-
-			{ // Cx 
-				{
-					{ "CPY", &R6502::CPY, &R6502::IMM, 2 },
-					{ "CMP", &R6502::CMP, &R6502::IZX, 6 },
-
-					{ "???", &R6502::NOP, &R6502::IMM, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::IZX, 8 }, // Illegal -> DCP
-
-					{ "CPY", &R6502::CPY, &R6502::ZP0, 3 },
-					{ "CMP", &R6502::CMP, &R6502::ZP0, 3 },
-					{ "DEC", &R6502::DEC, &R6502::ZP0, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 5 }, // Illegal -> DCP
-
-					{ "INY", &R6502::INY, &R6502::IMP, 2 },
-					{ "CMP", &R6502::CMP, &R6502::IMM, 2 },
-					{ "DEX", &R6502::DEX, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> AXS
-
-					{ "CPY", &R6502::CPY, &R6502::ABS, 4 },
-					{ "CMP", &R6502::CMP, &R6502::ABS, 4 },
-					{ "DEC", &R6502::DEC, &R6502::ABS, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 6 }, // Illegal -> DCP
-				}
-			},
-
-			{ // Dx 
-				{
-					{ "BNE", &R6502::BNE, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "CMP", &R6502::CMP, &R6502::IZY, 5 }, // * -> Cycle count can increase
-
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 8 }, // Illegal -> DCP
-					{ "???", &R6502::NOP, &R6502::ZPX, 4 }, // Illegal -> NOP
-
-					{ "CMP", &R6502::CMP, &R6502::ZPX, 4 },
-					{ "DEC", &R6502::DEC, &R6502::ZPX, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ZPX, 6 }, // Illegal -> DCP
-
-					{ "CLD", &R6502::CLD, &R6502::IMP, 2 },
-					{ "CMP", &R6502::CMP, &R6502::ABY, 4 }, // * -> Cycle count can increase
-
-					{ "???", &R6502::NOP, &R6502::IMP, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::ABY, 7 }, // Illegal -> DCP
-					{ "???", &R6502::NOP, &R6502::ABX, 4 }, // Illegal -> NOP | * -> Cycle count can increase
-
-					{ "CMP", &R6502::CMP, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "DEC", &R6502::DEC, &R6502::ABX, 7 },
-
-					{ "???", &R6502::XXX, &R6502::ABX, 7 }, // Illegal -> DCP
-				}
-			},
-
-			{ // Ex 
-				{
-					{ "CPX", &R6502::CPX, &R6502::IMM, 2 },
-					{ "SBC", &R6502::SBC, &R6502::IZX, 6 },
-
-					{ "???", &R6502::NOP, &R6502::IMM, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::IZX, 8 }, // Illegal -> ISC
-
-					{ "CPX", &R6502::CPX, &R6502::ZP0, 3 },
-					{ "SBC", &R6502::SBC, &R6502::ZP0, 3 },
-					{ "INC", &R6502::INC, &R6502::ZP0, 5 },
-
-					{ "???", &R6502::XXX, &R6502::ZP0, 5 }, // Illegal -> ISC
-
-					{ "INX", &R6502::INX, &R6502::IMP, 2 },
-					{ "SBC", &R6502::SBC, &R6502::IMM, 2 },
-					{ "NOP", &R6502::NOP, &R6502::IMP, 2 },
-
-					{ "???", &R6502::XXX, &R6502::IMM, 2 }, // Illegal -> SBC
-
-					{ "CPX", &R6502::CPX, &R6502::ABS, 4 },
-					{ "SBC", &R6502::SBC, &R6502::ABS, 4 },
-					{ "INC", &R6502::INC, &R6502::ABS, 6 },
-
-					{ "???", &R6502::XXX, &R6502::ABS, 6 }, // Illegal -> ISC
-				}
-			},
-
-			{ // Fx 
-				{
-					{ "BEQ", &R6502::BEQ, &R6502::REL, 2 }, // * -> Cycle count can increase
-					{ "SBC", &R6502::SBC, &R6502::IZY, 5 }, // * -> Cycle count can increase
+		// Lookup Table Map for R-MOS6502 Instructions | Generated from opcode_table [OpcodeTable.h], mnemonics -> opcode_name()
+		static const std::array<R6502::Instruction, 256> _lookup;
+		static std::array<R6502::Instruction, 256> build_lookup();
+
+		/// Switch-Dispatched Core [R6502_SwitchCore.cpp] ///
+		// Every opcode is a fully inlined case combining its addressing mode and operation, instantiated from opcode_table.
+		// Returns the number of cycles taken by the instruction.
+		u8 execute(u8 opcode);
+		template<u8 Opcode> u8 execute();
+		template<AddressMode Mode> bool fetch_address(); // returns true if the memory Page has changed
+		template<AddressMode Mode> bool resolve_address(u16 operand); // fetch_address with the operand bytes already read
+		template<Operation Op, AddressMode Mode> u8 operate(); // returns the additional cycles
+		template<OpcodeInfo Info> void publish_access_cycle(bool page_crossed); // Bus cycle of the data access [access_offset]
+
+		// Bus access for the switch core
+		u8 bus_read(u16 address) { return _bus->read(address); }
+		void bus_write(u16 address, u8 data) { _bus->write(address, data); }
+		void push(u8 data) { bus_write(0x0100 + _stack_pointer, data); --_stack_pointer; }
+		u8 pull() { ++_stack_pointer; return bus_read(0x0100 + _stack_pointer); }
+		/// END ///
+
+#if CPU_INSTRUCTION_CACHE
+		/// Pre-decoded Instruction Cache [R6502_SwitchCore.cpp] ///
+		// Code is decoded once per host page of plain memory: the handler of its opcode, the operand bytes and the base cycles.
+		// Banks are told apart by the host pointer the page table holds, so a PRG-ROM bank keeps its decoded code while it is switched out
+		// and a bank switch only drops the CPU pages that moved [Bus::set_code_listener]. Mirrors share a decoded page,
+		// nothing in it depends on the CPU address. RAM pages holding decoded code are watched, a write into them clears the instructions covering that byte.
+		// Decoding runs from the missed instruction to the end of its basic block [branch, jump, return or the end of the page],
+		// so the instructions after it are found decoded too. Only the opcode and operand reads of plain memory are skipped,
+		// they have no side effects -> same state, same cycles as fetching.
+		// Threaded Blocks -> each entry knows whether the next one in its page is the instruction that follows it [chained].
+		// run_block() goes from entry to entry without the page lookup and without the interrupt polls, DMA poll and stall
+		// accounting of step(): up to the interrupt horizon every poll comes out false anyway [Bus::quiet_until]. An instruction
+		// that reached a device [Bus::device_accesses] can have moved the horizon or started a DMA, so the block ends after it.
+		using DecodedHandler = u8(*)(R6502&, u16); // returns the additional cycles
+
+		struct DecodedInstruction {
+			DecodedHandler	handler{ nullptr }; // nullptr -> not decoded
+			u16				operand{ 0 }; // Operand bytes
+			u8				opcode{ 0 };
+			u8				length{ 0 };
+			u8				cycles{ 0 }; // Base cycles [opcode_table]
+			bool			chained{ false }; // Falls through to the entry length bytes on, in the same page [no branch, jump, return or CLI/SEI/PLP]
+		};
 
-					{}, // Illegal -> KIL
-					{ "???", &R6502::XXX, &R6502::IZY, 8 }, // Illegal -> ISC
-					{ "???", &R6502::NOP, &R6502::ZPX, 4 }, // Illegal -> NOP
+		struct DecodedPage {
+			const u8*								memory{ nullptr }; // Host page decoded from
+			std::array<DecodedInstruction, 256>		instructions{};
+		};
 
-					{ "SBC", &R6502::SBC, &R6502::ZPX, 4 },
-					{ "INC", &R6502::INC, &R6502::ZPX, 6 },
+		// Decoded instruction at the address, nullptr if it cannot be cached
+		const DecodedInstruction* decoded(u16 address) {
+			DecodedPage* page = _code_pages[address >> 8];
+			if (!page) [[unlikely]] {
+				page = map_code_page(static_cast<u8>(address >> 8));
+				if (!page) return nullptr;
+			}
+			const DecodedInstruction& instruction = page->instructions[address & 0xFF];
+			if (instruction.handler) [[likely]] return &instruction;
+			return decode_block(*page, address);
+		}
 
-					{ "???", &R6502::XXX, &R6502::ZPX, 6 }, // Illegal -> ISC
+		// Runs decoded instructions back to back while nothing can interrupt them | false -> nothing ran, step() takes the instruction
+		bool run_block(u64 target_cycle);
 
-					{ "SED", &R6502::SED, &R6502::IMP, 2 },
-					{ "SBC", &R6502::SBC, &R6502::ABY, 4 }, // * -> Cycle count can increase
+		DecodedPage* map_code_page(u8 page);
+		const DecodedInstruction* decode_block(DecodedPage& page, u16 address);
+		void code_remapped(u16 first, u16 last);
+		void code_ram_written(u16 first, u16 last);
+		template<u8 Opcode> static u8 execute_decoded(R6502& cpu, u16 operand);
 
-					{ "???", &R6502::NOP, &R6502::IMP, 2 }, // Illegal -> NOP
-					{ "???", &R6502::XXX, &R6502::ABY, 7 }, // Illegal -> ISC
-					{ "???", &R6502::NOP, &R6502::ABX, 4 }, // Illegal -> NOP | * -> Cycle count can increase
+		static const std::array<DecodedHandler, 256>					_decoded_handlers;
+		std::array<DecodedPage*, 256>									_code_pages{}; // CPU page -> decoded page of the memory mapped there
+		std::array<std::unique_ptr<DecodedPage>, 8>						_ram_code; // 2KB RAM, one per 256 bytes
+		std::unordered_map<const u8*, std::unique_ptr<DecodedPage>>		_rom_code; // PRG-ROM pages by host pointer
+		/// END ///
+#endif // CPU_INSTRUCTION_CACHE
 
-					{ "SBC", &R6502::SBC, &R6502::ABX, 4 }, // * -> Cycle count can increase
-					{ "INC", &R6502::INC, &R6502::ABX, 7 },
+#if CPU_DYNAREC
+		/// Dynamic Recompiler [R6502_SwitchCore.cpp] ///
+		// run_until() offers every instruction boundary to the translated block at the program counter first; the interpreter
+		// takes the instruction when there is none, or when the block could run past an interrupt or the cycle budget.
+		bool run_native(u64 target_cycle);
+		bool verify_native(const Dynarec::Block& block, Dynarec::Context& context);
 
-					{ "???", &R6502::XXX, &R6502::ABX, 7 }, // Illegal -> ISC
-				}
-			},
+		std::unique_ptr<Dynarec>	_dynarec;
+		Dynarec::Mode				_dynarec_mode{ Dynarec::Mode::On };
+		/// END ///
+#endif // CPU_DYNAREC
 
-			} // Array Bracket
-		}; // Lookup Table for OP-Codes : 
-		// NOTE: * -> add 1 cycle if page boundary is crossed and/or add 1 cycle on branches if taken.
 
 		
 		void SetFlag(StateFlags status, bool value) {
@@ -865,12 +599,9 @@ namespace NES::CPU {
 			}
 		}
 
-		void debug_status_register();
-
 		// Writes to the Memory on the Address Bus
 		void write_memory(u16 address) {
 			_bus->write(address, _data);
-			clock();
 		}
 
 		// Writes to the Accumulator on the Chip
@@ -888,10 +619,34 @@ namespace NES::CPU {
 		// Reads from the Memory on the Address Bus
 		u8 read_memory(u16 address, bool bReadOnly = false) {
 			u8 data{ _bus->read(address) };
-			clock();
 			return data;
 		}
 
+		// Operand of a read/modify/write instruction | Accumulator or memory at _address_abs, as the addressing mode decided
+		u8 read_operand() { return _accumulator_operand ? read_accumulator(_address_abs) : read_memory(_address_abs); }
+		void write_operand() {
+			if (_accumulator_operand) return write_accumulator(_address_abs);
+			_bus->next_cpu_cycle();
+			write_memory(_address_abs);
+		}
+
+		// Trace Record | State before the instruction at the program counter, the operand bytes are read ahead [only while tracing]
+		TraceRecord trace_begin() {
+			TraceRecord record;
+			record.cycle = _total_cycles;
+			record.pc = _program_counter;
+			record.opcode = _bus->read(_program_counter);
+			for (u8 i{ 1 }; i < record.length(); ++i) {
+				record.operand[i - 1] = _bus->read(static_cast<u16>(_program_counter + i));
+			}
+			record.a = _accumulator;
+			record.x = _x_register;
+			record.y = _y_register;
+			record.sp = _stack_pointer;
+			record.p = _status_register;
+			return record;
+		}
+
 		// Handles interrupt calls and points to the Respective Handler
 		void interrupt() {
 
@@ -916,20 +671,17 @@ namespace NES::CPU {
 			_program_counter = (h_address << 8) | l_address;
 		}
 
-		// Handles delayed change for Interrupt Disable Flag
-		void do_nothing_like_its_nobodys_business() { }
+		// Handles delayed change for Interrupt Disable Flag | Called at the end of every instruction
+		void update_interrupt_disable() {
+			if (_delay_change) { // Requested by the previous instruction -> takes effect now
+				SetFlag(StateFlags::I, _delay_change_value);
+				_delay_change = false;
+			}
 
-		void assign_delay_interrupt_disable_change() {
-			delay_change = &R6502::interrupt_disable_change;
-			delay_assign = &R6502::do_nothing_like_its_nobodys_business;
-		}
-		
-		void interrupt_disable_change() {
-			SetFlag(StateFlags::I, _delay_change_value);
-			delay_change = &R6502::do_nothing_like_its_nobodys_business;
-#if CPU_TEST
-			debug_status_register();
-#endif // CPU_TEST
+			if (_delay_assign) { // Requested by this instruction -> takes effect after the next instruction
+				_delay_change = true;
+				_delay_assign = false;
+			}
 		}
 	};
 }
\ No newline at end of file
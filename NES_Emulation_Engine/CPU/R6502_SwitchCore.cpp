@@ -0,0 +1,607 @@
+#include "R6502.h"
+
+// Switch-Dispatched R6502 Core
+// Each of the 256 opcodes is its own case, instantiated from opcode_table [OpcodeTable.h] with the addressing mode and the operation inlined together.
+// The register/flag results follow the member-function-pointer core in R6502.cpp, operation for operation, so either core can be picked with CPU_SWITCH_CORE.
+// Cycles are accounted per instruction [base + OOPS cycle + branch taken] instead of per memory access.
+
+namespace NES::CPU {
+
+	/// Addressing Modes ///
+
+	template<AddressMode Mode>
+	inline bool R6502::fetch_address() {
+		if constexpr (Mode == AddressMode::IMP) { // Accumulator or implied, nothing to fetch
+			return false;
+		} else if constexpr (Mode == AddressMode::IMM) {
+			_address_abs = _program_counter++;
+			return false;
+		} else {
+			u16 operand = bus_read(_program_counter++);
+			if constexpr (Mode == AddressMode::ABS || Mode == AddressMode::ABX || Mode == AddressMode::ABY || Mode == AddressMode::IND) {
+				operand |= bus_read(_program_counter++) << 8;
+			}
+			return resolve_address<Mode>(operand);
+		}
+	}
+
+	template<AddressMode Mode>
+	inline bool R6502::resolve_address(u16 operand) {
+		if constexpr (Mode == AddressMode::IMP) {
+			return false;
+		} else if constexpr (Mode == AddressMode::IMM) { // Decoded code only, the program counter is past the value
+			_address_abs = _program_counter - 1;
+			return false;
+		} else if constexpr (Mode == AddressMode::ZP0) {
+			_address_abs = operand & 0x00FF;
+			return false;
+		} else if constexpr (Mode == AddressMode::ZPX) {
+			_address_abs = (operand + _x_register) & 0x00FF;
+			return false;
+		} else if constexpr (Mode == AddressMode::ZPY) {
+			_address_abs = (operand + _y_register) & 0x00FF;
+			return false;
+		} else if constexpr (Mode == AddressMode::REL) {
+			_address_rel = operand;
+			if (_address_rel & 0x80) _address_rel |= 0xFF00;
+			return false;
+		} else if constexpr (Mode == AddressMode::ABS) {
+			_address_abs = operand;
+			return false;
+		} else if constexpr (Mode == AddressMode::ABX || Mode == AddressMode::ABY) {
+			_address_abs = operand + (Mode == AddressMode::ABX ? _x_register : _y_register);
+			return (operand >> 8) != (_address_abs >> 8);
+		} else if constexpr (Mode == AddressMode::IND) {
+			if ((operand & 0x00FF) == 0x00FF) { // Page Boundary Glitch -> Indirect JMP ($ADDR) Glitch
+				_address_abs = (bus_read(operand & 0xFF00) << 8) | bus_read(operand);
+			} else {
+				_address_abs = (bus_read(operand + 1) << 8) | bus_read(operand);
+			}
+			return false;
+		} else if constexpr (Mode == AddressMode::IZX) {
+			u16 l_address_i = bus_read((u16)(operand + _x_register) & 0x00FF);
+			u16 h_address_i = bus_read((u16)(operand + _x_register + 1) & 0x00FF);
+			_address_abs = (h_address_i << 8) | l_address_i;
+			return false;
+		} else if constexpr (Mode == AddressMode::IZY) {
+			u16 l_address_i = bus_read(operand & 0x00FF);
+			u16 h_address_i = bus_read((operand + 1) & 0x00FF);
+			_address_abs = ((h_address_i << 8) | l_address_i) + _y_register;
+			return h_address_i != (_address_abs >> 8);
+		}
+	}
+
+	// Devices behind I/O pages catch up to the cycle of the data access, not to the start of the instruction
+	template<OpcodeInfo Info>
+	inline void R6502::publish_access_cycle(bool page_crossed) {
+		if constexpr (Info.mode != AddressMode::IMP && Info.mode != AddressMode::IMM && Info.mode != AddressMode::REL) {
+			u64 cycle = _total_cycles + access_offset(Info);
+			if constexpr (has_page_cross_penalty(Info.operation)) cycle += page_crossed; // The read waits for the fixed-up address
+			_bus->set_cpu_cycle(cycle);
+		}
+	}
+
+	/// Operations ///
+
+	template<Operation Op, AddressMode Mode>
+	inline u8 R6502::operate() {
+		using enum Operation;
+
+		// Read-Modify-Write operations work on the accumulator when implied
+		auto rmw_read = [this]() -> u8 {
+			if constexpr (Mode == AddressMode::IMP) return _accumulator;
+			else return bus_read(_address_abs);
+		};
+		auto rmw_write = [this]() {
+			if constexpr (Mode == AddressMode::IMP) {
+				_accumulator = _data;
+			} else {
+				_bus->next_cpu_cycle();
+				bus_write(_address_abs, _data);
+			}
+		};
+		auto branch = [this](bool condition) -> u8 {
+			if (!condition) return 0; // Jump/Branch Not Taken
+			_address_abs = _program_counter;
+			_program_counter += _address_rel;
+			return ((_program_counter >> 8) != (_address_abs >> 8)) ? 2 : 1; // [OOPS Cycle] if the memory Page has changed
+		};
+		auto load_flags = [this](u8 value) {
+			SetFlag(StateFlags::Z, value == 0);
+			SetFlag(StateFlags::N, value >> 7);
+		};
+		auto compare = [this](u8 value) {
+			u16 temp = value - bus_read(_address_abs);
+			SetFlag(StateFlags::Z, temp == 0);
+			SetFlag(StateFlags::C, !(temp & 0xFF00));
+			SetFlag(StateFlags::N, temp & 0xFF00);
+		};
+
+		if constexpr (Op == ADC) {
+			_data = bus_read(_address_abs);
+			u16 temp = _accumulator + _data + GetFlag(StateFlags::C);
+			SetFlag(StateFlags::C, temp > 255);
+			SetFlag(StateFlags::Z, temp == 0);
+			SetFlag(StateFlags::N, temp & 0x80);
+			SetFlag(StateFlags::V, (~((u16)_accumulator ^ (u16)_data) & ((u16)_accumulator ^ (u16)temp)) & 0x0080);
+			_accumulator = temp & 0x00FF;
+		} else if constexpr (Op == AND) {
+			_data = bus_read(_address_abs);
+			_accumulator &= _data;
+			load_flags(_accumulator);
+		} else if constexpr (Op == ASL) {
+			_data = rmw_read();
+			rmw_write();
+			SetFlag(StateFlags::C, _data & 0x80);
+			_data = (_data << 1) & 0xFE;
+			rmw_write();
+			load_flags(_data);
+		} else if constexpr (Op == BCC) {
+			return branch(!GetFlag(StateFlags::C));
+		} else if constexpr (Op == BCS) {
+			return branch(GetFlag(StateFlags::C));
+		} else if constexpr (Op == BEQ) {
+			return branch(GetFlag(StateFlags::Z));
+		} else if constexpr (Op == BIT) {
+			_data = bus_read(_address_abs) & _accumulator;
+			SetFlag(StateFlags::Z, _data == 0);
+			SetFlag(StateFlags::V, _data & 0b01000000);
+			SetFlag(StateFlags::N, _data & 0b10000000);
+		} else if constexpr (Op == BMI) {
+			return branch(GetFlag(StateFlags::N));
+		} else if constexpr (Op == BNE) {
+			return branch(!GetFlag(StateFlags::Z));
+		} else if constexpr (Op == BPL) {
+			return branch(!GetFlag(StateFlags::N));
+		} else if constexpr (Op == BRK) {
+			SetFlag(StateFlags::B, 1);
+			_address_abs = 0xFFFE; // IRQ/BRK vector
+			push((_program_counter >> 8) & 0x00FF);
+			push(_program_counter & 0x00FF);
+			_data = _status_register;
+			push(_data);
+			SetFlag(StateFlags::I, 1);
+			u16 l_address = bus_read(_address_abs + 0);
+			u16 h_address = bus_read(_address_abs + 1);
+			_program_counter = (h_address << 8) | l_address;
+		} else if constexpr (Op == BVC) {
+			return branch(!GetFlag(StateFlags::V));
+		} else if constexpr (Op == BVS) {
+			return branch(GetFlag(StateFlags::V));
+		} else if constexpr (Op == CLC) {
+			SetFlag(StateFlags::C, false);
+		} else if constexpr (Op == CLD) {
+			SetFlag(StateFlags::D, false);
+		} else if constexpr (Op == CLI) {
+			_delay_change_value = 0;
+			_delay_assign = true;
+		} else if constexpr (Op == CLV) {
+			SetFlag(StateFlags::V, false);
+		} else if constexpr (Op == CMP) {
+			compare(_accumulator);
+		} else if constexpr (Op == CPX) {
+			compare(_x_register);
+		} else if constexpr (Op == CPY) {
+			compare(_y_register);
+		} else if constexpr (Op == DEC) {
+			_data = rmw_read();
+			rmw_write();
+			--_data;
+			rmw_write();
+			load_flags(_data);
+		} else if constexpr (Op == DEX) {
+			load_flags(--_x_register);
+		} else if constexpr (Op == DEY) {
+			load_flags(--_y_register);
+		} else if constexpr (Op == EOR) {
+			_data = bus_read(_address_abs);
+			_accumulator ^= _data;
+			load_flags(_accumulator);
+		} else if constexpr (Op == INC) {
+			_data = rmw_read();
+			rmw_write();
+			++_data;
+			rmw_write();
+			load_flags(_data);
+		} else if constexpr (Op == INX) {
+			load_flags(++_x_register);
+		} else if constexpr (Op == INY) {
+			load_flags(++_y_register);
+		} else if constexpr (Op == JMP) {
+			_program_counter = _address_abs;
+		} else if constexpr (Op == JSR) {
+			_data = (_program_counter >> 8) & 0x00FF;
+			push(_data);
+			_data = _program_counter & 0x00FF;
+			push(_data);
+			_program_counter = _address_abs;
+		} else if constexpr (Op == LDA) {
+			_accumulator = bus_read(_address_abs);
+			load_flags(_accumulator);
+		} else if constexpr (Op == LDX) {
+			_x_register = bus_read(_address_abs);
+			load_flags(_x_register);
+		} else if constexpr (Op == LDY) {
+			_y_register = bus_read(_address_abs);
+			load_flags(_y_register);
+		} else if constexpr (Op == LSR) {
+			_data = rmw_read();
+			rmw_write();
+			SetFlag(StateFlags::C, _data & 0x01);
+			_data >>= 1;
+			rmw_write();
+			load_flags(_data);
+		} else if constexpr (Op == NOP || Op == XXX) {
+			// has no effect; it merely wastes space and CPU cycles.
+		} else if constexpr (Op == ORA) {
+			_data = bus_read(_address_abs);
+			_accumulator |= _data;
+			SetFlag(StateFlags::Z, _accumulator == 0);
+			SetFlag(StateFlags::Z, _data >> 7);
+		} else if constexpr (Op == PHA) {
+			_data = _accumulator;
+			push(_data);
+		} else if constexpr (Op == PHP) {
+			_data = _status_register | 0x30;
+			push(_data);
+		} else if constexpr (Op == PLA) {
+			_accumulator = pull();
+			load_flags(_accumulator);
+		} else if constexpr (Op == PLP) {
+			_data = (pull() & 0xCF) | StateFlags::U;
+			_delay_change_value = (_data & StateFlags::I) >> 2;
+			_data &= ~StateFlags::I;
+			_delay_assign = true;
+			_status_register |= _data;
+		} else if constexpr (Op == ROL) {
+			_data = rmw_read();
+			rmw_write();
+			u8 temp = GetFlag(StateFlags::C);
+			SetFlag(StateFlags::C, _data & 0x80);
+			_data = ((_data << 1) & 0xFE) | temp;
+			rmw_write();
+			load_flags(_data);
+		} else if constexpr (Op == ROR) {
+			_data = rmw_read();
+			rmw_write();
+			u8 temp = GetFlag(StateFlags::C) << 7;
+			SetFlag(StateFlags::C, _data & 0x01);
+			_data = ((_data >> 1) & 0x7F) | temp;
+			rmw_write();
+			load_flags(_data);
+		} else if constexpr (Op == RTI) {
+			_status_register = pull();
+			_status_register &= ~StateFlags::B;
+			_status_register |= StateFlags::U;
+			_program_counter = (u16)pull();
+			_program_counter |= (u16)pull() << 8;
+		} else if constexpr (Op == RTS) {
+			_program_counter = (u16)pull();
+			_program_counter |= (u16)pull() << 8;
+		} else if constexpr (Op == SBC) {
+			u16 value = ((u16)bus_read(_address_abs)) ^ 0x00FF;
+			u16 temp = _accumulator + value + GetFlag(StateFlags::C);
+			SetFlag(StateFlags::C, temp > 0x00FF);
+			SetFlag(StateFlags::Z, temp == 0);
+			SetFlag(StateFlags::V, (((u16)temp ^ (u16)value) & ((u16)_accumulator ^ (u16)temp)) & 0x0080);
+			SetFlag(StateFlags::N, temp & 0x80);
+			_accumulator = temp & 0x00FF;
+		} else if constexpr (Op == SEC) {
+			SetFlag(StateFlags::C, true);
+		} else if constexpr (Op == SED) {
+			SetFlag(StateFlags::D, true);
+		} else if constexpr (Op == SEI) {
+			_delay_change_value = 1;
+			_delay_assign = true;
+		} else if constexpr (Op == STA) {
+			_data = _accumulator;
+			bus_write(_address_abs, _data);
+		} else if constexpr (Op == STX) {
+			_data = _x_register;
+			bus_write(_address_abs, _data);
+		} else if constexpr (Op == STY) {
+			_data = _y_register;
+			bus_write(_address_abs, _data);
+		} else if constexpr (Op == TAX) {
+			_x_register = _accumulator;
+			load_flags(_x_register);
+		} else if constexpr (Op == TAY) {
+			_y_register = _accumulator;
+			load_flags(_y_register);
+		} else if constexpr (Op == TSX) {
+			_x_register = _stack_pointer;
+			load_flags(_x_register);
+		} else if constexpr (Op == TXA) {
+			_accumulator = _x_register;
+			load_flags(_accumulator);
+		} else if constexpr (Op == TXS) {
+			_stack_pointer = _x_register;
+		} else if constexpr (Op == TYA) {
+			_accumulator = _y_register;
+			load_flags(_accumulator);
+		}
+
+		return 0;
+	}
+
+	/// Dispatch ///
+
+	template<u8 Opcode>
+	inline u8 R6502::execute() {
+		constexpr OpcodeInfo info = opcode_table[Opcode];
+
+		const bool page_crossed = fetch_address<info.mode>();
+		publish_access_cycle<info>(page_crossed);
+		u8 cycles = info.cycles + operate<info.operation, info.mode>();
+
+		if constexpr (has_page_cross_penalty(info.operation)) {
+			cycles += page_crossed; // [OOPS Cycle]
+		}
+		return cycles;
+	}
+
+#define R6502_OPCODE_CASE(opcode) case (opcode): return execute<(opcode)>();
+#define R6502_OPCODE_ROW(row)																\
+	R6502_OPCODE_CASE(row | 0x0) R6502_OPCODE_CASE(row | 0x1) R6502_OPCODE_CASE(row | 0x2) R6502_OPCODE_CASE(row | 0x3)	\
+	R6502_OPCODE_CASE(row | 0x4) R6502_OPCODE_CASE(row | 0x5) R6502_OPCODE_CASE(row | 0x6) R6502_OPCODE_CASE(row | 0x7)	\
+	R6502_OPCODE_CASE(row | 0x8) R6502_OPCODE_CASE(row | 0x9) R6502_OPCODE_CASE(row | 0xA) R6502_OPCODE_CASE(row | 0xB)	\
+	R6502_OPCODE_CASE(row | 0xC) R6502_OPCODE_CASE(row | 0xD) R6502_OPCODE_CASE(row | 0xE) R6502_OPCODE_CASE(row | 0xF)
+
+	u8 R6502::execute(u8 opcode) {
+		switch (opcode) {
+			R6502_OPCODE_ROW(0x00) R6502_OPCODE_ROW(0x10) R6502_OPCODE_ROW(0x20) R6502_OPCODE_ROW(0x30)
+			R6502_OPCODE_ROW(0x40) R6502_OPCODE_ROW(0x50) R6502_OPCODE_ROW(0x60) R6502_OPCODE_ROW(0x70)
+			R6502_OPCODE_ROW(0x80) R6502_OPCODE_ROW(0x90) R6502_OPCODE_ROW(0xA0) R6502_OPCODE_ROW(0xB0)
+			R6502_OPCODE_ROW(0xC0) R6502_OPCODE_ROW(0xD0) R6502_OPCODE_ROW(0xE0) R6502_OPCODE_ROW(0xF0)
+		}
+		return 0; // Unreachable, every u8 has a case
+	}
+
+#undef R6502_OPCODE_ROW
+#undef R6502_OPCODE_CASE
+
+#if CPU_INSTRUCTION_CACHE
+	/// Pre-decoded Instruction Cache ///
+
+	namespace {
+
+		// Last instruction of a basic block -> the next one to run is not the next one in memory
+		constexpr bool ends_block(Operation operation) {
+			switch (operation) {
+			case Operation::BCC: case Operation::BCS: case Operation::BEQ: case Operation::BMI:
+			case Operation::BNE: case Operation::BPL: case Operation::BVC: case Operation::BVS:
+			case Operation::BRK: case Operation::JMP: case Operation::JSR: case Operation::RTI: case Operation::RTS:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		// Requests an interrupt disable change for the end of the next instruction [R6502::update_interrupt_disable]
+		constexpr bool delays_interrupt_disable(Operation operation) {
+			return operation == Operation::CLI || operation == Operation::SEI || operation == Operation::PLP;
+		}
+
+	} // Anonymous Namespace
+
+	// The program counter is already past the instruction, like after fetch_address
+	template<u8 Opcode>
+	u8 R6502::execute_decoded(R6502& cpu, u16 operand) {
+		constexpr OpcodeInfo info = opcode_table[Opcode];
+
+		const bool page_crossed = cpu.resolve_address<info.mode>(operand);
+		cpu.publish_access_cycle<info>(page_crossed);
+		u8 cycles = cpu.operate<info.operation, info.mode>();
+
+		if constexpr (has_page_cross_penalty(info.operation)) {
+			cycles += page_crossed; // [OOPS Cycle]
+		}
+		return cycles;
+	}
+
+	const std::array<R6502::DecodedHandler, 256> R6502::_decoded_handlers = []<std::size_t... Opcodes>(std::index_sequence<Opcodes...>) {
+		return std::array<R6502::DecodedHandler, 256>{ &R6502::execute_decoded<static_cast<u8>(Opcodes)>... };
+	}(std::make_index_sequence<256>{});
+
+	// Decoded page for the memory now mapped at the CPU page | nullptr for handler pages
+	R6502::DecodedPage* R6502::map_code_page(u8 page) {
+		const u8* memory = _bus->memory_page(page);
+		if (!memory) return nullptr;
+
+		DecodedPage* decoded_page{ nullptr };
+		if (page < 0x20) { // $0000-$1FFF RAM and its mirrors
+			std::unique_ptr<DecodedPage>& ram = _ram_code[page & 0x07];
+			if (!ram) {
+				ram = std::make_unique<DecodedPage>();
+				ram->memory = memory;
+				_bus->watch_ram(page);
+			}
+			decoded_page = ram.get();
+		} else { // PRG-ROM, read only -> decoded once per bank for good
+			std::unique_ptr<DecodedPage>& rom = _rom_code[memory];
+			if (!rom) {
+				rom = std::make_unique<DecodedPage>();
+				rom->memory = memory;
+			}
+			decoded_page = rom.get();
+		}
+		_code_pages[page] = decoded_page;
+		return decoded_page;
+	}
+
+	const R6502::DecodedInstruction* R6502::decode_block(DecodedPage& page, u16 address) {
+		for (u32 offset{ address & 0x00FFu }; offset < 256;) {
+			DecodedInstruction& instruction = page.instructions[offset];
+			if (instruction.handler) break; // Runs into a block decoded before
+
+			const u8 opcode = page.memory[offset];
+			const u8 length = instruction_length(opcode);
+			if (offset + length > 256) break; // The operand is on the next page, which can be mapped on its own
+
+			instruction.opcode = opcode;
+			instruction.length = length;
+			instruction.cycles = opcode_table[opcode].cycles;
+			instruction.operand = (length > 1 ? page.memory[offset + 1] : 0x00) | (length > 2 ? page.memory[offset + 2] << 8 : 0x00);
+			instruction.handler = _decoded_handlers[opcode];
+			const Operation operation = opcode_table[opcode].operation;
+			instruction.chained = !ends_block(operation) && !delays_interrupt_disable(operation) && offset + length < 256;
+
+			if (ends_block(operation)) break;
+			offset += length;
+		}
+
+		const DecodedInstruction& instruction = page.instructions[address & 0xFF];
+		return instruction.handler ? &instruction : nullptr;
+	}
+
+	bool R6502::run_block(u64 target_cycle) {
+		if (_delay_change) return false; // An interrupt disable change lands at the end of the next instruction
+
+		_bus->set_cpu_cycle(_total_cycles);
+		const u8 irq_masked = GetFlag(StateFlags::I);
+		const u64 horizon = std::min(target_cycle, _bus->quiet_until(irq_masked));
+		if (horizon <= _total_cycles) return false;
+
+		const DecodedInstruction* instruction = decoded(_program_counter);
+		if (!instruction) return false;
+
+		const u64 device_accesses = _bus->device_accesses();
+		while (true) {
+			_opcode = instruction->opcode;
+			_program_counter += instruction->length;
+			const u8 length = instruction->length; // Before the handler, which may write over its own bytes and clear the entry
+			const bool chained = instruction->chained;
+			u8 cycles = instruction->cycles;
+			cycles += instruction->handler(*this, instruction->operand);
+#if CPU_TEST
+			--_instructions_count;
+#endif // CPU_TEST
+
+			if (_bus->device_accesses() != device_accesses) { // Sync point -> finished like step() does, the next instruction starts afresh
+				update_interrupt_disable();
+				_total_cycles += cycles + _bus->take_stall_cycles(_total_cycles + cycles);
+				return true;
+			}
+			_total_cycles += cycles;
+
+			if (chained) { // Neither branched nor touched the interrupt disable flag -> the next entry runs next
+				if (_total_cycles >= horizon) return true;
+				if (instruction[length].handler) {
+					instruction += length;
+					continue;
+				}
+			} else {
+				update_interrupt_disable();
+				if (_total_cycles >= horizon || _delay_change || GetFlag(StateFlags::I) != irq_masked) return true;
+			}
+			if (!(instruction = decoded(_program_counter))) return true; // Not decoded yet, or a handler page
+		}
+	}
+
+	void R6502::code_remapped(u16 first, u16 last) {
+		for (u32 page{ first }; page <= last; ++page) _code_pages[page] = nullptr;
+		if (first == 0x00 && last == 0xFF) _rom_code.clear(); // Page table rebuilt -> maybe another cartridge
+#if CPU_DYNAREC
+		if (_dynarec) _dynarec->remapped(first, last);
+#endif // CPU_DYNAREC
+	}
+
+	void R6502::code_ram_written(u16 first, u16 last) {
+		if (last - first >= 0x00FF) { // Bulk [state load, page table rebuilt] -> the RAM's decoded pages go, along with their watches
+			for (auto& ram : _ram_code) ram.reset();
+			code_remapped(0x00, 0x1F);
+			return;
+		}
+		for (u32 offset{ first }; offset <= last; ++offset) {
+			if (DecodedPage* page = _ram_code[offset >> 8].get()) {
+				const u32 byte = offset & 0xFF;
+				for (u32 start{ byte >= 2 ? byte - 2 : 0 }; start <= byte; ++start) { // Instructions are up to 3 bytes
+					page->instructions[start].handler = nullptr;
+				}
+			}
+		}
+	}
+#endif // CPU_INSTRUCTION_CACHE
+
+#if CPU_DYNAREC
+	/// Dynamic Recompiler ///
+
+	void R6502::set_dynarec(Dynarec::Mode mode) {
+		_dynarec_mode = mode;
+		if (mode == Dynarec::Mode::Off) {
+			_dynarec.reset();
+		} else if (!_dynarec && _bus) {
+			_dynarec = std::make_unique<Dynarec>(_bus);
+		}
+	}
+
+	// Runs the translated block at the program counter in place of step() | false -> nothing ran, step() takes the instruction
+	bool R6502::run_native(u64 target_cycle) {
+		const Dynarec::Block* block = _dynarec->find(_program_counter);
+		if (!block || _delay_change) return false; // An interrupt disable change lands at the end of the next instruction
+
+		// Every poll step() would make inside the block has to come out false without catching a device up
+		_bus->set_cpu_cycle(_total_cycles);
+		const u64 limit = std::min(target_cycle, _bus->quiet_until(GetFlag(StateFlags::I)));
+		if (limit <= _total_cycles || limit - _total_cycles < block->max_cycles) return false;
+
+		Dynarec::Context context;
+		context.read_memory = _bus->read_pages();
+		context.write_memory = _bus->write_pages();
+		context.budget = static_cast<u32>(std::min<u64>(limit - _total_cycles, UINT32_MAX));
+		context.program_counter = _program_counter;
+		context.accumulator = _accumulator;
+		context.x_register = _x_register;
+		context.y_register = _y_register;
+		context.stack_pointer = _stack_pointer;
+		context.status_register = _status_register;
+
+		if (_dynarec_mode == Dynarec::Mode::Verify) return verify_native(*block, context);
+
+		_dynarec->run(*block, context);
+		if (!context.instructions) return false; // Left before its first instruction [I/O or a watched page]
+
+		_program_counter = context.program_counter;
+		_accumulator = context.accumulator;
+		_x_register = context.x_register;
+		_y_register = context.y_register;
+		_stack_pointer = context.stack_pointer;
+		_status_register = context.status_register;
+		_total_cycles += context.cycles;
+		_dynarec->counters().native_instructions += context.instructions;
+		return true;
+	}
+
+	// Differential Run | The block runs, then the interpreter runs as many instructions from the state the block started from.
+	// The interpreter's result is kept either way, a block that disagrees [registers, program counter, cycles or RAM] is discarded.
+	bool R6502::verify_native(const Dynarec::Block& block, Dynarec::Context& context) {
+		u8* ram = _bus->get_ram()->data();
+		std::array<u8, 0x0800> before;
+		std::copy_n(ram, before.size(), before.begin());
+
+		_dynarec->run(block, context);
+		if (!context.instructions) return false;
+
+		// The block only wrote unwatched RAM -> putting it back needs no code watch
+		std::array<u8, 0x0800> native;
+		std::copy_n(ram, native.size(), native.begin());
+		std::copy(before.begin(), before.end(), ram);
+
+		const u64 start_cycle = _total_cycles;
+		for (u32 i{ 0 }; i < context.instructions; ++i) step();
+
+		Dynarec::Counters& counters = _dynarec->counters();
+		++counters.verified;
+		counters.native_instructions += context.instructions;
+		const bool same = _total_cycles - start_cycle == context.cycles && _program_counter == context.program_counter
+			&& _accumulator == context.accumulator && _x_register == context.x_register && _y_register == context.y_register
+			&& _stack_pointer == context.stack_pointer && _status_register == context.status_register
+			&& std::equal(native.begin(), native.end(), ram);
+		if (!same) {
+			if (!counters.mismatches++) counters.first_mismatch = block.address;
+			_dynarec->discard(block);
+		}
+		return true;
+	}
+#endif // CPU_DYNAREC
+}
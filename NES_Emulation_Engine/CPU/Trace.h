@@ -0,0 +1,140 @@
+#pragma once
+
+#include <concepts>
+#include <cstdio>
+#include <type_traits>
+
+#include "../Common/CommonHeaders.h"
+#include "OpcodeTable.h"
+
+// Execution Trace Hooks | R6502::step() is templated on a sink that sees every instruction it executes.
+// The sink's type decides at compile time whether anything is recorded: with NullTrace [the default everywhere]
+// the record is never built and the hook compiles to nothing, other sinks are opted into per call site.
+namespace NES::CPU {
+
+	// One Instruction | Registers are the state before it executed [like nestest.log], address and cycles are its outcome
+	struct TraceRecord {
+		u64		cycle{ 0 }; // Master cycle at the start of the instruction
+		u16		pc{ 0 };
+		u8		opcode{ 0 };
+		u8		operand[2]{}; // Bytes after the opcode, only the first length() - 1 are part of it
+		u8		a{ 0 };
+		u8		x{ 0 };
+		u8		y{ 0 };
+		u8		sp{ 0 };
+		u8		p{ 0 }; // Status flags
+		u16		address{ 0 }; // Effective address [operand modes only], branch target for taken branches
+		u16		cycles{ 0 }; // Including DMA stalls [OAM DMA alone is 513/514]
+
+		[[nodiscard]] constexpr AddressMode mode() const { return opcode_table[opcode].mode; }
+		[[nodiscard]] constexpr u8 length() const { return instruction_length(opcode); }
+	};
+
+	// Trace Sink | Anything callable with a record that says whether it wants records at all
+	template<typename Sink>
+	concept TraceSink = requires(std::remove_cvref_t<Sink>& sink, const TraceRecord& record) {
+		{ std::remove_cvref_t<Sink>::enabled } -> std::convertible_to<bool>;
+		sink(record);
+	};
+
+	template<typename Sink>
+	inline constexpr bool trace_enabled = std::remove_cvref_t<Sink>::enabled;
+
+	// No Tracing | The default sink, nothing is captured or called
+	struct NullTrace {
+		static constexpr bool enabled{ false };
+		void operator()(const TraceRecord&) const {}
+	};
+
+	// nestest.log Text | "C000  4C F5 C5  JMP $C5F5                       A:00 X:00 Y:00 P:24 SP:FD CYC:7"
+	// Same columns as the reference log minus the PPU position [the PPU runs lazily, the CPU does not know it], so a
+	// log can be diffed against it after cutting that column. Memory values ["= 00"] are left out, reading them could have side effects.
+	class TextTrace {
+	public:
+		static constexpr bool enabled{ true };
+
+		explicit TextTrace(std::FILE* out) : _out(out) {}
+
+		void operator()(const TraceRecord& record) const {
+			char bytes[9]{};
+			std::snprintf(bytes, sizeof(bytes), record.length() == 1 ? "%02X" : record.length() == 2 ? "%02X %02X" : "%02X %02X %02X",
+				record.opcode, record.operand[0], record.operand[1]);
+
+			std::fprintf(_out, "%04X  %-8s  %-4s%-27s A:%02X X:%02X Y:%02X P:%02X SP:%02X CYC:%llu\n", record.pc, bytes, opcode_name(record.opcode),
+				operand_text(record).c_str(), record.a, record.x, record.y, record.p, record.sp, static_cast<unsigned long long>(record.cycle));
+		}
+
+		[[nodiscard]] static std::string operand_text(const TraceRecord& record) {
+			const u16 word = record.operand[0] | (record.operand[1] << 8);
+			const u8 byte = record.operand[0];
+			const Operation operation = opcode_table[record.opcode].operation;
+
+			char text[16]{};
+			switch (record.mode()) {
+			case AddressMode::IMP: {
+				const bool accumulator = operation == Operation::ASL || operation == Operation::LSR || operation == Operation::ROL || operation == Operation::ROR;
+				return accumulator ? "A" : "";
+			}
+			case AddressMode::IMM: std::snprintf(text, sizeof(text), "#$%02X", byte); break;
+			case AddressMode::ZP0: std::snprintf(text, sizeof(text), "$%02X", byte); break;
+			case AddressMode::ZPX: std::snprintf(text, sizeof(text), "$%02X,X", byte); break;
+			case AddressMode::ZPY: std::snprintf(text, sizeof(text), "$%02X,Y", byte); break;
+			case AddressMode::REL: std::snprintf(text, sizeof(text), "$%04X", static_cast<u16>(record.pc + 2 + static_cast<s8>(byte))); break;
+			case AddressMode::ABS: std::snprintf(text, sizeof(text), "$%04X", word); break;
+			case AddressMode::ABX: std::snprintf(text, sizeof(text), "$%04X,X", word); break;
+			case AddressMode::ABY: std::snprintf(text, sizeof(text), "$%04X,Y", word); break;
+			case AddressMode::IND: std::snprintf(text, sizeof(text), "($%04X)", word); break;
+			case AddressMode::IZX: std::snprintf(text, sizeof(text), "($%02X,X)", byte); break;
+			case AddressMode::IZY: std::snprintf(text, sizeof(text), "($%02X),Y", byte); break;
+			default: break;
+			}
+			return text;
+		}
+
+	private:
+		std::FILE*	_out;
+	};
+
+	// Raw Binary | The records as fixed-size entries [host byte order], buffered and written in blocks.
+	// Two runs that should match can be compared byte for byte [cmp], the first differing offset / sizeof(Entry) is the instruction.
+	class BinaryTrace {
+	public:
+		static constexpr bool enabled{ true };
+
+#pragma pack(push, 1)
+		struct Entry { // 16 bytes
+			u32	cycle; // Low 32 bits of the master cycle
+			u16	pc;
+			u8	opcode;
+			u8	a, x, y, sp, p;
+			u16	address;
+			u16	cycles; // Operand bytes are left out, they are in the ROM
+		};
+#pragma pack(pop)
+		static_assert(sizeof(Entry) == 16);
+
+		explicit BinaryTrace(std::FILE* out) : _out(out) { _buffer.reserve(block_entries); }
+		~BinaryTrace() { flush(); }
+
+		BinaryTrace(const BinaryTrace&) = delete;
+		BinaryTrace& operator=(const BinaryTrace&) = delete;
+
+		void operator()(const TraceRecord& record) {
+			_buffer.push_back({ static_cast<u32>(record.cycle), record.pc, record.opcode, record.a, record.x, record.y, record.sp, record.p,
+				record.address, record.cycles });
+			if (_buffer.size() == block_entries) flush();
+		}
+
+		void flush() {
+			if (_buffer.empty()) return;
+			std::fwrite(_buffer.data(), sizeof(Entry), _buffer.size(), _out);
+			_buffer.clear();
+		}
+
+	private:
+		static constexpr u32 block_entries{ 4096 };
+
+		std::FILE*			_out;
+		std::vector<Entry>	_buffer;
+	};
+}
@@ -0,0 +1,250 @@
+#include <cstring>
+
+#include "TraceFile.h"
+
+namespace NES::CPU {
+	namespace {
+
+		// Entry Flags | What follows the opcode byte
+		enum EntryFlags : u8 {
+			Jumped = 1 << 0, // pc is not the previous instruction's fall-through address
+			ChangedA = 1 << 1,
+			ChangedX = 1 << 2,
+			ChangedY = 1 << 3,
+			ChangedSP = 1 << 4,
+			ChangedP = 1 << 5,
+			BaseCycles = 1 << 6, // The previous instruction took its opcode's base count, no delta stored
+		};
+
+		constexpr u32 max_pending{ 4 }; // Blocks queued before the emulation waits for the writer
+
+		void encode_entry(std::vector<u8>& out, const TraceEntry& previous, const TraceEntry& entry) {
+			const u64 delta = entry.cycle - previous.cycle;
+			u8 flags{ 0 };
+			if (entry.pc != static_cast<u16>(previous.pc + instruction_length(previous.opcode))) flags |= Jumped;
+			if (entry.a != previous.a) flags |= ChangedA;
+			if (entry.x != previous.x) flags |= ChangedX;
+			if (entry.y != previous.y) flags |= ChangedY;
+			if (entry.sp != previous.sp) flags |= ChangedSP;
+			if (entry.p != previous.p) flags |= ChangedP;
+			if (delta == opcode_table[previous.opcode].cycles) flags |= BaseCycles;
+
+			out.push_back(flags);
+			out.push_back(entry.opcode);
+			if (flags & Jumped) {
+				out.push_back(static_cast<u8>(entry.pc));
+				out.push_back(static_cast<u8>(entry.pc >> 8));
+			}
+			if (flags & ChangedA) out.push_back(entry.a);
+			if (flags & ChangedX) out.push_back(entry.x);
+			if (flags & ChangedY) out.push_back(entry.y);
+			if (flags & ChangedSP) out.push_back(entry.sp);
+			if (flags & ChangedP) out.push_back(entry.p);
+			if (!(flags & BaseCycles)) { // LEB128
+				u64 value = delta;
+				for (; value >= 0x80; value >>= 7) out.push_back(static_cast<u8>(value | 0x80));
+				out.push_back(static_cast<u8>(value));
+			}
+		}
+
+		bool decode_entry(const u8* data, u64 size, u64& position, const TraceEntry& previous, TraceEntry& entry) {
+			if (size - position < 2) return false;
+			const u8 flags = data[position++];
+			entry = previous;
+			entry.opcode = data[position++];
+			entry.pc = static_cast<u16>(previous.pc + instruction_length(previous.opcode));
+
+			if (flags & Jumped) {
+				if (size - position < 2) return false;
+				entry.pc = data[position] | (data[position + 1] << 8);
+				position += 2;
+			}
+			u8* const registers[] = { &entry.a, &entry.x, &entry.y, &entry.sp, &entry.p };
+			for (u32 i{ 0 }; i < 5; ++i) {
+				if (!(flags & (ChangedA << i))) continue;
+				if (position >= size) return false;
+				*registers[i] = data[position++];
+			}
+
+			if (flags & BaseCycles) {
+				entry.cycle = previous.cycle + opcode_table[previous.opcode].cycles;
+				return true;
+			}
+			u64 delta{ 0 };
+			for (u32 shift{ 0 }; ; shift += 7) {
+				if (position >= size || shift > 63) return false;
+				const u8 byte = data[position++];
+				delta |= static_cast<u64>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) break;
+			}
+			entry.cycle = previous.cycle + delta;
+			return true;
+		}
+
+	} // Anonymous Namespace
+
+	/// TRACE RECORDER ///
+
+	TraceRecorder::TraceRecorder(const std::string& path) {
+		_file = std::fopen(path.c_str(), "wb");
+		if (!_file) return;
+
+		trace_file::FileHeader header{};
+		std::memcpy(header.magic, trace_file::magic, sizeof(header.magic));
+		header.version = trace_file::version;
+		header.block_entries = block_entries;
+		std::fwrite(&header, sizeof(header), 1, _file);
+		_bytes_written = sizeof(header);
+
+		_current = std::make_unique<Block>(block_entries);
+		_block = _current->data();
+		_writer = std::thread(&TraceRecorder::write_loop, this);
+	}
+
+	void TraceRecorder::submit() {
+		std::unique_lock lock(_mutex);
+		_drained.wait(lock, [this] { return _pending.size() < max_pending; });
+
+		_pending.emplace_back(std::move(_current), _count);
+		_entries += _count;
+		_count = 0;
+		if (!_free.empty()) {
+			_current = std::move(_free.back());
+			_free.pop_back();
+		} else {
+			_current = std::make_unique<Block>(block_entries);
+		}
+		_block = _current->data();
+		lock.unlock();
+		_ready.notify_one();
+	}
+
+	void TraceRecorder::close() {
+		if (!_file) return;
+		if (_count) submit();
+		{
+			std::lock_guard lock(_mutex);
+			_closing = true;
+		}
+		_ready.notify_one();
+		_writer.join();
+
+		std::fclose(_file);
+		_file = nullptr;
+	}
+
+	void TraceRecorder::write_loop() {
+		Utilities::BlockCompressor compressor;
+		std::vector<u8> encoded;
+		std::vector<u8> payload;
+
+		while (true) {
+			std::unique_lock lock(_mutex);
+			_ready.wait(lock, [this] { return _closing || !_pending.empty(); });
+			if (_pending.empty()) return; // Closing and drained
+			auto [block, count] = std::move(_pending.front());
+			_pending.pop_front();
+			lock.unlock();
+
+			const TraceEntry* entries = block->data();
+			encoded.clear();
+			for (u32 i{ 1 }; i < count; ++i) encode_entry(encoded, entries[i - 1], entries[i]);
+			compressor.compress(encoded.data(), encoded.size(), payload);
+
+			trace_file::BlockHeader header{};
+			header.payload_size = static_cast<u32>(payload.size());
+			header.encoded_size = static_cast<u32>(encoded.size());
+			header.count = count;
+			header.last_cycle = entries[count - 1].cycle;
+			header.first = entries[0];
+			std::fwrite(&header, sizeof(header), 1, _file);
+			std::fwrite(payload.data(), 1, payload.size(), _file);
+			_bytes_written += sizeof(header) + payload.size();
+
+			lock.lock();
+			_free.push_back(std::move(block));
+			lock.unlock();
+			_drained.notify_one();
+		}
+	}
+
+	/// END ///
+
+	/// TRACE READER ///
+
+	TraceReader::~TraceReader() {
+		if (_file) std::fclose(_file);
+	}
+
+	bool TraceReader::open(const std::string& path) {
+		if (_file) std::fclose(_file);
+		_index.clear();
+		_entries = 0;
+		_decoded.clear();
+		_block = 0;
+		_position = 0;
+
+		if (!(_file = std::fopen(path.c_str(), "rb"))) return false;
+
+		trace_file::FileHeader header{};
+		if (std::fread(&header, sizeof(header), 1, _file) != 1 || std::memcmp(header.magic, trace_file::magic, sizeof(header.magic))
+			|| header.version != trace_file::version) return false;
+
+		u64 offset{ sizeof(header) };
+		trace_file::BlockHeader block{};
+		while (std::fread(&block, sizeof(block), 1, _file) == 1) {
+			offset += sizeof(block);
+			if (!block.count) return false;
+			_index.push_back({ offset, block });
+			_entries += block.count;
+			offset += block.payload_size;
+			if (std::fseek(_file, static_cast<long>(offset), SEEK_SET)) return false;
+		}
+		_file_size = offset;
+		return true;
+	}
+
+	bool TraceReader::seek(u64 cycle) {
+		// First block whose range reaches the cycle
+		const auto block = std::partition_point(_index.begin(), _index.end(), [cycle](const BlockInfo& info) { return info.header.last_cycle < cycle; });
+		if (block == _index.end() || !load_block(block - _index.begin())) return false;
+
+		const auto entry = std::partition_point(_decoded.begin(), _decoded.end(), [cycle](const TraceEntry& e) { return e.cycle < cycle; });
+		_position = entry - _decoded.begin();
+		return true;
+	}
+
+	bool TraceReader::next(TraceEntry& entry) {
+		if (_position == _decoded.size()) {
+			if (_block >= _index.size() || !load_block(_block)) return false;
+		}
+		entry = _decoded[_position++];
+		return true;
+	}
+
+	bool TraceReader::load_block(u64 block) {
+		const trace_file::BlockHeader& header = _index[block].header;
+		_payload.resize(header.payload_size);
+		_encoded.resize(header.encoded_size);
+		_decoded.clear();
+		_position = 0;
+
+		if (std::fseek(_file, static_cast<long>(_index[block].offset), SEEK_SET)
+			|| std::fread(_payload.data(), 1, _payload.size(), _file) != _payload.size()
+			|| !Utilities::BlockCompressor::decompress(_payload.data(), _payload.size(), _encoded.data(), _encoded.size())) return false;
+
+		_decoded.resize(header.count);
+		_decoded[0] = header.first;
+		u64 position{ 0 };
+		for (u32 i{ 1 }; i < header.count; ++i) {
+			if (!decode_entry(_encoded.data(), _encoded.size(), position, _decoded[i - 1], _decoded[i])) {
+				_decoded.clear();
+				return false;
+			}
+		}
+		_block = block + 1;
+		return true;
+	}
+
+	/// END ///
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "../Common/CommonHeaders.h"
+#include "../Utilities/BlockCompression.h"
+#include "Trace.h"
+
+// Compressed Execution Traces | Long captures for chasing desyncs, recorded at instruction boundaries through the trace sink hook.
+//
+// File -> [FileHeader] [Block]...
+// Block -> [BlockHeader: sizes, cycle range, first entry in full] [BlockCompressor payload of the encoded entries after the first]
+// Entry encoding -> against the entry before it: a flags byte, the opcode, then only what the flags say changed
+//   [pc when it is not the fall-through address, each register that changed, the cycle delta when it is not the opcode's base count].
+// Every block starts from a full entry, so a reader can seek to a cycle through the block headers and decode a single block.
+namespace NES::CPU {
+
+	// One Traced Instruction | State before it executed
+	struct TraceEntry {
+		u64	cycle{ 0 };
+		u16	pc{ 0 };
+		u8	opcode{ 0 };
+		u8	a{ 0 };
+		u8	x{ 0 };
+		u8	y{ 0 };
+		u8	sp{ 0 };
+		u8	p{ 0 };
+
+		bool operator==(const TraceEntry&) const = default;
+	};
+	static_assert(sizeof(TraceEntry) == 16);
+
+	namespace trace_file {
+		inline constexpr char magic[8]{ 'N', 'E', 'S', 'T', 'R', 'A', 'C', 'E' };
+		inline constexpr u32 version{ 1 };
+
+		struct FileHeader {
+			char	magic[8];
+			u32		version;
+			u32		block_entries; // Entries per full block
+		};
+
+		struct BlockHeader {
+			u32			payload_size; // Compressed bytes following the header
+			u32			encoded_size; // Bytes after decompression
+			u32			count; // Entries, the first one included
+			u32			reserved{ 0 };
+			u64			last_cycle;
+			TraceEntry	first;
+		};
+		static_assert(sizeof(BlockHeader) == 40);
+	}
+
+	// Trace Recorder | A trace sink: the emulation thread only copies 16 bytes per instruction into the current block,
+	// full blocks go to a background thread that delta-encodes, compresses and writes them.
+	// The writer never drops a block: when it falls more than a few blocks behind, the emulation waits for it.
+	class TraceRecorder {
+	public:
+		static constexpr bool enabled{ true };
+		static constexpr u32 block_entries{ 1 << 16 };
+
+		explicit TraceRecorder(const std::string& path);
+		~TraceRecorder() { close(); }
+
+		TraceRecorder(const TraceRecorder&) = delete;
+		TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+		[[nodiscard]] bool is_open() const { return _file != nullptr; }
+
+		void operator()(const TraceRecord& record) {
+			_block[_count++] = { record.cycle, record.pc, record.opcode, record.a, record.x, record.y, record.sp, record.p };
+			if (_count == block_entries) submit();
+		}
+
+		// Writes out what is buffered and waits for the writer | Called by the destructor
+		void close();
+
+		[[nodiscard]] u64 entries() const { return _entries + _count; }
+		[[nodiscard]] u64 bytes_written() const { return _bytes_written; } // Final once closed
+
+	private:
+		using Block = std::vector<TraceEntry>;
+
+		void submit(); // Hands the current block to the writer
+		void write_loop();
+
+		std::FILE*					_file{ nullptr };
+		std::unique_ptr<Block>		_current;
+		TraceEntry*					_block{ nullptr }; // _current's data
+		u32							_count{ 0 };
+		u64							_entries{ 0 }; // Submitted
+
+		std::mutex					_mutex;
+		std::condition_variable		_ready; // Writer wakes up
+		std::condition_variable		_drained; // Emulation wakes up
+		std::deque<std::pair<std::unique_ptr<Block>, u32>>	_pending; // Blocks with their entry counts
+		std::vector<std::unique_ptr<Block>>					_free;
+		bool						_closing{ false };
+		std::thread					_writer;
+
+		u64							_bytes_written{ 0 }; // Writer thread
+	};
+
+	// Trace Reader | Indexes the block headers on open, decodes one block at a time
+	class TraceReader {
+	public:
+		TraceReader() = default;
+		~TraceReader();
+
+		TraceReader(const TraceReader&) = delete;
+		TraceReader& operator=(const TraceReader&) = delete;
+
+		[[nodiscard]] bool open(const std::string& path);
+
+		// Positions at the first entry at or after cycle | false if there is none
+		[[nodiscard]] bool seek(u64 cycle);
+		// Next entry | false at the end or on a corrupt block
+		[[nodiscard]] bool next(TraceEntry& entry);
+
+		[[nodiscard]] u64 entries() const { return _entries; }
+		[[nodiscard]] u64 blocks() const { return _index.size(); }
+		[[nodiscard]] u64 file_size() const { return _file_size; }
+		[[nodiscard]] u64 first_cycle() const { return _index.empty() ? 0 : _index.front().header.first.cycle; }
+		[[nodiscard]] u64 last_cycle() const { return _index.empty() ? 0 : _index.back().header.last_cycle; }
+
+	private:
+		struct BlockInfo {
+			u64						offset; // Of the payload
+			trace_file::BlockHeader	header;
+		};
+
+		bool load_block(u64 block);
+
+		std::FILE*				_file{ nullptr };
+		std::vector<BlockInfo>	_index;
+		u64						_entries{ 0 };
+		u64						_file_size{ 0 };
+
+		std::vector<TraceEntry>	_decoded; // Current block
+		std::vector<u8>			_payload;
+		std::vector<u8>			_encoded;
+		u64						_block{ 0 }; // Index of the next block to load
+		u64						_position{ 0 }; // In _decoded
+	};
+}
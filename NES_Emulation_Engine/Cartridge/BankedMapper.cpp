@@ -0,0 +1,58 @@
+
+#include <bit>
+
+#include "BankedMapper.h"
+
+namespace NES::Cartridge {
+
+	BankedMapper::BankedMapper(const RomInfo& info) : Mapper(info.program_banks(), info.character_banks()) {
+		_program_banks_8k = static_cast<u32>(info.program_rom_size / 0x2000);
+		_character_ram = info.character_rom_size == 0;
+		_character_banks_1k = static_cast<u32>((_character_ram ? info.character_ram_size + info.character_nvram_size : info.character_rom_size) / 0x0400);
+
+		// Up to 8KB are visible through $6000-$7FFF, smaller chips are mirrored
+		const u64 program_ram_size = std::min<u64>(info.program_ram_size + info.program_nvram_size, 0x2000);
+		if (program_ram_size) {
+			_program_ram.assign(program_ram_size, 0x00);
+			_program_ram_mask = static_cast<u32>(std::bit_floor(program_ram_size) - 1);
+		}
+
+		// Power-up -> first banks everywhere, last PRG bank at $E000 so the CPU vectors are valid
+		for (u8 slot{ 0 }; slot < 4; ++slot) set_program_bank(slot, slot);
+		set_program_bank(3, -1);
+		for (u8 slot{ 0 }; slot < 8; ++slot) set_character_bank(slot, slot);
+	}
+
+	void BankedMapper::save_state(State& state) const {
+		Mapper::save_state(state);
+		state.program_bank = _program_bank;
+		state.character_bank = _character_bank;
+		std::copy(_program_ram.begin(), _program_ram.end(), state.program_ram.begin()); // At most 8KB
+	}
+
+	void BankedMapper::load_state(const State& state) {
+		Mapper::load_state(state);
+		_program_bank = state.program_bank;
+		_character_bank = state.character_bank;
+		std::copy_n(state.program_ram.begin(), _program_ram.size(), _program_ram.begin());
+	}
+
+	bool BankedMapper::cpuMapWrite(u16 address, u32& mapped_address, u8 data) {
+		if (address >= 0x8000) { // Bank Registers
+			const std::array<u32, 4> program_bank = _program_bank;
+			write_register(address, data);
+			mapped_address = mapper_handled;
+
+			if (program_bank != _program_bank) { // Only PRG bank changes invalidate the CPU Bus page table
+				bank_switched(0x8000, 0xFFFF);
+			}
+			return true;
+		}
+		if (address >= 0x6000 && program_ram_writable()) { // PRG-RAM
+			mapped_address = mapper_handled;
+			_program_ram[(address & 0x1FFF) & _program_ram_mask] = data;
+			return true;
+		}
+		return false;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "../Common/CommonHeaders.h"
+#include "Mapper.h"
+
+namespace NES::Cartridge {
+	// Base for the bank switching mappers | Bank registers are resolved into cached offsets when they are written,
+	// so cpuMapRead/ppuMapRead are a single table lookup no matter how the board arranges its banks.
+	// PRG is cached per 8KB slot [$8000-$FFFF -> 4 slots], CHR per 1KB slot [$0000-$1FFF -> 8 slots].
+	class BankedMapper : public Mapper {
+	public:
+		BankedMapper(const RomInfo& info);
+
+		static constexpr u64 min_program_rom{ 0x2000 }; // One 8KB slot, every slot wraps onto it
+
+		bool cpuMapRead(u16 address, u32& mapped_address, u8& data) override {
+			if (address >= 0x8000) { // PRG-ROM
+				mapped_address = _program_bank[(address >> 13) & 0x03] + (address & 0x1FFF);
+				return true;
+			}
+			if (address >= 0x6000 && program_ram_readable()) { // PRG-RAM
+				mapped_address = mapper_handled;
+				data = _program_ram[(address & 0x1FFF) & _program_ram_mask];
+				return true;
+			}
+			return false;
+		}
+
+		bool cpuMapWrite(u16 address, u32& mapped_address, u8 data) override;
+
+		bool ppuMapRead(u16 address, u32& mapped_address) override {
+			if (address <= 0x1FFF) { // Pattern Tables
+				mapped_address = _character_bank[address >> 10] + (address & 0x03FF);
+				return true;
+			}
+			return false;
+		}
+
+		bool ppuMapWrite(u16 address, u32& mapped_address) override {
+			if (address <= 0x1FFF && _character_ram) { // Pattern Tables | Only CHR-RAM is writable
+				mapped_address = _character_bank[address >> 10] + (address & 0x03FF);
+				return true;
+			}
+			return false;
+		}
+
+		[[nodiscard]] std::span<const u8> get_program_ram() const { return _program_ram; }
+
+		void save_state(State& state) const override;
+		void load_state(const State& state) override;
+
+	protected:
+		// Bank registers live at $8000-$FFFF on every board handled here
+		virtual void write_register(u16 address, u8 data) = 0;
+
+		// PRG-RAM Enable/Write Protect | Boards without a protect register leave it on
+		virtual bool program_ram_readable() const { return !_program_ram.empty(); }
+		virtual bool program_ram_writable() const { return !_program_ram.empty(); }
+
+		// Maps the 8KB PRG bank into the slot [$8000 + slot * 8KB] | Negative banks count from the last one [-1 -> last bank]
+		void set_program_bank(u8 slot, s32 bank) {
+			_program_bank[slot] = wrap(bank, _program_banks_8k) * 0x2000;
+		}
+
+		// Maps the 1KB CHR bank into the slot [slot * 1KB]
+		void set_character_bank(u8 slot, s32 bank) {
+			_character_bank[slot] = wrap(bank, _character_banks_1k) * 0x0400;
+		}
+
+		[[nodiscard]] u32 program_banks_8k() const { return _program_banks_8k; }
+		[[nodiscard]] u32 character_banks_1k() const { return _character_banks_1k; }
+
+	private:
+		// Bank numbers wrap around the ROM size, like the unconnected upper address lines on the board
+		static u32 wrap(s32 bank, u32 count) {
+			const s32 size = static_cast<s32>(count ? count : 1);
+			return static_cast<u32>(((bank % size) + size) % size);
+		}
+
+		std::array<u32, 4>		_program_bank{}; // Offsets into PRG-ROM for $8000, $A000, $C000, $E000
+		std::array<u32, 8>		_character_bank{}; // Offsets into CHR-ROM/CHR-RAM for each 1KB of the Pattern Tables
+
+		u32						_program_banks_8k{ 0 };
+		u32						_character_banks_1k{ 0 };
+		bool					_character_ram{ false };
+
+		std::vector<u8>			_program_ram; // PRG-RAM/WRAM at $6000-$7FFF | Battery backed on some boards
+		u32						_program_ram_mask{ 0 };
+	};
+}
@@ -1,125 +1,149 @@
-#include <filesystem>
-
 #include "Cartridge.h"
-#include "MapperTypes.h"
 
 namespace NES::Cartridge {
 
-	namespace {
-
-		bool check_ines_format(char* name) { return (name == "NES"); }
-
-		struct iNES_Header { // Format for iNES Header - 16 bytes
-			char name[4]; // is it needed? -> 4 bytes | NES<EOF> | check_id
-
-			u8 PRG_ROM_Count; // PRG-ROM division/banks
-			u8 CHR_ROM_Count; // CHR-ROM division/banks
-
-			// mapper[D0...D3] -> [4,5,6,7] bit | bit 3 -> alternate nametables | bit 2 -> has 512-byte trainer data | 
-			// bit 1 -> has battery or non-volatile memory | bit 0 -> Nametable Layout [vertical or horizontal] [Hardwired]
-			u8 flag_6;
-			// mapper[D4...D7] -> [4,5,6,7] bit | bit 2 and 3 -> NES 2.0 file format identifier | bit 0 and 1 -> Console Type
-			// 0 -> NES/Famicom, 1 -> Nintendo Vs. System, 2 -> Nintendo Playchoice 10, 3 -> Extended Console Type
-			u8 flag_7;
-
-			u8 program_ram_size;
-
-			u8 tv_system1;
-			u8 tv_system2;
-
-			char unused[5];
-		} header; 
-
-	} // anonymous namespace
-
 	// Writes Data to the Address Location on the Bus
 	void GameCard::cpu_write(u16 address, u8 data) {
 		assert(address > 0x401F);
-		u32 mapped_address{ 0 };
-		if (_mapper->cpuMapWrite(address, mapped_address)) {
-			_program_memory[mapped_address] = data;
-		}
+#if CARTRIDGE_STATIC_DISPATCH
+		visit_mapper([&](auto* mapper) { cpu_write(mapper, address, data); });
+#else
+		cpu_write(_mapper.get(), address, data);
+#endif // CARTRIDGE_STATIC_DISPATCH
 	}
 
 	// Reads Data from the Address Location on the Bus
 	u8 GameCard::cpu_read(u16 address) {
 		assert(address > 0x401F);
+#if CARTRIDGE_STATIC_DISPATCH
+		return visit_mapper([&](auto* mapper) { return cpu_read(mapper, address); });
+#else
+		return cpu_read(_mapper.get(), address);
+#endif // CARTRIDGE_STATIC_DISPATCH
+	}
+
+	// Host pointer to the 256-byte page of PRG-ROM mapped at the address
+	u8* GameCard::cpu_read_page(u16 address) {
 		u32 mapped_address{ 0 };
-		if (_mapper->cpuMapRead(address, mapped_address)) {
-			return _program_memory[mapped_address];
+		u8 data{ 0x00 };
+		if (_mapper->cpuMapRead(address & 0xFF00, mapped_address, data) && mapped_address != Mapper::mapper_handled && (u64{ mapped_address } + 0xFF) < _program_memory.size()) {
+			return &_program_memory[mapped_address];
 		}
-		return false;
+		return nullptr;
+	}
+
+	bool GameCard::save_state(State& state) const {
+		if (_character_ram.size() > state.character_ram.size()) return false;
+
+		_mapper->save_state(state.mapper);
+		state.character_ram_size = static_cast<u32>(_character_ram.size());
+		std::copy(_character_ram.begin(), _character_ram.end(), state.character_ram.begin());
+		return true;
+	}
+
+	bool GameCard::load_state(const State& state) {
+		if (state.character_ram_size != _character_ram.size()) return false;
+
+		_mapper->load_state(state.mapper);
+		std::copy_n(state.character_ram.begin(), _character_ram.size(), _character_ram.begin());
+		if (!_character_ram.empty()) _tile_cache->invalidate_all(); // Decoded from the CHR-RAM that was just replaced
+		return true;
+	}
+
+	std::shared_ptr<GameCard> GameCard::clone() const {
+		std::shared_ptr<Mapper> mapper = MapperRegistry::instance().create(_info);
+		if (!mapper) return nullptr;
+
+		auto card = std::make_shared<GameCard>();
+		card->set_cartridge_size(_size);
+		card->set_info(_info);
+		card->init_trainer(_trainer);
+		card->set_program_banks_count(_program_banks_count);
+		card->init_program_memory(_program_memory);
+		card->set_character_banks_count(_character_banks_count);
+		if (_character_ram.empty()) {
+			card->_character_memory = _character_memory;
+			card->_tile_cache = _tile_cache; // CHR-ROM is immutable -> decoded once for every copy
+		} else {
+			card->init_character_ram(static_cast<u32>(_character_ram.size()));
+			std::copy(_character_ram.begin(), _character_ram.end(), card->_character_ram.begin());
+		}
+
+		auto state = std::make_unique<Mapper::State>();
+		_mapper->save_state(*state);
+		mapper->load_state(*state);
+		card->set_mapper(std::move(mapper));
+		card->set_file(_file);
+		return card;
 	}
 
 	// Writes Data to the Address Location on the Bus
 	bool GameCard::ppu_write(u16 address, u8 data) {
-		u32 mapped_address{ 0 };
-		if (_mapper->ppuMapWrite(address, mapped_address)) {
-			_character_memory[mapped_address] = data;
-			return true;
-		}
-		return false;
+#if CARTRIDGE_STATIC_DISPATCH
+		return visit_mapper([&](auto* mapper) { return ppu_write(mapper, address, data); });
+#else
+		return ppu_write(_mapper.get(), address, data);
+#endif // CARTRIDGE_STATIC_DISPATCH
 	}
 
 	// Reads Data from the Address Location on the Bus
 	bool GameCard::ppu_read(u16 address, u8& data) {
-		u32 mapped_address{ 0 };
-		if (_mapper->ppuMapRead(address, mapped_address)) {
-			data = _character_memory[mapped_address];
-			return true;
-		}
-		return false;
+#if CARTRIDGE_STATIC_DISPATCH
+		return visit_mapper([&](auto* mapper) { return ppu_read(mapper, address, data); });
+#else
+		return ppu_read(_mapper.get(), address, data);
+#endif // CARTRIDGE_STATIC_DISPATCH
 	}
 
 	// for .NES files [iNES format]
+	// The file is mapped copy-on-write: PRG-ROM and CHR-ROM are read straight from the OS file cache and nothing is copied at load time.
+	// All state lives on the stack or in the GameCard, so different threads can load cartridges concurrently.
 	GameCard* load_file(std::string file) {
-		assert(std::filesystem::exists(file));
-
-		GameCard* card = new GameCard();
-		card->set_cartridge_size(std::filesystem::file_size(file));
-		{
-			std::ifstream reader(file, std::ios::binary);
-			if (reader.is_open()) {
-				reader.read((char*)&header, sizeof(iNES_Header));
-
-				assert(check_ines_format(header.name), "Not an INES/.NES format ROM!!");
-
-				// Trainer Area -> 512 bytes -> training information -> check bit 2 of flag 6
-				if (header.flag_6 & 0x04) {
-					// skip data/ advance read head | TODO: later read and store it.
-					reader.seekg(512, std::ios_base::cur); // seek 512 bytes from current position
-				}
-
-				u8 mapper_id = (header.flag_7 & 0xF0) | (header.flag_6 >> 4);
-				u8 format = (header.flag_7 & 0x0C) >> 2;
-
-				// Currently only use version 1.0
-				format = 1;
+		auto mapped = std::make_shared<NES::Utilities::MappedFile>();
+		if (!mapped->open(file)) return nullptr;
+
+		RomInfo info;
+		if (!parse_header({ mapped->data(), mapped->size() }, info)) return nullptr;
+
+		// Truncated ROM | Each region is checked against what is left of the file, NES 2.0 exponent sizes reach 7 * 2^61 and a sum of them wraps.
+		// Mapped addresses are 32-bit and bank counts 16-bit, anything larger is rejected as well.
+		if (info.program_rom_size > UINT32_MAX || info.character_rom_size > UINT32_MAX) return nullptr;
+		if (info.program_banks() != info.program_rom_size / 16384 || info.character_banks() != info.character_rom_size / 8192) return nullptr;
+		u64 end{ header_size };
+		for (const u64 size : { info.trainer ? u64{ trainer_size } : u64{ 0 }, info.program_rom_size, info.character_rom_size }) {
+			if (size > mapped->size() - end) return nullptr;
+			end += size;
+		}
 
-				switch (format) {
-				case 0: // version 0.0 ???
-					break;
+		// Mappers plug in through the registry, unknown ones are rejected before anything is built
+		std::shared_ptr<Mapper> mapper = MapperRegistry::instance().create(info);
+		if (!mapper) return nullptr;
 
-				case 1: // version 1.0
-					card->set_program_banks_count(header.PRG_ROM_Count);
-					card->init_program_memory(reader);
-					card->set_character_banks_count(header.CHR_ROM_Count);
-					card->init_character_memory(reader);
+		u64 offset{ header_size };
 
-					card->set_mapper(std::make_shared<NROM>(card->get_program_banks_count(), card->get_character_banks_count()));
-					break;
+		GameCard* card = new GameCard();
+		card->set_cartridge_size(mapped->size());
+		card->set_info(info);
 
-				case 2: // version 2.0
-					break;
+		// Trainer Area -> 512 bytes -> training information -> check bit 2 of flag 6
+		if (info.trainer) {
+			card->init_trainer({ mapped->data() + offset, trainer_size });
+			offset += trainer_size;
+		}
 
-				default:
-					assert(false, "How did you even manage to do it?");
-					break;
-				}
+		card->set_program_banks_count(info.program_banks());
+		card->init_program_memory({ mapped->data() + offset, info.program_rom_size });
+		offset += info.program_rom_size;
 
-				reader.close(); // End Read
-			}
+		card->set_character_banks_count(info.character_banks());
+		if (info.character_rom_size) {
+			card->init_character_memory({ mapped->data() + offset, info.character_rom_size });
+		} else {
+			card->init_character_ram(static_cast<u32>(info.character_ram_size + info.character_nvram_size));
 		}
+
+		card->set_mapper(std::move(mapper));
+		card->set_file(std::move(mapped));
 		return card;
 	}
-}
+}
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 
-#include <fstream>
+#include <span>
 
 #include "../Common/CommonHeaders.h"
+#include "../Utilities/MappedFile.h"
 #include "Mapper.h"
-#include "MapperTypes.h"
+#include "MapperRegistry.h"
+#include "MapperVariant.h"
+#include "RomInfo.h"
+#include "TileCache.h"
 
 
 namespace NES::Cartridge {
@@ -17,26 +21,56 @@ namespace NES::Cartridge {
 	public:
 
 
-		void init_program_memory(std::ifstream& reader){
-			_program_memory.resize(_program_banks_count * 16384); // Each Program ROM chip size is 16KB
-			reader.read((char*)_program_memory.data(), _program_memory.size());
+		// PRG-ROM and CHR-ROM reference the mapped file in place | Each Program ROM chip size is 16KB, each Character ROM chip size is 8KB
+		void init_program_memory(std::span<u8> memory) { _program_memory = memory; }
+		void init_character_memory(std::span<u8> memory) {
+			_character_memory = memory;
+			_tile_cache = std::make_shared<TileCache>();
+			_tile_cache->init(_character_memory);
 		}
 
-		void init_character_memory(std::ifstream& reader){
-			_character_memory.resize(_character_banks_count * 8192); // Each Character ROM chip size is 8KB
-			reader.read((char*)_character_memory.data(), _character_memory.size());
+		// Boards without CHR-ROM carry CHR-RAM instead, which is the only part of the cartridge owned by the GameCard
+		void init_character_ram(u32 size) {
+			_character_ram.assign(size, 0x00);
+			_character_memory = _character_ram;
+			_tile_cache = std::make_shared<TileCache>();
+			_tile_cache->init(_character_memory);
 		}
 
-		void set_program_banks_count(u8 count) { _program_banks_count = count; }
-		void set_character_banks_count(u8 count) { _character_banks_count = count; }
-		u8 get_program_banks_count() { return _program_banks_count; }
-		u8 get_character_banks_count() { return _character_banks_count; }
+		[[nodiscard]] std::span<const u8> get_program_memory() const { return _program_memory; }
+
+		// Trainer Area -> 512 bytes, empty if the ROM has none
+		void init_trainer(std::span<u8> trainer) { _trainer = trainer; }
+		[[nodiscard]] std::span<const u8> get_trainer() const { return _trainer; }
+
+		// Decoded iNES/NES 2.0 Header
+		void set_info(const RomInfo& info) { _info = info; _mapper_id = info.mapper_id; }
+		[[nodiscard]] const RomInfo& get_info() const { return _info; }
+
+		// Keeps the ROM file mapped for as long as the GameCard references it
+		void set_file(std::shared_ptr<NES::Utilities::MappedFile> file) { _file = std::move(file); }
+
+		void set_program_banks_count(u16 count) { _program_banks_count = count; }
+		void set_character_banks_count(u16 count) { _character_banks_count = count; }
+		u16 get_program_banks_count() { return _program_banks_count; }
+		u16 get_character_banks_count() { return _character_banks_count; }
 
 		void set_cartridge_size(u64 size) { _size = size; }
 
-		void set_mapper(std::shared_ptr<Mapper> map) { _mapper = map; }
+		void set_mapper(std::shared_ptr<Mapper> map) {
+			_mapper = map;
+			_mapper_view = bind_mapper(_mapper.get());
+		}
 		std::shared_ptr<Mapper> get_mapper() { return _mapper; }
 
+		// Static Dispatch | Calls the function with the concrete mapper [NROM*, MMC1*, ...], so hot loops can resolve the mapper once and
+		// use the mapper-typed accessors below for every access inside.
+		template<typename Function>
+		decltype(auto) visit_mapper(Function&& function) { return std::visit(std::forward<Function>(function), _mapper_view); }
+
+		// Host pointer to the 256-byte page of PRG-ROM mapped at the address, nullptr if the page is not plain PRG-ROM
+		[[nodiscard]] u8* cpu_read_page(u16 address);
+
 		// Writes Data to the Address Location on the Bus
 		void cpu_write(u16 address, u8 data);
 		// Reads Data from the Address Location on the Bus
@@ -47,18 +81,93 @@ namespace NES::Cartridge {
 		// Reads Data from the Address Location on the Bus
 		[[nodiscard]] bool ppu_read(u16 address, u8& data);
 
+		// Mapper-typed accessors | With a final mapper type the address mapping inlines, with Mapper* it is a virtual call
+		template<typename MapperType>
+		void cpu_write(MapperType* mapper, u16 address, u8 data) {
+			u32 mapped_address{ 0 };
+			if (mapper->cpuMapWrite(address, mapped_address, data) && mapped_address != Mapper::mapper_handled) {
+				_program_memory[mapped_address] = data;
+			}
+		}
+
+		template<typename MapperType>
+		[[nodiscard]] u8 cpu_read(MapperType* mapper, u16 address) {
+			u32 mapped_address{ 0 };
+			u8 data{ 0x00 };
+			if (mapper->cpuMapRead(address, mapped_address, data)) {
+				return mapped_address == Mapper::mapper_handled ? data : _program_memory[mapped_address];
+			}
+			return 0x00;
+		}
+
+		template<typename MapperType>
+		[[nodiscard]] bool ppu_write(MapperType* mapper, u16 address, u8 data) {
+			u32 mapped_address{ 0 };
+			if (mapper->ppuMapWrite(address, mapped_address)) {
+				_character_memory[mapped_address] = data;
+				_tile_cache->invalidate(mapped_address);
+				return true;
+			}
+			return false;
+		}
+
+		template<typename MapperType>
+		[[nodiscard]] bool ppu_read(MapperType* mapper, u16 address, u8& data) {
+			u32 mapped_address{ 0 };
+			if (mapper->ppuMapRead(address, mapped_address)) {
+				data = _character_memory[mapped_address];
+				return true;
+			}
+			return false;
+		}
+
+		// Independent copy for a second machine [run-ahead] | ROM, its decoded tiles and the mapped file are shared, the mapper and CHR-RAM are copied
+		// nullptr if the mapper cannot be rebuilt from the registry
+		[[nodiscard]] std::shared_ptr<GameCard> clone() const;
+
+		// Snapshot | Mapper registers, PRG-RAM and CHR-RAM | ROM is not part of it
+		static constexpr u32 max_character_ram{ 0x8000 };
+		struct State {
+			Mapper::State						mapper;
+			u32									character_ram_size; // 0 -> CHR-ROM board
+			std::array<u8, max_character_ram>	character_ram;
+		};
+		// false if the board carries more CHR-RAM than a snapshot holds
+		[[nodiscard]] bool save_state(State& state) const;
+		// false if the snapshot's CHR-RAM does not fit this board
+		[[nodiscard]] bool load_state(const State& state);
+
+		// Decoded row of a tile [TileCache] | address -> low bitplane byte of the row, $0000-$1FFF
+		template<typename MapperType>
+		[[nodiscard]] bool ppu_read_tile_row(MapperType* mapper, u16 address, u64& pixels) {
+			u32 mapped_address{ 0 };
+			if (mapper->ppuMapRead(address, mapped_address)) {
+				pixels = _tile_cache->row(mapped_address);
+				return true;
+			}
+			return false;
+		}
+
 	private:
-		std::vector<u8>				_program_memory; // PRG-ROM
-		std::vector<u8>				_character_memory; // CHR-ROM | CHR Memory | Pattern Memory
+		std::span<u8>				_program_memory; // PRG-ROM
+		std::span<u8>				_character_memory; // CHR-ROM | CHR Memory | Pattern Memory
+		std::vector<u8>				_character_ram; // CHR-RAM | Backs _character_memory when the cartridge has no CHR-ROM
+		std::shared_ptr<TileCache>	_tile_cache{ std::make_shared<TileCache>() }; // Decoded _character_memory | Shared by clones for CHR-ROM
+		std::span<u8>				_trainer;
+
+		std::shared_ptr<NES::Utilities::MappedFile>	_file; // .nes file mapped copy-on-write
 
-		u8							_mapper_id{ 0 }; // which mapper currently in use
+		RomInfo						_info;
+		u16							_mapper_id{ 0 }; // which mapper currently in use
 		std::shared_ptr<Mapper>		_mapper;
+		MapperVariant				_mapper_view; // Non-owning, concrete type of _mapper
 
-		u8							_program_banks_count{ 0 };
-		u8							_character_banks_count{ 0 };
+		u16							_program_banks_count{ 0 };
+		u16							_character_banks_count{ 0 };
 
 		u64							_size{ 0 };
 	};
 
+	// Maps the .nes file and builds the GameCard on top of it | nullptr if the file is missing, not a valid iNES/NES 2.0 ROM or needs an unregistered mapper
 	GameCard* load_file(std::string file);
 }
\ No newline at end of file
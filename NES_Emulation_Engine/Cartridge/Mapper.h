@@ -1,24 +1,65 @@
 #pragma once
 #include "../Common/CommonHeaders.h"
+#include "RomInfo.h"
 
 namespace NES::Cartridge {
 	class Mapper { // Abstract class as blueprint for other classes
 	public:
-		Mapper(u8 prg_banks, u8 chr_banks) : _program_banks_count{ prg_banks }, _character_banks_count{ chr_banks } {}
+		Mapper(u16 prg_banks, u16 chr_banks) : _program_banks_count{ prg_banks }, _character_banks_count{ chr_banks } {}
+
+		virtual ~Mapper() = default;
+
+		// mapped_address for accesses the mapper served itself [PRG-RAM, bank registers] -> data holds the result, PRG-ROM is not touched
+		static constexpr u32 mapper_handled{ 0xFFFFFFFF };
 
 		// Read/Write Functions, which transforms the address into the cartridge rom's address space.
-		virtual bool cpuMapRead(u16 address, u32 &mapped_address) = 0;
-		virtual bool cpuMapWrite(u16 address, u32 &mapped_address) = 0;
+		virtual bool cpuMapRead(u16 address, u32 &mapped_address, u8 &data) = 0;
+		virtual bool cpuMapWrite(u16 address, u32 &mapped_address, u8 data) = 0;
 		virtual bool ppuMapRead(u16 address, u32 &mapped_address) = 0;
 		virtual bool ppuMapWrite(u16 address, u32 &mapped_address) = 0;
 
-		[[nodiscard]] constexpr u8 get_program_banks_count() { return _program_banks_count; }
-		[[nodiscard]] constexpr u8 get_character_banks_count() { return _character_banks_count; }
+		// Scanline Counter | Clocked by the PPU once per rendered scanline [PPU A12 rising edge]
+		virtual void scanline() {}
+
+		// Cartridge IRQ Line | Level-sensitive, stays asserted until the mapper acknowledges it
+		[[nodiscard]] virtual bool has_irq() const { return false; } // Whether the board can pull the line at all
+		[[nodiscard]] virtual bool irq_state() const { return false; }
+		// Scanline counter clocks until the board pulls the line, 0 if it is pulled | UINT64_MAX -> not without a register write first
+		[[nodiscard]] virtual u64 scanlines_until_irq() const { return UINT64_MAX; }
+
+		[[nodiscard]] constexpr u16 get_program_banks_count() { return _program_banks_count; }
+		[[nodiscard]] constexpr u16 get_character_banks_count() { return _character_banks_count; }
+
+		// Nametable Layout | Hardwired from the header, mappers with mirroring control overwrite it
+		void set_mirroring(Mirroring mirroring) { _mirroring = mirroring; }
+		[[nodiscard]] Mirroring get_mirroring() const { return _mirroring; }
 
-		
+		// Snapshot | One layout for every board: the base classes fill their parts, boards pack their own registers into registers.
+		// Loading does not notify the bank switch callback, the CPU Bus refreshes its whole page table after a load.
+		struct State {
+			Mirroring				mirroring;
+			std::array<u8, 32>		registers;
+			std::array<u32, 4>		program_bank; // BankedMapper offsets
+			std::array<u32, 8>		character_bank;
+			std::array<u8, 0x2000>	program_ram;
+		};
+		virtual void save_state(State& state) const { state.mirroring = _mirroring; }
+		virtual void load_state(const State& state) { _mirroring = state.mirroring; }
+
+		// Bank Switch Notification | The CPU Bus refreshes its page table for the switched CPU address range [start, end]
+		void set_bank_switch_callback(std::function<void(u16, u16)> callback) { _bank_switch_callback = std::move(callback); }
+
+	protected:
+		void bank_switched(u16 start, u16 end) {
+			if (_bank_switch_callback) _bank_switch_callback(start, end);
+		}
 
 	private:
-		const u8					_program_banks_count;
-		const u8					_character_banks_count;
+		std::function<void(u16, u16)>	_bank_switch_callback;
+
+		const u16					_program_banks_count;
+		const u16					_character_banks_count;
+
+		Mirroring					_mirroring{ Mirroring::Horizontal };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "MapperRegistry.h"
+
+namespace NES::Cartridge {
+
+	// Function local static -> constructed on first use, so registration order between translation units does not matter
+	MapperRegistry& MapperRegistry::instance() {
+		static MapperRegistry registry;
+		return registry;
+	}
+
+	bool MapperRegistry::add(u16 mapper_id, const char* name, MapperFactory factory, u64 min_program_rom) {
+		assert(mapper_id < _entries.size() && !_entries[mapper_id].factory); // Two mappers registered under the same ID
+		if (mapper_id >= _entries.size()) return false;
+
+		_entries[mapper_id] = { name, factory, min_program_rom };
+		return true;
+	}
+
+	std::shared_ptr<Mapper> MapperRegistry::create(const RomInfo& info) const {
+		if (!supports(info.mapper_id)) return nullptr;
+		if (!info.program_rom_size || info.program_rom_size < _entries[info.mapper_id].min_program_rom) return nullptr; // No PRG-ROM at all, or less than one bank
+
+		std::shared_ptr<Mapper> mapper = _entries[info.mapper_id].factory(info);
+		mapper->set_mirroring(info.mirroring);
+		return mapper;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <type_traits>
+
+#include "../Common/CommonHeaders.h"
+#include "Mapper.h"
+#include "MapperVariant.h"
+#include "RomInfo.h"
+
+namespace NES::Cartridge {
+
+	using MapperFactory = std::shared_ptr<Mapper>(*)(const RomInfo& info);
+
+	// Mapper ID -> Factory | Mappers add themselves during static initialization [REGISTER_MAPPER], load_file only ever asks the registry.
+	// Registration finishes before main, after that the table is read-only and safe to use from any thread.
+	class MapperRegistry {
+	public:
+		static MapperRegistry& instance();
+
+		bool add(u16 mapper_id, const char* name, MapperFactory factory, u64 min_program_rom);
+
+		// Builds the mapper for the ROM | nullptr if no mapper is registered under its ID or the PRG-ROM is smaller than its smallest bank
+		[[nodiscard]] std::shared_ptr<Mapper> create(const RomInfo& info) const;
+
+		[[nodiscard]] bool supports(u16 mapper_id) const { return mapper_id < _entries.size() && _entries[mapper_id].factory; }
+		[[nodiscard]] const char* name(u16 mapper_id) const { return supports(mapper_id) ? _entries[mapper_id].name : "Unknown"; }
+
+	private:
+		MapperRegistry() = default;
+
+		struct Entry {
+			const char*		name{ nullptr };
+			MapperFactory	factory{ nullptr };
+			u64				min_program_rom{ 0 };
+		};
+
+		std::array<Entry, 4096>	_entries{}; // NES 2.0 mapper numbers are 12 bits
+	};
+
+	// Mappers that need more than the bank counts [mirroring, submapper, RAM sizes] take the whole RomInfo in their constructor
+	template<typename T>
+	std::shared_ptr<Mapper> make_mapper(const RomInfo& info) {
+		if constexpr (std::is_constructible_v<T, const RomInfo&>) {
+			return std::make_shared<T>(info);
+		} else {
+			return std::make_shared<T>(info.program_banks(), info.character_banks());
+		}
+	}
+
+	// Smallest PRG-ROM the board maps without reading past its end | A static min_program_rom in the mapper class, one 16KB bank otherwise
+	template<typename T>
+	constexpr u64 min_program_rom() {
+		if constexpr (requires { T::min_program_rom; }) {
+			return T::min_program_rom;
+		} else {
+			return 0x4000;
+		}
+	}
+}
+
+// Registers a Mapper class under its iNES/NES 2.0 number | Use once, at namespace scope of the mapper's .cpp
+// The class has to be listed in Cartridge::Mappers too [MapperTypes.h], otherwise GameCard could only reach it through the vtable.
+#define REGISTER_MAPPER(mapper_id, type) \
+	static_assert(::NES::Cartridge::listed_mapper<type>, #type " is missing from Cartridge::Mappers [MapperTypes.h]"); \
+	namespace { [[maybe_unused]] const bool type##_registered = ::NES::Cartridge::MapperRegistry::instance().add(mapper_id, #type, &::NES::Cartridge::make_mapper<type>, \
+		::NES::Cartridge::min_program_rom<type>()); }
@@ -1,3 +1,16 @@
 #pragma once
 
-#include "iNES1.0/M_000_NROM.h"
\ No newline at end of file
+#include "iNES1.0/M_000_NROM.h"
+#include "iNES1.0/M_001_MMC1.h"
+#include "iNES1.0/M_002_UxROM.h"
+#include "iNES1.0/M_003_CNROM.h"
+#include "iNES1.0/M_004_MMC3.h"
+
+namespace NES::Cartridge {
+
+	template<typename... Types>
+	struct MapperList {};
+
+	// Every mapper class, in one place | MapperVariant is built from it and REGISTER_MAPPER refuses a type that is missing here
+	using Mappers = MapperList<NROM, MMC1, UxROM, CNROM, MMC3>;
+}
\ No newline at end of file
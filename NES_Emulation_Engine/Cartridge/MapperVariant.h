@@ -0,0 +1,48 @@
+#pragma once
+
+#include <variant>
+
+#include "../Common/CommonHeaders.h"
+#include "MapperTypes.h"
+
+namespace NES::Cartridge {
+
+	namespace detail {
+		template<typename List>
+		struct mapper_variant;
+		template<typename... Types>
+		struct mapper_variant<MapperList<Types...>> { using type = std::variant<Mapper*, Types*...>; };
+
+		template<typename Type, typename List>
+		struct listed_mapper;
+		template<typename Type, typename... Types>
+		struct listed_mapper<Type, MapperList<Types...>> : std::bool_constant<(std::is_same_v<Type, Types> || ...)> {};
+	} // detail namespace
+
+	// Static Dispatch | The concrete mapper behind a GameCard, resolved once at load, one alternative per class in Mappers [MapperTypes.h].
+	// Visiting with a generic lambda instantiates the lambda per mapper: the mapper classes are final, so their cpuMapRead/ppuMapRead inline
+	// into the caller instead of going through the vtable. Mapper* only holds a GameCard built without a registered mapper.
+	using MapperVariant = detail::mapper_variant<Mappers>::type;
+
+	template<typename Type>
+	inline constexpr bool listed_mapper = detail::listed_mapper<Type, Mappers>::value;
+
+	namespace detail {
+		template<typename First, typename... Rest>
+		MapperVariant bind_mapper(Mapper* mapper) {
+			if (First* concrete = dynamic_cast<First*>(mapper)) return concrete;
+			if constexpr (sizeof...(Rest) > 0) {
+				return bind_mapper<Rest...>(mapper);
+			} else {
+				return mapper;
+			}
+		}
+
+		template<typename... Types>
+		MapperVariant bind_mapper(Mapper* mapper, MapperList<Types...>) { return bind_mapper<Types...>(mapper); }
+	} // detail namespace
+
+	[[nodiscard]] inline MapperVariant bind_mapper(Mapper* mapper) {
+		return detail::bind_mapper(mapper, Mappers{});
+	}
+}
@@ -0,0 +1,127 @@
+#include <cstring>
+
+#include "RomInfo.h"
+
+namespace NES::Cartridge {
+
+	namespace {
+
+		struct iNES_Header { // Format for iNES Header - 16 bytes
+			char name[4]; // 4 bytes | NES<EOF> | check_id
+
+			u8 PRG_ROM_Count; // PRG-ROM division/banks | LSB of the size on NES 2.0
+			u8 CHR_ROM_Count; // CHR-ROM division/banks | LSB of the size on NES 2.0
+
+			// mapper[D0...D3] -> [4,5,6,7] bit | bit 3 -> alternate nametables | bit 2 -> has 512-byte trainer data | 
+			// bit 1 -> has battery or non-volatile memory | bit 0 -> Nametable Layout [vertical or horizontal] [Hardwired]
+			u8 flag_6;
+			// mapper[D4...D7] -> [4,5,6,7] bit | bit 2 and 3 -> NES 2.0 file format identifier | bit 0 and 1 -> Console Type
+			u8 flag_7;
+
+			// iNES -> PRG-RAM size in 8KB units | NES 2.0 -> mapper[D8...D11] -> [0,1,2,3] bit | submapper -> [4,5,6,7] bit
+			u8 flag_8;
+			// iNES -> bit 0 TV System | NES 2.0 -> PRG-ROM size MSB -> [0,1,2,3] bit | CHR-ROM size MSB -> [4,5,6,7] bit
+			u8 flag_9;
+
+			// NES 2.0 only from here on
+			u8 program_ram_shift; // PRG-RAM -> [0,1,2,3] bit | PRG-NVRAM -> [4,5,6,7] bit | 64 << shift bytes
+			u8 character_ram_shift; // CHR-RAM -> [0,1,2,3] bit | CHR-NVRAM -> [4,5,6,7] bit | 64 << shift bytes
+			u8 timing; // CPU/PPU Timing -> [0,1] bit
+			u8 console_type; // Vs. System Type or Extended Console Type
+			u8 misc_roms; // Number of Miscellaneous ROMs -> [0,1] bit
+			u8 expansion_device; // Default Expansion Device -> [0...5] bit
+		};
+		static_assert(sizeof(iNES_Header) == header_size);
+
+		bool check_ines_format(const iNES_Header& header) { return std::memcmp(header.name, "NES\x1A", 4) == 0; }
+
+		// NES 2.0 ROM size | MSB nibble 0xF switches to exponent-multiplier notation -> 2^E * (MM * 2 + 1)
+		u64 rom_size(u8 lsb, u8 msb, u64 unit) {
+			if (msb == 0x0F) {
+				const u8 exponent = lsb >> 2;
+				const u8 multiplier = lsb & 0x03;
+				return exponent < 62 ? (u64{ 1 } << exponent) * (multiplier * 2 + 1) : 0; // Anything above 2^61 cannot be a real file
+			}
+			return ((static_cast<u64>(msb) << 8) | lsb) * unit;
+		}
+
+		// NES 2.0 RAM size | 0 means none, otherwise 64 << shift bytes
+		u64 ram_size(u8 shift) { return shift ? (u64{ 64 } << shift) : 0; }
+
+	} // anonymous namespace
+
+	bool parse_header(std::span<const u8> file, RomInfo& info) {
+		if (file.size() < sizeof(iNES_Header)) return false;
+
+		iNES_Header header{};
+		std::memcpy(&header, file.data(), sizeof(iNES_Header));
+
+		if (!check_ines_format(header)) return false; // Not an INES/.NES format ROM!!
+
+		info = RomInfo{};
+
+		switch ((header.flag_7 & 0x0C) >> 2) {
+		case 0: // Bytes 12-15 must be zero, otherwise something like "DiskDude!" was written over them
+			info.format = (header.timing | header.console_type | header.misc_roms | header.expansion_device) ? RomFormat::ArchaicINES : RomFormat::INES;
+			break;
+		case 2:
+			info.format = RomFormat::NES20;
+			break;
+		default:
+			info.format = RomFormat::ArchaicINES;
+			break;
+		}
+
+		info.battery = header.flag_6 & 0x02;
+		info.trainer = header.flag_6 & 0x04;
+		info.mirroring = (header.flag_6 & 0x08) ? Mirroring::FourScreen : ((header.flag_6 & 0x01) ? Mirroring::Vertical : Mirroring::Horizontal);
+
+		info.mapper_id = header.flag_6 >> 4;
+
+		switch (info.format) {
+		case RomFormat::ArchaicINES: // Only the lower nibble of the mapper is trustworthy
+			info.program_rom_size = header.PRG_ROM_Count * u64{ 16384 };
+			info.character_rom_size = header.CHR_ROM_Count * u64{ 8192 };
+			info.program_ram_size = 8192;
+			break;
+
+		case RomFormat::INES:
+			info.mapper_id |= header.flag_7 & 0xF0;
+			info.console = static_cast<ConsoleType>(header.flag_7 & 0x03);
+
+			info.program_rom_size = header.PRG_ROM_Count * u64{ 16384 };
+			info.character_rom_size = header.CHR_ROM_Count * u64{ 8192 };
+
+			// 0 -> 8KB for compatibility | iNES has no way to tell volatile and battery backed RAM apart
+			(info.battery ? info.program_nvram_size : info.program_ram_size) = (header.flag_8 ? header.flag_8 : 1) * u64{ 8192 };
+			info.timing = (header.flag_9 & 0x01) ? Timing::PAL : Timing::NTSC;
+			break;
+
+		case RomFormat::NES20:
+			info.mapper_id |= (header.flag_7 & 0xF0) | ((header.flag_8 & 0x0F) << 8);
+			info.submapper = header.flag_8 >> 4;
+			info.console = static_cast<ConsoleType>(header.flag_7 & 0x03);
+
+			info.program_rom_size = rom_size(header.PRG_ROM_Count, header.flag_9 & 0x0F, 16384);
+			info.character_rom_size = rom_size(header.CHR_ROM_Count, header.flag_9 >> 4, 8192);
+
+			info.program_ram_size = ram_size(header.program_ram_shift & 0x0F);
+			info.program_nvram_size = ram_size(header.program_ram_shift >> 4);
+			info.character_ram_size = ram_size(header.character_ram_shift & 0x0F);
+			info.character_nvram_size = ram_size(header.character_ram_shift >> 4);
+
+			info.timing = static_cast<Timing>(header.timing & 0x03);
+			info.extended_console = header.console_type;
+			info.misc_roms = header.misc_roms & 0x03;
+			info.expansion_device = header.expansion_device & 0x3F;
+			break;
+		}
+
+		// Boards without CHR-ROM carry 8KB of CHR-RAM unless NES 2.0 says otherwise
+		if (info.format != RomFormat::NES20 && info.character_rom_size == 0) {
+			info.character_ram_size = 8192;
+		}
+
+		return true;
+	}
+}
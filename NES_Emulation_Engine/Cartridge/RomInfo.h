@@ -0,0 +1,54 @@
+#pragma once
+
+#include <span>
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::Cartridge {
+
+	// Header flavours | (flag_7 & 0x0C) -> 0 = iNES, 2 = NES 2.0, anything else is an archaic iNES file with junk in bytes 7-15
+	enum class RomFormat : u8 { ArchaicINES, INES, NES20 };
+
+	enum class Mirroring : u8 { Horizontal, Vertical, FourScreen, SingleScreenLow, SingleScreenHigh };
+
+	// 0 -> NES/Famicom, 1 -> Nintendo Vs. System, 2 -> Nintendo Playchoice 10, 3 -> Extended Console Type [byte 13]
+	enum class ConsoleType : u8 { NES, VsSystem, Playchoice10, Extended };
+
+	enum class Timing : u8 { NTSC, PAL, MultiRegion, Dendy };
+
+	// Everything the loader and the mappers need to know about a .nes file, decoded from its 16-byte header
+	struct RomInfo {
+		RomFormat	format{ RomFormat::INES };
+
+		u16			mapper_id{ 0 }; // 12 bits on NES 2.0, 8 bits on iNES, 4 bits on archaic iNES
+		u8			submapper{ 0 }; // NES 2.0 only
+
+		u64			program_rom_size{ 0 };
+		u64			character_rom_size{ 0 };
+		u64			program_ram_size{ 0 }; // Volatile PRG-RAM
+		u64			program_nvram_size{ 0 }; // Battery backed PRG-RAM
+		u64			character_ram_size{ 0 };
+		u64			character_nvram_size{ 0 };
+
+		bool		battery{ false };
+		bool		trainer{ false }; // 512 bytes between the header and PRG-ROM, loaded at $7000
+		Mirroring	mirroring{ Mirroring::Horizontal }; // Hardwired Nametable Layout
+
+		ConsoleType	console{ ConsoleType::NES };
+		u8			extended_console{ 0 }; // Vs. System PPU/Hardware type or Extended Console Type [byte 13]
+		Timing		timing{ Timing::NTSC };
+
+		u8			misc_roms{ 0 };
+		u8			expansion_device{ 0 };
+
+		// Size of a PRG-ROM bank is 16KB, of a CHR-ROM bank 8KB
+		[[nodiscard]] u16 program_banks() const { return static_cast<u16>(program_rom_size / 16384); }
+		[[nodiscard]] u16 character_banks() const { return static_cast<u16>(character_rom_size / 8192); }
+	};
+
+	constexpr u64 header_size{ 16 };
+	constexpr u64 trainer_size{ 512 };
+
+	// Decodes an iNES/NES 2.0 header | false if the file is too short or the magic number is missing
+	[[nodiscard]] bool parse_header(std::span<const u8> file, RomInfo& info);
+}
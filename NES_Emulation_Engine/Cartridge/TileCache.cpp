@@ -0,0 +1,39 @@
+#include "TileCache.h"
+#include "../PPU/TileDecoder.h"
+
+namespace NES::Cartridge {
+
+	void TileCache::init(std::span<const u8> memory) {
+		_memory = memory;
+		_page_count = static_cast<u32>((memory.size() + page_size - 1) / page_size);
+		_pages = std::make_unique<Page[]>(_page_count);
+	}
+
+	// The 8 low bitplane bytes of a tile are followed by its 8 high ones, so each tile is one 8-row call to the SIMD decoder
+	u64 TileCache::decode_row(u32 offset) {
+		constexpr u8 no_palette[8]{}; // Keeps the bare 2-bit pattern
+
+		const u32 tile = offset & ~0x0Fu;
+		Page& page = _pages[offset / page_size];
+		u8 expected{ empty };
+		if (!page.state.compare_exchange_strong(expected, decoding, std::memory_order_acquire)) {
+			u8 pixels[64]; // Claimed by another thread [or a page being published] -> this row alone, from the memory it reads too
+			NES::PPU::decode_tile_rows(&_memory[tile], &_memory[tile + 8], no_palette, 8, pixels);
+			u64 row;
+			std::memcpy(&row, &pixels[(offset & 0x07) * 8], sizeof(row));
+			return row;
+		}
+
+		if (!page.pixels) page.pixels = std::make_unique<u8[]>(page_size * 4);
+		const u32 start = (offset / page_size) * page_size;
+		const u32 end = std::min<u32>(start + page_size, static_cast<u32>(_memory.size()));
+		for (u32 first = start; first + 16 <= end; first += 16) {
+			NES::PPU::decode_tile_rows(&_memory[first], &_memory[first + 8], no_palette, 8, &page.pixels[(first - start) * 4]);
+		}
+		page.state.store(ready, std::memory_order_release);
+
+		u64 row;
+		std::memcpy(&row, &page.pixels[((offset % page_size) >> 4) * 64 + (offset & 0x07) * 8], sizeof(row));
+		return row;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <span>
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::Cartridge {
+
+	// Pre-decoded CHR | Every tile row of the character memory as 8 pixels of 2-bit pattern indices, one byte each, pixel 0 first.
+	// Indexed by the offset into CHR memory, not by PPU address: a bank switch only changes which rows the mapper points at, nothing is rebuilt.
+	// Pages of 1KB [64 tiles, 4KB decoded] are allocated and decoded the first time they are read, a write to CHR-RAM drops the page it lands in.
+	//
+	// Sharing -> CHR-ROM never changes, so one cache serves every clone of a GameCard [run-ahead, console fanout], also from other threads.
+	// A page is claimed by the first reader and published when it is done, a reader that finds it claimed decodes its one row itself.
+	// CHR-RAM caches belong to a single GameCard and are only touched by the thread running it.
+	class TileCache {
+	public:
+		static constexpr u32 page_size{ 1024 };
+
+		void init(std::span<const u8> memory);
+
+		// Row of a tile | offset -> CHR offset of the row's low bitplane byte [tile * 16 + row]
+		[[nodiscard]] u64 row(u32 offset) {
+			const Page& page = _pages[offset / page_size];
+			if (page.state.load(std::memory_order_acquire) != ready) return decode_row(offset);
+
+			u64 pixels;
+			std::memcpy(&pixels, &page.pixels[((offset % page_size) >> 4) * 64 + (offset & 0x07) * 8], sizeof(pixels));
+			return pixels;
+		}
+
+		void invalidate(u32 offset) { _pages[offset / page_size].state.store(empty, std::memory_order_relaxed); }
+		void invalidate_all() { for (u32 page{ 0 }; page < _page_count; ++page) _pages[page].state.store(empty, std::memory_order_relaxed); }
+
+	private:
+		static constexpr u8 empty{ 0 }, decoding{ 1 }, ready{ 2 };
+
+		struct Page {
+			std::atomic<u8>			state{ empty };
+			std::unique_ptr<u8[]>	pixels; // 64 bytes per tile, allocated on first decode and kept
+		};
+
+		[[nodiscard]] u64 decode_row(u32 offset); // Decodes the row's page if nobody else is, else just the row
+
+		std::span<const u8>		_memory; // CHR-ROM or CHR-RAM of the GameCard
+		std::unique_ptr<Page[]>	_pages;
+		u32						_page_count{ 0 };
+	};
+}
@@ -2,14 +2,38 @@
 #include "../Mapper.h"
 
 namespace NES::Cartridge {
-	class NROM : public Mapper {
+	// final + inline mapping -> calls through a concrete NROM* [MapperVariant] inline into the caller
+	class NROM final : public Mapper {
 	public:
-		NROM(u8 prg_banks, u8 chr_banks) : Mapper(prg_banks, chr_banks) {} // to execute the Parameterized Constructor of Base class execute the Parameterized Constructor of Base class 
+		NROM(u16 prg_banks, u16 chr_banks) : Mapper(prg_banks, chr_banks) {} // to execute the Parameterized Constructor of Base class execute the Parameterized Constructor of Base class 
 
-		bool cpuMapRead(u16 address, u32& mapped_address) override;
-		bool cpuMapWrite(u16 address, u32& mapped_address) override;
-		bool ppuMapRead(u16 address, u32& mapped_address) override;
-		bool ppuMapWrite(u16 address, u32& mapped_address) override;
+		bool cpuMapRead(u16 address, u32& mapped_address, u8& data) override {
+			if (address >= 0x8000 && address <= 0xFFFF) { // Dedicated Address Space For Cartridge Use
+				mapped_address = address & (get_program_banks_count() > 1 ? 0x7FFF : 0x3FFF); // More than 1 bank -> 32KB ROM | 16KB ROM is mirrored
+				return true;
+			}
+			return false;
+		}
+
+		bool cpuMapWrite(u16 address, u32& mapped_address, u8 data) override {
+			return false; // No registers and PRG-ROM is read-only
+		}
+
+		bool ppuMapRead(u16 address, u32& mapped_address) override {
+			if (address >= 0x0000 && address <= 0x1FFF) { // Pattern Tables
+				mapped_address = address;
+				return true;
+			}
+			return false;
+		}
+
+		bool ppuMapWrite(u16 address, u32& mapped_address) override {
+			if (address >= 0x0000 && address <= 0x1FFF && get_character_banks_count() == 0) { // Pattern Tables | Only CHR-RAM is writable
+				mapped_address = address;
+				return true;
+			}
+			return false;
+		}
 	private:
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,98 @@
+#include "M_001_MMC1.h"
+#include "../MapperRegistry.h"
+
+namespace NES::Cartridge {
+
+	REGISTER_MAPPER(1, MMC1)
+
+	MMC1::MMC1(const RomInfo& info) : BankedMapper(info) {
+		update_banks();
+	}
+
+	void MMC1::save_state(State& state) const {
+		BankedMapper::save_state(state);
+		state.registers[0] = _shift_register;
+		state.registers[1] = _control;
+		state.registers[2] = _character_bank_0;
+		state.registers[3] = _character_bank_1;
+		state.registers[4] = _program_bank_register;
+	}
+
+	void MMC1::load_state(const State& state) {
+		BankedMapper::load_state(state);
+		_shift_register = state.registers[0];
+		_control = state.registers[1];
+		_character_bank_0 = state.registers[2];
+		_character_bank_1 = state.registers[3];
+		_program_bank_register = state.registers[4];
+	}
+
+	// $8000-$FFFF -> Load Register | Bit 7 resets the shift register, the fifth write picks the target register with address bits 13-14
+	void MMC1::write_register(u16 address, u8 data) {
+		if (data & 0x80) {
+			_shift_register = 0x10;
+			_control |= 0x0C;
+			update_banks();
+			return;
+		}
+
+		const bool full = _shift_register & 0x01;
+		_shift_register = (_shift_register >> 1) | ((data & 0x01) << 4);
+		if (!full) return;
+
+		const u8 value = _shift_register;
+		_shift_register = 0x10;
+
+		switch ((address >> 13) & 0x03) {
+		case 0: _control = value; break; // $8000 Control
+		case 1: _character_bank_0 = value; break; // $A000 CHR bank 0
+		case 2: _character_bank_1 = value; break; // $C000 CHR bank 1
+		case 3: _program_bank_register = value; break; // $E000 PRG bank | bit 4 -> PRG-RAM disable
+		}
+		update_banks();
+	}
+
+	void MMC1::update_banks() {
+		switch (_control & 0x03) { // Mirroring
+		case 0: set_mirroring(Mirroring::SingleScreenLow); break;
+		case 1: set_mirroring(Mirroring::SingleScreenHigh); break;
+		case 2: set_mirroring(Mirroring::Vertical); break;
+		case 3: set_mirroring(Mirroring::Horizontal); break;
+		}
+
+		// SUROM/SXROM | 512KB PRG-ROM -> CHR bank bit 4 selects the 256KB half
+		const s32 outer = (program_banks_8k() > 32) ? (_character_bank_0 & 0x10) * 2 : 0; // in 8KB banks
+		const s32 bank = outer + (_program_bank_register & 0x0F) * 2;
+		const s32 last = outer + 30; // Last 16KB of the current 256KB half
+
+		switch ((_control >> 2) & 0x03) { // PRG-ROM Bank Mode
+		case 0:
+		case 1: // 32KB at $8000, low bit of the bank number ignored
+			for (u8 slot{ 0 }; slot < 4; ++slot) set_program_bank(slot, (bank & ~0x03) + slot);
+			break;
+		case 2: // First bank fixed at $8000, 16KB switchable at $C000
+			set_program_bank(0, outer);
+			set_program_bank(1, outer + 1);
+			set_program_bank(2, bank);
+			set_program_bank(3, bank + 1);
+			break;
+		case 3: // 16KB switchable at $8000, last bank fixed at $C000
+			set_program_bank(0, bank);
+			set_program_bank(1, bank + 1);
+			set_program_bank(2, program_banks_8k() > 32 ? last : -2);
+			set_program_bank(3, program_banks_8k() > 32 ? last + 1 : -1);
+			break;
+		}
+
+		if (_control & 0x10) { // Two separate 4KB CHR banks
+			for (u8 slot{ 0 }; slot < 4; ++slot) {
+				set_character_bank(slot, _character_bank_0 * 4 + slot);
+				set_character_bank(slot + 4, _character_bank_1 * 4 + slot);
+			}
+		} else { // One 8KB CHR bank, low bit ignored
+			for (u8 slot{ 0 }; slot < 8; ++slot) {
+				set_character_bank(slot, (_character_bank_0 & 0x1E) * 4 + slot);
+			}
+		}
+	}
+}
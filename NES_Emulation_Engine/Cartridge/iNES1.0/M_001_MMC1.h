@@ -0,0 +1,28 @@
+#pragma once
+#include "../BankedMapper.h"
+
+namespace NES::Cartridge {
+	// MMC1 [SxROM] | Registers are loaded serially through a 5-bit shift register, one bit per write
+	class MMC1 final : public BankedMapper {
+	public:
+		MMC1(const RomInfo& info);
+
+		void save_state(State& state) const override;
+		void load_state(const State& state) override;
+
+	protected:
+		void write_register(u16 address, u8 data) override;
+
+		bool program_ram_readable() const override { return !(_program_bank_register & 0x10) && BankedMapper::program_ram_readable(); }
+		bool program_ram_writable() const override { return program_ram_readable(); }
+
+	private:
+		void update_banks();
+
+		u8	_shift_register{ 0x10 }; // The 1 marks the register as empty, it reaches bit 0 on the fifth write
+		u8	_control{ 0x0C }; // Power-up -> PRG mode 3 [last bank fixed at $C000]
+		u8	_character_bank_0{ 0 };
+		u8	_character_bank_1{ 0 };
+		u8	_program_bank_register{ 0 };
+	};
+}
@@ -0,0 +1,20 @@
+#include "M_002_UxROM.h"
+#include "../MapperRegistry.h"
+
+namespace NES::Cartridge {
+
+	REGISTER_MAPPER(2, UxROM)
+
+	UxROM::UxROM(const RomInfo& info) : BankedMapper(info) {
+		set_program_bank(0, 0);
+		set_program_bank(1, 1);
+		set_program_bank(2, -2);
+		set_program_bank(3, -1);
+	}
+
+	// $8000-$FFFF -> Bank Select | Bits 0-3 on UNROM, 0-4 on UOROM
+	void UxROM::write_register(u16 address, u8 data) {
+		set_program_bank(0, data * 2);
+		set_program_bank(1, data * 2 + 1);
+	}
+}
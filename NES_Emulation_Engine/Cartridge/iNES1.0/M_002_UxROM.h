@@ -0,0 +1,13 @@
+#pragma once
+#include "../BankedMapper.h"
+
+namespace NES::Cartridge {
+	// UxROM | 16KB switchable PRG bank at $8000, last 16KB fixed at $C000, 8KB CHR-RAM
+	class UxROM final : public BankedMapper {
+	public:
+		UxROM(const RomInfo& info);
+
+	protected:
+		void write_register(u16 address, u8 data) override;
+	};
+}
@@ -0,0 +1,20 @@
+#include "M_003_CNROM.h"
+#include "../MapperRegistry.h"
+
+namespace NES::Cartridge {
+
+	REGISTER_MAPPER(3, CNROM)
+
+	CNROM::CNROM(const RomInfo& info) : BankedMapper(info) {
+		for (u8 slot{ 0 }; slot < 4; ++slot) {
+			set_program_bank(slot, slot); // 16KB ROMs are mirrored by the bank wrap
+		}
+	}
+
+	// $8000-$FFFF -> CHR Bank Select | 8KB at a time
+	void CNROM::write_register(u16 address, u8 data) {
+		for (u8 slot{ 0 }; slot < 8; ++slot) {
+			set_character_bank(slot, data * 8 + slot);
+		}
+	}
+}
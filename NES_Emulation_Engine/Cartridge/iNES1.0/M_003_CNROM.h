@@ -0,0 +1,13 @@
+#pragma once
+#include "../BankedMapper.h"
+
+namespace NES::Cartridge {
+	// CNROM | Fixed 16KB or 32KB PRG-ROM, 8KB switchable CHR-ROM bank
+	class CNROM final : public BankedMapper {
+	public:
+		CNROM(const RomInfo& info);
+
+	protected:
+		void write_register(u16 address, u8 data) override;
+	};
+}
@@ -0,0 +1,116 @@
+#include "M_004_MMC3.h"
+#include "../MapperRegistry.h"
+
+namespace NES::Cartridge {
+
+	REGISTER_MAPPER(4, MMC3)
+
+	MMC3::MMC3(const RomInfo& info) : BankedMapper(info), _four_screen{ info.mirroring == Mirroring::FourScreen } {
+		_bank_register = { 0, 2, 4, 5, 6, 7, 0, 1 };
+		update_banks();
+	}
+
+	// Registers are paired even/odd across $8000-$FFFF, mirrored every 8KB
+	void MMC3::write_register(u16 address, u8 data) {
+		const bool odd = address & 0x0001;
+
+		switch ((address >> 13) & 0x03) {
+		case 0: // $8000 Bank Select | $8001 Bank Data
+			if (odd) {
+				_bank_register[_bank_select & 0x07] = data;
+			} else {
+				_bank_select = data;
+			}
+			update_banks();
+			break;
+
+		case 1: // $A000 Mirroring | $A001 PRG-RAM Protect
+			if (odd) {
+				_program_ram_protect = data;
+			} else if (!_four_screen) {
+				set_mirroring((data & 0x01) ? Mirroring::Horizontal : Mirroring::Vertical);
+			}
+			break;
+
+		case 2: // $C000 IRQ Latch | $C001 IRQ Reload
+			if (odd) {
+				_irq_counter = 0;
+				_irq_reload = true;
+			} else {
+				_irq_latch = data;
+			}
+			break;
+
+		case 3: // $E000 IRQ Disable + Acknowledge | $E001 IRQ Enable
+			_irq_enabled = odd;
+			if (!odd) _irq_pending = false;
+			break;
+		}
+	}
+
+	// R0-R7, bank select, PRG-RAM protect, then the scanline counter
+	void MMC3::save_state(State& state) const {
+		BankedMapper::save_state(state);
+		std::copy(_bank_register.begin(), _bank_register.end(), state.registers.begin());
+		state.registers[8] = _bank_select;
+		state.registers[9] = _program_ram_protect;
+		state.registers[10] = _irq_latch;
+		state.registers[11] = _irq_counter;
+		state.registers[12] = _irq_reload;
+		state.registers[13] = _irq_enabled;
+		state.registers[14] = _irq_pending;
+	}
+
+	void MMC3::load_state(const State& state) {
+		BankedMapper::load_state(state);
+		std::copy_n(state.registers.begin(), _bank_register.size(), _bank_register.begin());
+		_bank_select = state.registers[8];
+		_program_ram_protect = state.registers[9];
+		_irq_latch = state.registers[10];
+		_irq_counter = state.registers[11];
+		_irq_reload = state.registers[12];
+		_irq_enabled = state.registers[13];
+		_irq_pending = state.registers[14];
+	}
+
+	// The counter is reloaded when it is zero [or a reload was requested], otherwise decremented | Reaching zero with IRQs enabled pulls the line
+	void MMC3::scanline() {
+		if (_irq_counter == 0 || _irq_reload) {
+			_irq_counter = _irq_latch;
+			_irq_reload = false;
+		} else {
+			--_irq_counter;
+		}
+
+		if (_irq_counter == 0 && _irq_enabled) {
+			_irq_pending = true;
+		}
+	}
+
+	// A counter at zero [or due for a reload] takes the latch on the next clock and reaches zero latch clocks later [at once for latch 0]
+	u64 MMC3::scanlines_until_irq() const {
+		if (_irq_pending) return 0;
+		if (!_irq_enabled) return UINT64_MAX;
+		return (_irq_counter == 0 || _irq_reload) ? 1u + _irq_latch : _irq_counter;
+	}
+
+	void MMC3::update_banks() {
+		// PRG-ROM | R6/R7 are switchable, the second to last bank sits at $8000 or $C000 depending on bit 6
+		const bool program_mode = _bank_select & 0x40;
+		set_program_bank(program_mode ? 2 : 0, _bank_register[6] & 0x3F);
+		set_program_bank(1, _bank_register[7] & 0x3F);
+		set_program_bank(program_mode ? 0 : 2, -2);
+		set_program_bank(3, -1);
+
+		// CHR | R0/R1 are 2KB banks [low bit ignored], R2-R5 1KB banks | bit 7 swaps the two halves of the Pattern Tables
+		const u8 inversion = (_bank_select & 0x80) ? 4 : 0;
+		set_character_bank(0 ^ inversion, _bank_register[0] & 0xFE);
+		set_character_bank(1 ^ inversion, _bank_register[0] | 0x01);
+		set_character_bank(2 ^ inversion, _bank_register[1] & 0xFE);
+		set_character_bank(3 ^ inversion, _bank_register[1] | 0x01);
+		set_character_bank(4 ^ inversion, _bank_register[2]);
+		set_character_bank(5 ^ inversion, _bank_register[3]);
+		set_character_bank(6 ^ inversion, _bank_register[4]);
+		set_character_bank(7 ^ inversion, _bank_register[5]);
+	}
+}
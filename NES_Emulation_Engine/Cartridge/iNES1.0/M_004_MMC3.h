@@ -0,0 +1,40 @@
+#pragma once
+#include "../BankedMapper.h"
+
+namespace NES::Cartridge {
+	// MMC3 [TxROM] | 8KB PRG banks, 1KB/2KB CHR banks and a scanline counter that raises IRQs
+	class MMC3 final : public BankedMapper {
+	public:
+		MMC3(const RomInfo& info);
+
+		void scanline() override;
+
+		void save_state(State& state) const override;
+		void load_state(const State& state) override;
+
+		[[nodiscard]] bool has_irq() const override { return true; }
+		[[nodiscard]] bool irq_state() const override { return _irq_pending; }
+		[[nodiscard]] u64 scanlines_until_irq() const override;
+
+	protected:
+		void write_register(u16 address, u8 data) override;
+
+		bool program_ram_readable() const override { return (_program_ram_protect & 0x80) && BankedMapper::program_ram_readable(); }
+		bool program_ram_writable() const override { return program_ram_readable() && !(_program_ram_protect & 0x40); }
+
+	private:
+		void update_banks();
+
+		std::array<u8, 8>	_bank_register{}; // R0-R7
+		u8					_bank_select{ 0 }; // bits 0-2 -> target register | bit 6 -> PRG mode | bit 7 -> CHR A12 inversion
+		u8					_program_ram_protect{ 0x80 };
+		bool				_four_screen{ false };
+
+		// Scanline Counter
+		u8					_irq_latch{ 0 };
+		u8					_irq_counter{ 0 };
+		bool				_irq_reload{ false };
+		bool				_irq_enabled{ false };
+		bool				_irq_pending{ false };
+	};
+}
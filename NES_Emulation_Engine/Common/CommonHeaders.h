@@ -1,11 +1,14 @@
 #pragma once
 
 #include <assert.h>
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "PrimitiveTypes.h"
+#include "Config.h"
 #include "Test.h"
\ No newline at end of file
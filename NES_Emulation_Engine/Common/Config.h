@@ -0,0 +1,33 @@
+#pragma once
+
+// Build Options | Override from the compiler command line [-D] or the project's Preprocessor Definitions.
+
+#ifndef CPU_SWITCH_CORE
+#define CPU_SWITCH_CORE 1 // 1 -> Switch-dispatched R6502 core | 0 -> Member-function-pointer lookup core
+#endif // CPU_SWITCH_CORE
+
+#ifndef CPU_INSTRUCTION_CACHE
+#define CPU_INSTRUCTION_CACHE 1 // 1 -> The switch core runs RAM and PRG-ROM code from pre-decoded pages | 0 -> Fetches and decodes every instruction
+#endif // CPU_INSTRUCTION_CACHE
+
+#if !CPU_SWITCH_CORE // The cache is built on the switch core's per-opcode templates
+#undef CPU_INSTRUCTION_CACHE
+#define CPU_INSTRUCTION_CACHE 0
+#endif // !CPU_SWITCH_CORE
+
+#ifndef CPU_DYNAREC
+#define CPU_DYNAREC 0 // 1 -> Hot PRG-ROM blocks are translated to x86-64 and run next to the interpreter [CPU/Dynarec.h] | 0 -> Interpreter only
+#endif // CPU_DYNAREC
+
+#if !CPU_INSTRUCTION_CACHE || !(defined(__x86_64__) || defined(_M_X64)) // Falls back on the cached switch core, emits x86-64 only
+#undef CPU_DYNAREC
+#define CPU_DYNAREC 0
+#endif // !CPU_INSTRUCTION_CACHE || !x86-64
+
+#ifndef CARTRIDGE_STATIC_DISPATCH
+#define CARTRIDGE_STATIC_DISPATCH 0 // 1 -> Every GameCard access visits the concrete mapper [std::variant, slower per access than the vtable in MapperBenchmark.h] | 0 -> Virtual calls on Mapper, hot loops visit once [visit_mapper]
+#endif // CARTRIDGE_STATIC_DISPATCH
+
+#ifndef PPU_SIMD
+#define PPU_SIMD 1 // 1 -> SSE2/AVX2 tile decoding and pixel composition, whichever the compiler targets | 0 -> Scalar
+#endif // PPU_SIMD
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
-#if _DEBUG
+#include "Test.h"
+
+#if CPU_TEST // The test program is written into RAM by Bus::reset
 
 /// TEST_INTERRUPT_HANDLER ///
 // LDA ZP
@@ -306,14 +308,14 @@ _ram->write(0x0467, 0x6A);
 // memory to skip
 // BCC
 //	
-// LOOP:						   \
-// DEY <- start <-------------------\
-// CPY								|\
-// data 0x07						| \
-// BNE								| /
-// memory to skip -> goto start ____|/
-// CLC								/
-// CLD							   /
+// LOOP:
+// DEY <- start <-------------------+
+// CPY								|
+// data 0x07						|
+// BNE								|
+// memory to skip -> goto start ____+
+// CLC
+// CLD
 // CLI
 // CLV
 #define TEST_PROGRAM_BRANCH				\
@@ -6,4 +6,6 @@ using u32 = uint32_t;
 using u64 = uint64_t;
 
 using s8 = int8_t;
-using s16 = int16_t;
\ No newline at end of file
+using s16 = int16_t;
+using s32 = int32_t;
+using s64 = int64_t;
\ No newline at end of file
@@ -1,4 +1,27 @@
 #pragma once
 
-#define CPU_TEST 1 // To test the Ricoh M6502 CPU.
-#define RAM_TEST 0 // To test the RAM.
\ No newline at end of file
+// Test Switches | Override from the compiler command line [-D] or the project's Preprocessor Definitions, like Config.h.
+
+#ifndef CPU_TEST
+#define CPU_TEST 0 // To test the Ricoh M6502 CPU [traced as nestest-style text].
+#endif // CPU_TEST
+
+#ifndef RAM_TEST
+#define RAM_TEST 0 // To test the RAM.
+#endif // RAM_TEST
+
+#ifndef MAPPER_BENCHMARK
+#define MAPPER_BENCHMARK 0 // To benchmark virtual vs. static mapper dispatch.
+#endif // MAPPER_BENCHMARK
+
+#ifndef MICRO_BENCHMARK
+#define MICRO_BENCHMARK 0 // To run the micro-benchmark suite [also built as nes_bench].
+#endif // MICRO_BENCHMARK
+
+#ifndef PPU_SIMD_TEST
+#define PPU_SIMD_TEST 0 // To test the SIMD tile decoder against the scalar one.
+#endif // PPU_SIMD_TEST
+
+#ifndef AUDIO_RING_TEST
+#define AUDIO_RING_TEST 0 // To test the audio ring and rate control against a drifting consumer.
+#endif // AUDIO_RING_TEST
\ No newline at end of file
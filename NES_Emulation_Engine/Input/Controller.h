@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+// https://www.nesdev.org/wiki/Standard_controller
+// $4016 write -> bit 0 is the strobe of both ports | $4016/$4017 read -> bit 0 is the next button of port 1/2
+
+namespace NES::Input {
+
+	// Standard Controller | A 4021 shift register behind $4016/$4017.
+	// While the strobe is high it keeps reloading the buttons and reports A, once it drops every read shifts out the next button.
+	// After the 8 buttons it reports 1s [the register's serial input is tied high].
+	class Controller {
+	public:
+		enum Button : u8 { // Report order, A first
+			A = (1 << 0),
+			B = (1 << 1),
+			Select = (1 << 2),
+			Start = (1 << 3),
+			Up = (1 << 4),
+			Down = (1 << 5),
+			Left = (1 << 6),
+			Right = (1 << 7),
+		};
+
+		// Buttons held right now | Set by the front end, latched by the game's next strobe
+		void set_buttons(u8 buttons) { _buttons = buttons; }
+		[[nodiscard]] u8 buttons() const { return _buttons; }
+
+		void write_strobe(bool strobe) {
+			_strobe = strobe;
+			if (_strobe) _shift = _buttons;
+		}
+
+		// Serial data bit [bit 0 of the port]
+		u8 read() {
+			if (_strobe) return _buttons & Button::A;
+
+			const u8 bit = _shift & 0x01;
+			_shift = (_shift >> 1) | 0x80;
+			return bit;
+		}
+
+		// Snapshot | The held buttons go with it, a restored machine sees what it saw when it was saved
+		struct State {
+			u8		buttons;
+			u8		shift;
+			bool	strobe;
+		};
+		void save_state(State& state) const {
+			state.buttons = _buttons;
+			state.shift = _shift;
+			state.strobe = _strobe;
+		}
+		void load_state(const State& state) {
+			_buttons = state.buttons;
+			_shift = state.shift;
+			_strobe = state.strobe;
+		}
+
+	private:
+		u8		_buttons{ 0 };
+		u8		_shift{ 0 };
+		bool	_strobe{ false };
+	};
+}
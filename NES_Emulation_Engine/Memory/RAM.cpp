@@ -5,10 +5,12 @@
 namespace NES::Memory {
 
 	void RAM::disassemble_wram() {
+		std::copy_n(_memory, _ram.size(), _ram.begin()); // From attached storage, a no-op otherwise
 		Utilities::disasm(_ram);
 	}
 
 	void RAM::disassemble_wram(u32 start, u32 end) { // Disassembler - [Start, End)
+		std::copy_n(_memory, _ram.size(), _ram.begin());
 		Utilities::disasm(_ram, start, end);
 	}
 
@@ -31,14 +31,27 @@ namespace NES::Memory {
 		}
 
 		u8 read(u16 address, bool bReadOnly = false) {
-			return _ram[get_address(address)];
+			return _memory[get_address(address)];
 		}
 
 		void write(u16 address, u8 data) {
 			assert(address >= 0x0000 && address <= 0x1FFF); // RAM and it's mirrors
 			assert(data >= 0x00 && data <= 0xFF); // Is this check necessary?
 
-			_ram[get_address(address)] = data;
+			_memory[get_address(address)] = data;
+		}
+
+		// Host pointer to the 2KB, used by the CPU Bus page table for the RAM and its mirrors
+		[[nodiscard]] u8* data() { return _memory; }
+		[[nodiscard]] const u8* data() const { return _memory; }
+
+		// External Storage | The 2KB move to storage [2KB, owned by the caller, outliving the RAM], nullptr moves them back.
+		// Lets many machines keep their RAM side by side in one block. The contents move along, the Bus has to rebuild its page table.
+		void attach(u8* storage) {
+			u8* memory = storage ? storage : _ram.data();
+			if (memory == _memory) return;
+			std::copy_n(_memory, _ram.size(), memory);
+			_memory = memory;
 		}
 
 		void disassemble_wram();
@@ -48,6 +61,7 @@ namespace NES::Memory {
 		// WRAM - Work RAM -> 2KB Static RAM [SRAM]
 
 		std::array<u8, 2048> _ram{}; // Should I use the stack or heap?
+		u8* _memory{ _ram.data() }; // _ram or attached storage
 		u8* const _ram_heap = new u8[2048];
 	};
 }
\ No newline at end of file
@@ -1,8 +1,23 @@
 // NES_Emulation_Engine.cpp : 'main' function -> Program Execution Entry Point.
 
+#include <cstdio>
 #include <iostream>
+#if defined(_MSC_VER)
 #include <crtdbg.h>
+#endif // _MSC_VER
 #include "CPU/R6502.h"
+#if MAPPER_BENCHMARK
+#include "Benchmarks/MapperBenchmark.h"
+#endif // MAPPER_BENCHMARK
+#if MICRO_BENCHMARK
+#include "Benchmarks/Benchmark.h"
+#endif // MICRO_BENCHMARK
+#if PPU_SIMD_TEST
+#include "PPU/TileDecoder.h"
+#endif // PPU_SIMD_TEST
+#if AUDIO_RING_TEST
+#include "APU/R2A03.h"
+#endif // AUDIO_RING_TEST
 //#include "Utilities/Disassembler.h"
 
 
@@ -10,7 +25,7 @@ using namespace NES;
 
 int main()
 {
-#if _DEBUG
+#if defined(_MSC_VER) && _DEBUG
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF); //Google it, dammit
 #endif
 
@@ -24,14 +39,33 @@ int main()
 #if CPU_TEST
     Cpu->set_instructions_count(88);
 
+    CPU::TextTrace trace(stdout);
     for (; Cpu->get_instructions_count() > 0;) {
-        Cpu->clock();
+        Cpu->clock(trace);
     }
     Cpu->DisassembleRAM(0, 40);
 #endif // CPU_TEST
 
     delete Cpu;
 
+#if MAPPER_BENCHMARK
+    Benchmarks::run_mapper_benchmark();
+#endif // MAPPER_BENCHMARK
+
+#if MICRO_BENCHMARK
+    Benchmarks::Suite suite({});
+    Benchmarks::run_micro_benchmarks(suite);
+    suite.print_table(stdout);
+#endif // MICRO_BENCHMARK
+
+#if PPU_SIMD_TEST
+    PPU::test_tile_decoder();
+#endif // PPU_SIMD_TEST
+
+#if AUDIO_RING_TEST
+    APU::test_audio_ring();
+#endif // AUDIO_RING_TEST
+
     std::cout << "Done...\n Press Any Key To Continue! \n";
     getchar();
 }
@@ -1,25 +1,124 @@
 #pragma once
 
+#include <cstring>
+
 #include "../Common/CommonHeaders.h"
 #include "../Cartridge/Cartridge.h"
 
 namespace NES::PPU {
+	// PPU Address Space | $0000-$1FFF Pattern Tables [cartridge] | $2000-$2FFF Nametables [VRAM, mirrored by the cartridge] | $3F00-$3F1F Palettes
 	class PPU_Bus {
 	public:
+		PPU_Bus() {
+			for (auto& table : _pattern_table) std::fill(std::begin(table), std::end(table), 0x00);
+			for (auto& table : _vRAM) std::fill(std::begin(table), std::end(table), 0x00);
+			std::fill(std::begin(_palette_RAM), std::end(_palette_RAM), 0x00);
+			update_mirroring();
+		}
+
+		void connect_cartridge(std::shared_ptr<NES::Cartridge::GameCard> card) {
+			_card = card;
+			_mapper = _card ? _card->get_mapper().get() : nullptr;
+			update_mirroring();
+		}
+
+		[[nodiscard]] NES::Cartridge::GameCard* cartridge() const { return _card.get(); }
+
+		// Points the four logical nametables at the VRAM pages selected by the cartridge | Called whenever the mapper may have changed it
+		void update_mirroring() {
+			using NES::Cartridge::Mirroring;
+			const Mirroring mirroring = _mapper ? _mapper->get_mirroring() : Mirroring::Horizontal;
+
+			constexpr u8 layouts[5][4] = {
+				{ 0, 0, 1, 1 }, // Horizontal
+				{ 0, 1, 0, 1 }, // Vertical
+				{ 0, 1, 2, 3 }, // Four Screen -> extra 2KB on the cartridge
+				{ 0, 0, 0, 0 }, // Single Screen Low
+				{ 1, 1, 1, 1 }, // Single Screen High
+			};
+			for (u8 table{ 0 }; table < 4; ++table) {
+				_nametable[table] = _vRAM[layouts[static_cast<u8>(mirroring)][table]];
+			}
+		}
+
+		// Nametables + Attribute Tables | $2000-$3EFF
+		[[nodiscard]] u8 nametable_read(u16 address) const { return _nametable[(address >> 10) & 0x03][address & 0x03FF]; }
+		void nametable_write(u16 address, u8 data) { _nametable[(address >> 10) & 0x03][address & 0x03FF] = data; }
+
+		// Palette RAM | $3F10/$3F14/$3F18/$3F1C mirror the backdrop entries $3F00/$3F04/$3F08/$3F0C
+		[[nodiscard]] static constexpr u8 palette_index(u16 address) {
+			const u8 index = address & 0x1F;
+			return ((index & 0x13) == 0x10) ? (index & 0x0F) : index;
+		}
+		[[nodiscard]] u8 palette_read(u16 address) const { return _palette_RAM[palette_index(address)]; }
+		void palette_write(u16 address, u8 data) { _palette_RAM[palette_index(address)] = data & 0x3F; }
+
+		// The renderer reads the palette directly, indices are already de-mirrored [palette_index]
+		[[nodiscard]] const u8* palette() const { return _palette_RAM; }
+
+		// Pattern Tables | $0000-$1FFF
+		[[nodiscard]] u8 pattern_read(u16 address) const {
+			u8 data{ 0x00 };
+			if (_card && _card->ppu_read(address, data)) return data;
+			return _pattern_table[(address >> 12) & 0x01][address & 0x0FFF];
+		}
+		void pattern_write(u16 address, u8 data) {
+			if (_card && _card->ppu_write(address, data)) return;
+			_pattern_table[(address >> 12) & 0x01][address & 0x0FFF] = data;
+		}
+
+		// Reads Data from the PPU's Address Space
+		[[nodiscard]] u8 read(u16 address) const {
+			address &= 0x3FFF; // Size of PPU Address Bus is 16*1024 bytes | 16KB
+			if (address < 0x2000) return pattern_read(address);
+			if (address < 0x3F00) return nametable_read(address);
+			return palette_read(address);
+		}
+
+		// Writes Data to the PPU's Address Space
+		void write(u16 address, u8 data) {
+			address &= 0x3FFF;
+			if (address < 0x2000) {
+				pattern_write(address, data);
+			} else if (address < 0x3F00) {
+				nametable_write(address, data);
+			} else {
+				palette_write(address, data);
+			}
+		}
+
+		// Snapshot | Memory on the console side, the pattern tables of the cartridge are saved with it
+		struct State {
+			u8		pattern_table[2][4096];
+			u8		vram[4][1024];
+			u8		palette_ram[32];
+		};
+		void save_state(State& state) const {
+			std::memcpy(state.pattern_table, _pattern_table, sizeof(_pattern_table));
+			std::memcpy(state.vram, _vRAM, sizeof(_vRAM));
+			std::memcpy(state.palette_ram, _palette_RAM, sizeof(_palette_RAM));
+		}
+		void load_state(const State& state) { // Nametable pointers follow the restored mapper's mirroring
+			std::memcpy(_pattern_table, state.pattern_table, sizeof(_pattern_table));
+			std::memcpy(_vRAM, state.vram, sizeof(_vRAM));
+			std::memcpy(_palette_RAM, state.palette_ram, sizeof(_palette_RAM));
+			update_mirroring();
+		}
+
 	private:
 		// Instance or whatever data is needed by PPU from the cartridge
 		std::shared_ptr<NES::Cartridge::GameCard>	_card;
+		NES::Cartridge::Mapper*						_mapper{ nullptr }; // Cached from the cartridge, asked for the mirroring every scanline
 
 		// CHR-ROM/CHR-RAM - $0000-$1FFF -> from the card, using Bank Switching
-		// Contains Pattern Table
-		u8		_pattern_table[2][4096]; // Exist on the cartridge -> TODO: shift to cartridge
+		// Contains Pattern Table | Only used while no cartridge is inserted
+		u8		_pattern_table[2][4096];
 
-		// VRAM -> 2KB
-		u8		_vRAM[2][1024]; // $2000-$2FFF | Mirrors of _VRAM -> $3000-$3EFF
+		// VRAM -> 2KB on the console + 2KB on four screen cartridges
+		u8		_vRAM[4][1024]; // $2000-$2FFF | Mirrors of _VRAM -> $3000-$3EFF
+		std::array<u8*, 4>	_nametable{}; // Logical nametable -> VRAM page, follows the cartridge's mirroring
 
 		// Palette RAM indexes + Mirrors -> $3F00-$3F1F + $3F20-$3FFF
 		u8		_palette_RAM[32];
-
-		// Object Attribute Memory [OAM]
 	};
-}
\ No newline at end of file
+}
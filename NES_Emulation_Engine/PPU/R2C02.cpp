@@ -1,4 +1,7 @@
+#include <cstring>
+
 #include "R2C02.h"
+#include "TileDecoder.h"
 
 namespace NES::PPU { // [Picture Processing Unit]
 	namespace {
@@ -11,58 +14,440 @@ namespace NES::PPU { // [Picture Processing Unit]
 			return m_address & 0x3FFF; // Size of PPU Address Bus is 16*1024 bytes | 16KB
 		}
 
+		// 2C02 Colours | 64 entries -> R, G, B
+		constexpr u8 system_palette[64][3] = {
+			{  84,  84,  84 }, {   0,  30, 116 }, {   8,  16, 144 }, {  48,   0, 136 }, {  68,   0, 100 }, {  92,   0,  48 }, {  84,   4,   0 }, {  60,  24,   0 },
+			{  32,  42,   0 }, {   8,  58,   0 }, {   0,  64,   0 }, {   0,  60,   0 }, {   0,  50,  60 }, {   0,   0,   0 }, {   0,   0,   0 }, {   0,   0,   0 },
+			{ 152, 150, 152 }, {   8,  76, 196 }, {  48,  50, 236 }, {  92,  30, 228 }, { 136,  20, 176 }, { 160,  20, 100 }, { 152,  34,  32 }, { 120,  60,   0 },
+			{  84,  90,   0 }, {  40, 114,   0 }, {   8, 124,   0 }, {   0, 118,  40 }, {   0, 102, 120 }, {   0,   0,   0 }, {   0,   0,   0 }, {   0,   0,   0 },
+			{ 236, 238, 236 }, {  76, 154, 236 }, { 120, 124, 236 }, { 176,  98, 236 }, { 228,  84, 236 }, { 236,  88, 180 }, { 236, 106, 100 }, { 212, 136,  32 },
+			{ 160, 170,   0 }, { 116, 196,   0 }, {  76, 208,  32 }, {  56, 204, 108 }, {  56, 180, 204 }, {  60,  60,  60 }, {   0,   0,   0 }, {   0,   0,   0 },
+			{ 236, 238, 236 }, { 168, 204, 236 }, { 188, 188, 236 }, { 212, 178, 236 }, { 236, 174, 236 }, { 236, 174, 212 }, { 236, 180, 176 }, { 228, 196, 144 },
+			{ 204, 210, 120 }, { 180, 222, 120 }, { 168, 226, 144 }, { 152, 226, 180 }, { 160, 214, 228 }, { 160, 162, 160 }, {   0,   0,   0 }, {   0,   0,   0 },
+		};
+
+		// Packed once so the framebuffer write is a single table load per pixel
+		constexpr std::array<u32, 64> rgba_palette = [] {
+			std::array<u32, 64> table{};
+			for (u32 i{ 0 }; i < 64; ++i) {
+				table[i] = system_palette[i][0] | (system_palette[i][1] << 8) | (system_palette[i][2] << 16) | (0xFFu << 24);
+			}
+			return table;
+		}();
+
+		constexpr u64 reverse_pixels(u64 row) { // Horizontal sprite flip | One pixel per byte
+			row = ((row & 0xFFFFFFFF00000000) >> 32) | ((row & 0x00000000FFFFFFFF) << 32);
+			row = ((row & 0xFFFF0000FFFF0000) >> 16) | ((row & 0x0000FFFF0000FFFF) << 16);
+			return ((row & 0xFF00FF00FF00FF00) >> 8) | ((row & 0x00FF00FF00FF00FF) << 8);
+		}
+
+		// Linear dot of the frame, counted from the pre-render scanline
+		constexpr u64 frame_dot(s16 scanline, s16 cycle) { return static_cast<u64>(scanline + 1) * 341 + cycle; }
+		constexpr u64 frame_dots{ 262 * 341 };
+
 	} // Anonymous Namespace
 
+	u32 R2C02::to_rgba(u8 colour) { return rgba_palette[colour & 0x3F]; }
+
 	// Writes to the Address Bus
 	void R2C02::cpubus_write(u16 address, u8 data) {
+		_io_latch = data;
+
 		switch (get_cpu_address(address)) {
 
-		case 0x0000: break; // PPUCTRL -> Control
-		case 0x0001: break; // PPUMASK -> Mask
+		case 0x0000: // PPUCTRL -> Control
+			if (!(_control & Control::EnableNMI) && (data & Control::EnableNMI) && (_status & Status::VerticalBlank)) {
+				_nmi_pending = true; // Enabling NMI during vertical blank fires it immediately
+			}
+			_control = data;
+			_temp_address = (_temp_address & 0xF3FF) | ((data & 0x03) << 10);
+			break;
+
+		case 0x0001: _mask = data; break; // PPUMASK -> Mask
 		case 0x0002: break; // PPUSTATUS -> Status
-		case 0x0003: break; // OAMADDR -> [Object Attribute Memory] OAM address
-		case 0x0004: break; // OAMDATA -> [Object Attribute Memory] OAM data
-		case 0x0005: break; // PPUSCROLL -> Scroll
-		case 0x0006: break; // PPUADDR -> [Picture Processing Unit] Memory Address
-		case 0x0007: break; // PPUDATA -> [Picture Processing Unit] Memory Data
+		case 0x0003: _oam_address = data; break; // OAMADDR -> [Object Attribute Memory] OAM address
+		case 0x0004: _oam[_oam_address++] = data; break; // OAMDATA -> [Object Attribute Memory] OAM data
+
+		case 0x0005: // PPUSCROLL -> Scroll | X then Y
+			if (!_write_toggle) {
+				_temp_address = (_temp_address & ~0x001F) | (data >> 3);
+				_fine_x = data & 0x07;
+			} else {
+				_temp_address = (_temp_address & 0x8C1F) | ((data & 0x07) << 12) | ((data & 0xF8) << 2);
+			}
+			_write_toggle = !_write_toggle;
+			break;
+
+		case 0x0006: // PPUADDR -> [Picture Processing Unit] Memory Address | High then Low
+			if (!_write_toggle) {
+				_temp_address = (_temp_address & 0x00FF) | ((data & 0x3F) << 8);
+			} else {
+				_temp_address = (_temp_address & 0xFF00) | data;
+				_vram_address = _temp_address;
+			}
+			_write_toggle = !_write_toggle;
+			break;
+
+		case 0x0007: // PPUDATA -> [Picture Processing Unit] Memory Data
+			_bus.update_mirroring();
+			_bus.write(get_address(_vram_address), data);
+			_vram_address += (_control & Control::IncrementMode) ? 32 : 1;
+			break;
 
 		default:
 			break;
 		}
 	}
+	void R2C02::oam_dma(const u8* page) {
+		const u32 first = 256 - _oam_address; // Up to the end of OAM, the rest wraps to its start
+		std::memcpy(_oam.data() + _oam_address, page, first);
+		std::memcpy(_oam.data(), page + first, 256 - first);
+	}
+
 	// Reads from the Address Bus
 	u8 R2C02::cpubus_read(u16 address, bool bReadOnly) {
-		u8 data = 0x00;
+		u8 data = _io_latch;
 
 		switch (get_cpu_address(address)) {
-			
+
 		case 0x0000: break; // PPUCTRL -> Control
 		case 0x0001: break; // PPUMASK -> Mask
-		case 0x0002: break; // PPUSTATUS -> Status
+
+		case 0x0002: // PPUSTATUS -> Status | Low 5 bits are whatever was last on the bus
+			data = (_status & 0xE0) | (_io_latch & 0x1F);
+			if (!bReadOnly) {
+				_status &= ~Status::VerticalBlank;
+				_write_toggle = false;
+			}
+			break;
+
 		case 0x0003: break; // OAMADDR -> [Object Attribute Memory] OAM address
-		case 0x0004: break; // OAMDATA -> [Object Attribute Memory] OAM data
+		case 0x0004: data = _oam[_oam_address]; break; // OAMDATA -> [Object Attribute Memory] OAM data
 		case 0x0005: break; // PPUSCROLL -> Scroll
 		case 0x0006: break; // PPUADDR -> [Picture Processing Unit] Memory Address
-		case 0x0007: break; // PPUDATA -> [Picture Processing Unit] Memory Data
-		
+
+		case 0x0007: // PPUDATA -> [Picture Processing Unit] Memory Data | Reads below the palettes are delayed by one read
+		{
+			const u16 vram = get_address(_vram_address);
+			_bus.update_mirroring();
+			if (vram < 0x3F00) {
+				data = _data_buffer;
+				if (!bReadOnly) _data_buffer = _bus.read(vram);
+			} else {
+				data = (_io_latch & 0xC0) | _bus.read(vram);
+				if (!bReadOnly) _data_buffer = _bus.read(vram - 0x1000); // The buffer gets the nametable byte "under" the palette
+			}
+			if (!bReadOnly) _vram_address += (_control & Control::IncrementMode) ? 32 : 1;
+			break;
+		}
+
 		default:
 			break;
 		}
 
-		return 0;
+		if (!bReadOnly) _io_latch = data;
+		return data;
 	}
 
-	// Writes to the PPU's Address Bus
-	void R2C02::write(u16 address, u8 data) {
-		address = get_address(address);
+	// Jumps from event to event | Nothing in between is observable from outside the PPU
+	void R2C02::run(u64 dots) {
+		while (dots > 0) {
+			const s16 next = next_event();
+			const u64 step = std::min<u64>(dots, static_cast<u64>(next - _cycle));
+			_cycle += static_cast<s16>(step);
+			dots -= step;
 
+			if (_cycle == next) {
+				event();
+			}
+		}
 	}
 
-	// Reads from the PPU's Address Bus
-	u8 R2C02::read(u16 address, bool bReadOnly) {
-		u8 data = 0x00;
-		address = get_address(address);
+	// Next dot of the current scanline with an event | 341 -> end of the scanline
+	s16 R2C02::next_event() const {
+		if (_scanline >= 0 && _scanline < screen_height) { // Visible
+			s16 next = 341;
+			for (s16 dot : { 1, 256, 257, 260 }) {
+				if (dot > _cycle) { next = dot; break; }
+			}
+			if (_sprite_zero_dot > _cycle && _sprite_zero_dot < next) next = _sprite_zero_dot;
+			return next;
+		}
+		if (_scanline == 241) { // Vertical Blank
+			return _cycle < 1 ? 1 : 341;
+		}
+		if (_scanline == -1) { // Pre-Render
+			for (s16 dot : { 1, 257, 260, 280, 339 }) {
+				if (dot > _cycle) return dot;
+			}
+		}
+		return 341;
+	}
+
+	void R2C02::event() {
+		if (_cycle == 341) { // Next Scanline
+			_cycle = 0;
+			_sprite_zero_dot = -1;
+			if (++_scanline > 260) {
+				_scanline = -1;
+			}
+			return;
+		}
+
+		if (_scanline >= 0 && _scanline < screen_height) { // Visible
+			if (_cycle == _sprite_zero_dot) _status |= Status::SpriteZeroHit;
+
+			switch (_cycle) {
+			case 1: render_scanline(); break;
+			case 256: if (rendering()) increment_y(); break;
+			case 257: if (rendering()) copy_x(); break;
+			case 260: if (rendering() && _mapper) _mapper->scanline(); break; // Mapper Scanline Counter | Sprite fetches raise PPU A12 here
+			default: break;
+			}
+		} else if (_scanline == 241) { // Vertical Blank
+			_status |= Status::VerticalBlank;
+			++_frame;
+			if (_control & Control::EnableNMI) _nmi_pending = true;
+		} else if (_scanline == -1) { // Pre-Render
+			switch (_cycle) {
+			case 1:
+				_status &= ~(Status::VerticalBlank | Status::SpriteZeroHit | Status::SpriteOverflow);
+				_odd_frame = !_odd_frame;
+				break;
+			case 257: if (rendering()) copy_x(); break;
+			case 260: if (rendering() && _mapper) _mapper->scanline(); break;
+			case 280: if (rendering()) copy_y(); break; // Dots 280-304 copy the vertical bits, once is enough
+			case 339: if (rendering() && _odd_frame) _cycle = 340; break; // Odd frames skip the last dot of the pre-render scanline
+			default: break;
+			}
+		}
+	}
+
+	u64 R2C02::dots_until_nmi() const {
+		if (_nmi_pending) return 0;
+
+		const u64 now = frame_dot(_scanline, _cycle);
+		const u64 vblank = frame_dot(241, 1);
+		const u64 dots = now < vblank ? vblank - now : frame_dots - now + vblank;
+		return dots > 1 ? dots - 1 : 0; // The odd frame skip can make it one dot sooner
+	}
+
+	// Clocks fall on dot 260 of the pre-render scanline and the 240 visible ones -> frame dots 260 + k * 341, k = 0..240
+	u64 R2C02::dots_until_scanline_clocks(u64 clocks) const {
+		constexpr u64 clocks_per_frame{ screen_height + 1 };
+		const u64 now = frame_dot(_scanline, _cycle);
+		const u64 next = now < 260 ? 0 : std::min<u64>((now - 260) / 341 + 1, clocks_per_frame); // This frame's next clock, or the next frame's first
+		const u64 clock = next + clocks - 1;
+		const u64 frames = clock / clocks_per_frame;
+		const u64 dot = frames * frame_dots + (clock % clocks_per_frame) * 341 + 260;
+		return dot - now - frames; // Minus the odd frame skips on the way
+	}
+
+	void R2C02::increment_x(u16& address) const {
+		if ((address & 0x001F) == 31) { // Coarse X wraps into the next horizontal nametable
+			address &= ~0x001F;
+			address ^= 0x0400;
+		} else {
+			++address;
+		}
+	}
+
+	void R2C02::increment_y() {
+		if ((_vram_address & 0x7000) != 0x7000) { // Fine Y
+			_vram_address += 0x1000;
+			return;
+		}
+
+		_vram_address &= ~0x7000;
+		u16 coarse_y = (_vram_address & 0x03E0) >> 5;
+		if (coarse_y == 29) { // Last row of tiles -> next vertical nametable
+			coarse_y = 0;
+			_vram_address ^= 0x0800;
+		} else if (coarse_y == 31) { // Rows 30-31 are the attribute table, wrap without switching
+			coarse_y = 0;
+		} else {
+			++coarse_y;
+		}
+		_vram_address = (_vram_address & ~0x03E0) | (coarse_y << 5);
+	}
+
+	void R2C02::render_scanline() {
+		_bus.update_mirroring();
+
+		if (NES::Cartridge::GameCard* card = _bus.cartridge()) {
+			card->visit_mapper([this](auto* mapper) { render_scanline(mapper); });
+		} else {
+			render_scanline<NES::Cartridge::Mapper>(nullptr);
+		}
+	}
+
+	template<typename MapperType>
+	void R2C02::render_scanline(MapperType* mapper) {
+		if (!_frame_buffer) { // Headless -> skips pixel output only, the flags the CPU reads come out the same
+			if (!rendering()) return;
+			if (!(_mask & Mask::ShowBackground && _mask & Mask::ShowSprites)) { // Sprite 0 hit needs both layers, overflow either
+				evaluate_sprites();
+				return;
+			}
+		}
+		NES::Cartridge::GameCard* card = _bus.cartridge();
+		auto fetch_row = [&](u16 address) -> u64 { // Pre-decoded by the cartridge [TileCache], decoded here without one
+			u64 pixels{ 0 };
+			if (mapper && card->ppu_read_tile_row(mapper, address, pixels)) return pixels;
+
+			u8 row[8];
+			decode_tile_row(_bus.pattern_read(address), _bus.pattern_read(address + 8), 0, row);
+			std::memcpy(&pixels, row, sizeof(pixels));
+			return pixels;
+		};
+
+		// Line Buffers | pixel = palette << 2 | pattern | Sprites use palettes 4-7 and keep their flags above [TileDecoder.h]
+		std::array<u8, screen_width + 16> background{};
+		std::array<u8, screen_width> sprites{};
+
+		// Background | 33 tiles cover 256 pixels at any fine X scroll
+		if (_mask & Mask::ShowBackground) {
+			u16 address = _vram_address;
+			const u16 fine_y = (address >> 12) & 0x07;
+			const u16 table = (_control & Control::BackgroundPattern) ? 0x1000 : 0x0000;
+
+			// Fetch first, then merge the attributes into the whole row at once
+			u64 rows[33];
+			u8 palettes[33];
+			for (u8 tile{ 0 }; tile < 33; ++tile) {
+				const u8 index = _bus.nametable_read(0x2000 | (address & 0x0FFF));
+				const u8 attribute = _bus.nametable_read(0x23C0 | (address & 0x0C00) | ((address >> 4) & 0x38) | ((address >> 2) & 0x07));
+				palettes[tile] = (attribute >> (((address >> 4) & 0x04) | (address & 0x02))) & 0x03; // Quadrant of the 32x32 attribute area
+				const u16 pattern = table | (index << 4) | fine_y;
+
+				rows[tile] = fetch_row(pattern);
+				increment_x(address);
+			}
+			merge_tile_rows(rows, palettes, 33, background.data());
+		}
+
+		// Sprites | Evaluated for this scanline, the first 8 in OAM order are drawn
+		if (_mask & Mask::ShowSprites) {
+			const s16 height = (_control & Control::SpriteSize) ? 16 : 8;
+			u8 count{ 0 };
+
+			for (u8 sprite{ 0 }; sprite < 64; ++sprite) {
+				const u8* entry = &_oam[sprite * 4];
+				const s16 row = _scanline - 1 - entry[0]; // Sprites are delayed by one scanline -> Y = top - 1
+				if (row < 0 || row >= height) continue;
+
+				if (count == 8) {
+					_status |= Status::SpriteOverflow;
+					break;
+				}
+				++count;
+
+				const u8 tile = entry[1];
+				const u8 attributes = entry[2];
+				const u8 x = entry[3];
+				const u8 line = static_cast<u8>((attributes & 0x80) ? height - 1 - row : row); // Vertical flip
+
+				u16 pattern;
+				if (height == 16) { // 8x16 -> bit 0 of the tile picks the pattern table
+					pattern = ((tile & 0x01) << 12) | ((tile & 0xFE) << 4) | ((line & 0x08) << 1) | (line & 0x07);
+				} else {
+					pattern = ((_control & Control::SpritePattern) ? 0x1000 : 0x0000) | (tile << 4) | line;
+				}
+
+				u64 pattern_row = fetch_row(pattern);
+				if (attributes & 0x40) pattern_row = reverse_pixels(pattern_row); // Horizontal flip
+
+				const u8 palette = (attributes & 0x03) | 0x04;
+				u8 pixels[8];
+				merge_tile_rows(&pattern_row, &palette, 1, pixels);
+
+				const u8 flags = ((attributes & 0x20) ? sprite_behind_background : 0) | (sprite == 0 ? sprite_zero : 0);
+				for (u16 i{ 0 }; i < 8 && x + i < screen_width; ++i) {
+					if (pixels[i] && !sprites[x + i]) { // Lower OAM index wins
+						sprites[x + i] = pixels[i] | flags;
+					}
+				}
+			}
+		} else if (rendering()) { // Evaluation runs whenever rendering is on, even with the sprites hidden
+			evaluate_sprites();
+		}
+
+		// Left 8 pixels hidden -> transparent
+		if (!(_mask & Mask::ShowBackgroundLeft)) std::fill_n(background.begin() + _fine_x, 8, 0);
+		if (!(_mask & Mask::ShowSpritesLeft)) std::fill_n(sprites.begin(), 8, 0);
+
+		// Priority Multiplexer | Palette indices go straight into the framebuffer, RGBA expands them afterwards
+		const u8 grayscale = (_mask & Mask::Grayscale) ? 0x30 : 0x3F;
+		const bool sprite_zero_possible = (_mask & Mask::ShowBackground) && (_mask & Mask::ShowSprites) && !(_status & Status::SpriteZeroHit);
+
+		std::array<u8, screen_width> line_colours;
+		u8* colours = (_frame_buffer && _pixel_format == PixelFormat::PaletteIndex)
+			? static_cast<u8*>(_frame_buffer) + _scanline * screen_width
+			: line_colours.data();
+
+		const s16 hit = compose_scanline(background.data() + _fine_x, sprites.data(), _bus.palette(), grayscale, colours);
+		if (sprite_zero_possible && hit >= 0 && _sprite_zero_dot < 0) {
+			_sprite_zero_dot = static_cast<s16>(hit + 2); // Flag goes up as the pixel is output
+		}
+
+		if (_frame_buffer && _pixel_format == PixelFormat::RGBA) {
+			expand_scanline(colours, rgba_palette.data(), static_cast<u32*>(_frame_buffer) + _scanline * screen_width);
+		}
+	}
+
+	void R2C02::evaluate_sprites() {
+		const s16 height = (_control & Control::SpriteSize) ? 16 : 8;
+		u8 count{ 0 };
+
+		for (u8 sprite{ 0 }; sprite < 64; ++sprite) {
+			const s16 row = _scanline - 1 - _oam[sprite * 4];
+			if (row < 0 || row >= height) continue;
+			if (++count > 8) {
+				_status |= Status::SpriteOverflow;
+				return;
+			}
+		}
+	}
+
+	void R2C02::save_state(State& state) const {
+		state.control = _control;
+		state.mask = _mask;
+		state.status = _status;
+		state.oam_address = _oam_address;
+		state.data_buffer = _data_buffer;
+		state.io_latch = _io_latch;
+		state.vram_address = _vram_address;
+		state.temp_address = _temp_address;
+		state.fine_x = _fine_x;
+		state.write_toggle = _write_toggle;
+		state.oam = _oam;
+		state.frame = _frame;
+		state.scanline = _scanline;
+		state.cycle = _cycle;
+		state.sprite_zero_dot = _sprite_zero_dot;
+		state.odd_frame = _odd_frame;
+		state.nmi_pending = _nmi_pending;
+		_bus.save_state(state.bus);
+	}
 
-		return 0;
+	void R2C02::load_state(const State& state) {
+		_control = state.control;
+		_mask = state.mask;
+		_status = state.status;
+		_oam_address = state.oam_address;
+		_data_buffer = state.data_buffer;
+		_io_latch = state.io_latch;
+		_vram_address = state.vram_address;
+		_temp_address = state.temp_address;
+		_fine_x = state.fine_x;
+		_write_toggle = state.write_toggle;
+		_oam = state.oam;
+		_frame = state.frame;
+		_scanline = state.scanline;
+		_cycle = state.cycle;
+		_sprite_zero_dot = state.sprite_zero_dot;
+		_odd_frame = state.odd_frame;
+		_nmi_pending = state.nmi_pending;
+		_bus.load_state(state.bus);
 	}
-}
\ No newline at end of file
+}
@@ -1,8 +1,20 @@
 #pragma once
 
 #include "../Common/CommonHeaders.h"
+#include "../Cartridge/Cartridge.h"
+#include "PPU_Bus.h"
 
 namespace NES::PPU { // Picture Processing Unit
+
+	constexpr u16 screen_width{ 256 };
+	constexpr u16 screen_height{ 240 };
+
+	// Framebuffer Formats | PaletteIndex -> one u8 per pixel, the 6-bit NES colour | RGBA -> one u32 per pixel, bytes R, G, B, A in memory
+	enum class PixelFormat : u8 { PaletteIndex, RGBA };
+
+	// 2C02 Timing | 341 dots per scanline, 262 scanlines per frame [-1 -> pre-render, 0-239 visible, 240 post-render, 241-260 vertical blank]
+	// The PPU does not work dot by dot: run() jumps between the few dots where something observable happens and
+	// renders each visible scanline in one pass, from the registers as they are when the scanline starts.
 	class R2C02 {
 	public:
 		R2C02() {
@@ -15,21 +27,148 @@ namespace NES::PPU { // Picture Processing Unit
 		void cpubus_write(u16 address, u8 data);
 		// Reads from the Address Bus
 		u8 cpubus_read(u16 address, bool bReadOnly = false);
+		// OAM DMA | A 256-byte CPU page the way the DMA unit writes it through OAMDATA -> from OAMADDR on, wrapping, OAMADDR unchanged
+		void oam_dma(const u8* page);
 
 		// Writes to the PPU's Address Bus
-		void write(u16 address, u8 data);
+		void write(u16 address, u8 data) { _bus.write(address, data); }
 		// Reads from the PPU's Address Bus
-		u8 read(u16 address, bool bReadOnly = false);
+		u8 read(u16 address, bool bReadOnly = false) { return _bus.read(address); }
+
+		void clock() { run(1); }
+
+		// Runs a batch of dots, used by the CPU Bus to catch the PPU up lazily
+		void run(u64 dots);
+
+		// Dots until the next point where the PPU can raise NMI [start of vertical blank], 0 if one is waiting to be taken
+		[[nodiscard]] u64 dots_until_nmi() const;
+		// Dots until the mapper's scanline counter has been clocked that many more times [>= 1], as if rendering stayed on
+		// With rendering off the clocks only come later, so the estimate is never late
+		[[nodiscard]] u64 dots_until_scanline_clocks(u64 clocks) const;
 
-		void clock() {
-			// Clock function of the PPU
+		// NMI Output | Edge-triggered -> returns true once per NMI
+		[[nodiscard]] bool poll_nmi() {
+			const bool nmi = _nmi_pending;
+			_nmi_pending = false;
+			return nmi;
 		}
 
+		// Pattern Tables and the scanline counter of the mapper live on the cartridge
+		void connect_cartridge(std::shared_ptr<NES::Cartridge::GameCard> card) {
+			_mapper = card ? card->get_mapper().get() : nullptr;
+			_bus.connect_cartridge(std::move(card));
+		}
+
+		// Frame Output | 256x240, row-major, owned by the caller | nullptr renders nothing [headless]
+		void set_frame_buffer(void* buffer, PixelFormat format) {
+			_frame_buffer = buffer;
+			_pixel_format = format;
+		}
+
+		[[nodiscard]] u64 get_frame_count() const { return _frame; } // Completed frames [incremented at the start of vertical blank]
+		[[nodiscard]] s16 get_scanline() const { return _scanline; }
+		[[nodiscard]] s16 get_cycle() const { return _cycle; }
+
+		// Host colour of a 6-bit NES colour, packed as R, G, B, A bytes
+		[[nodiscard]] static u32 to_rgba(u8 colour);
+
+		// Snapshot | Registers, OAM, timing and the PPU's memory | The framebuffer is output, not state
+		struct State {
+			u8					control;
+			u8					mask;
+			u8					status;
+			u8					oam_address;
+			u8					data_buffer;
+			u8					io_latch;
+			u16					vram_address;
+			u16					temp_address;
+			u8					fine_x;
+			bool				write_toggle;
+			std::array<u8, 256>	oam;
+			u64					frame;
+			s16					scanline;
+			s16					cycle;
+			s16					sprite_zero_dot;
+			bool				odd_frame;
+			bool				nmi_pending;
+			PPU_Bus::State		bus;
+		};
+		void save_state(State& state) const;
+		void load_state(const State& state); // After the cartridge, the mirroring comes from its mapper
+
 	private:
-		//NES::CPU::Bus* _bus;
+		enum Control : u8 { // PPUCTRL
+			NametableX = (1 << 0),
+			NametableY = (1 << 1),
+			IncrementMode = (1 << 2), // 0 -> +1 across, 1 -> +32 down
+			SpritePattern = (1 << 3),
+			BackgroundPattern = (1 << 4),
+			SpriteSize = (1 << 5), // 0 -> 8x8, 1 -> 8x16
+			EnableNMI = (1 << 7),
+		};
+
+		enum Mask : u8 { // PPUMASK
+			Grayscale = (1 << 0),
+			ShowBackgroundLeft = (1 << 1),
+			ShowSpritesLeft = (1 << 2),
+			ShowBackground = (1 << 3),
+			ShowSprites = (1 << 4),
+		};
+
+		enum Status : u8 { // PPUSTATUS
+			SpriteOverflow = (1 << 5),
+			SpriteZeroHit = (1 << 6),
+			VerticalBlank = (1 << 7),
+		};
+
+		[[nodiscard]] bool rendering() const { return _mask & (Mask::ShowBackground | Mask::ShowSprites); }
+
+		// Scanline Events
+		[[nodiscard]] s16 next_event() const;
+		void event();
+
+		// Renders the current visible scanline | Templated on the concrete mapper so pattern fetches inline [Cartridge::MapperVariant]
+		void render_scanline();
+		template<typename MapperType>
+		void render_scanline(MapperType* mapper);
+		// Sprite evaluation without drawing | Sets the overflow flag like a rendered scanline would
+		void evaluate_sprites();
+
+		// Loopy Registers | yyy NN YYYYY XXXXX -> fine Y, nametable, coarse Y, coarse X
+		void increment_x(u16& address) const;
+		void increment_y();
+		void copy_x() { _vram_address = (_vram_address & ~0x041F) | (_temp_address & 0x041F); }
+		void copy_y() { _vram_address = (_vram_address & ~0x7BE0) | (_temp_address & 0x7BE0); }
+
+		PPU_Bus						_bus;
+		NES::Cartridge::Mapper*		_mapper{ nullptr }; // Cached from the cartridge for the scanline counter
+
+		// Registers
+		u8		_control{ 0x00 };
+		u8		_mask{ 0x00 };
+		u8		_status{ 0x00 };
+		u8		_oam_address{ 0x00 };
+		u8		_data_buffer{ 0x00 }; // PPUDATA read buffer
+		u8		_io_latch{ 0x00 }; // Last value on the PPU's data bus, returned by the write-only registers
+
+		u16		_vram_address{ 0x0000 }; // v
+		u16		_temp_address{ 0x0000 }; // t
+		u8		_fine_x{ 0 }; // x
+		bool	_write_toggle{ false }; // w
+
+		// Object Attribute Memory [OAM] | 64 sprites -> Y, tile, attributes, X
+		std::array<u8, 256>	_oam{};
+
+		// Timing
+		s16		_scanline{ 0 };
+		s16		_cycle{ 0 };
+		u64		_frame{ 0 };
+		bool	_odd_frame{ false };
+		s16		_sprite_zero_dot{ -1 }; // Dot of the current scanline where sprite 0 hits, -1 if it does not
 
-		s16 _scanline{ 0 };
-		s16 _cycle{ 0 };
+		bool	_nmi_pending{ false };
 
+		void*		_frame_buffer{ nullptr };
+		PixelFormat	_pixel_format{ PixelFormat::PaletteIndex };
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,277 @@
+#include <bit>
+#include <cstring>
+
+#include "TileDecoder.h"
+
+#if PPU_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+#if PPU_SIMD_TEST
+#include <iostream>
+#include <random>
+#endif // PPU_SIMD_TEST
+
+namespace NES::PPU {
+
+	/// SCALAR ///
+
+	void scalar::decode_tile_row(u8 low, u8 high, u8 palette, u8* pixels) {
+		for (u8 i{ 0 }; i < 8; ++i) {
+			const u8 bit = 7 - i;
+			const u8 pattern = ((low >> bit) & 0x01) | (((high >> bit) & 0x01) << 1);
+			pixels[i] = pattern ? ((palette << 2) | pattern) : 0;
+		}
+	}
+
+	s16 scalar::compose_scanline(const u8* background, const u8* sprites, const u8* palette, u8 grayscale_mask, u8* colours) {
+		s16 sprite_zero_hit{ -1 };
+
+		for (u16 x{ 0 }; x < 256; ++x) {
+			const u8 bg = background[x];
+			const u8 sp = sprites[x];
+
+			u8 index{ 0 }; // Backdrop
+			if ((sp & 0x03) && (!(bg & 0x03) || !(sp & sprite_behind_background))) {
+				index = sp & 0x1F;
+			} else if (bg & 0x03) {
+				index = bg & 0x0F;
+			}
+
+			if (sprite_zero_hit < 0 && (sp & sprite_zero) && (sp & 0x03) && (bg & 0x03) && x != 255) {
+				sprite_zero_hit = static_cast<s16>(x);
+			}
+
+			colours[x] = palette[index] & grayscale_mask;
+		}
+		return sprite_zero_hit;
+	}
+
+	/// END SCALAR ///
+
+#if PPU_SIMD_SSE2
+	namespace {
+
+		// Pixel i of a tile row is bit 7 - i of both bitplanes
+		inline __m128i bit_masks() { return _mm_setr_epi8(char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01); }
+
+		// a b -> a x8, b x8
+		inline __m128i broadcast_pair(u8 a, u8 b) {
+			__m128i v = _mm_cvtsi32_si128(a | (b << 8));
+			v = _mm_unpacklo_epi8(v, v);
+			v = _mm_unpacklo_epi16(v, v);
+			return _mm_unpacklo_epi32(v, v);
+		}
+
+		// Two tile rows -> 16 pixels | bitplane interleave, then the attribute goes on the opaque pixels only
+		inline __m128i decode_pair(__m128i low, __m128i high, __m128i palette) {
+			const __m128i bits = bit_masks();
+			const __m128i plane_0 = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(low, bits), bits), _mm_set1_epi8(0x01));
+			const __m128i plane_1 = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(high, bits), bits), _mm_set1_epi8(0x02));
+			const __m128i pattern = _mm_or_si128(plane_0, plane_1);
+			const __m128i transparent = _mm_cmpeq_epi8(pattern, _mm_setzero_si128());
+			return _mm_or_si128(pattern, _mm_andnot_si128(transparent, _mm_slli_epi16(palette, 2))); // palette < 8 -> no bits cross bytes
+		}
+
+		// Priority multiplexer for 16 pixels | Returns the palette RAM indices, hits gets the sprite 0 hit mask
+		inline __m128i compose_16(__m128i bg, __m128i sp, u32& hits) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i bg_transparent = _mm_cmpeq_epi8(_mm_and_si128(bg, _mm_set1_epi8(0x03)), zero);
+			const __m128i sp_transparent = _mm_cmpeq_epi8(_mm_and_si128(sp, _mm_set1_epi8(0x03)), zero);
+			const __m128i sp_in_front = _mm_cmpeq_epi8(_mm_and_si128(sp, _mm_set1_epi8(sprite_behind_background)), zero);
+
+			const __m128i sprite_wins = _mm_andnot_si128(sp_transparent, _mm_or_si128(bg_transparent, sp_in_front));
+			const __m128i index = _mm_or_si128(
+				_mm_and_si128(sprite_wins, _mm_and_si128(sp, _mm_set1_epi8(0x1F))),
+				_mm_andnot_si128(_mm_or_si128(sprite_wins, bg_transparent), _mm_and_si128(bg, _mm_set1_epi8(0x0F)))); // Neither -> 0, the backdrop
+
+			const __m128i is_sprite_zero = _mm_cmpeq_epi8(_mm_and_si128(sp, _mm_set1_epi8(sprite_zero)), _mm_set1_epi8(sprite_zero));
+			hits = static_cast<u32>(_mm_movemask_epi8(_mm_andnot_si128(_mm_or_si128(bg_transparent, sp_transparent), is_sprite_zero)));
+			return index;
+		}
+
+#if PPU_SIMD_AVX2
+		// a b c d -> a x8, b x8, c x8, d x8
+		inline __m256i broadcast_quad(const u8* values) {
+			__m128i v = _mm_cvtsi32_si128(values[0] | (values[1] << 8) | (values[2] << 16) | (values[3] << 24));
+			v = _mm_unpacklo_epi8(v, v);
+			v = _mm_unpacklo_epi16(v, v);
+			return _mm256_set_m128i(_mm_unpackhi_epi32(v, v), _mm_unpacklo_epi32(v, v));
+		}
+
+		inline __m256i decode_quad(__m256i low, __m256i high, __m256i palette) {
+			const __m256i bits = _mm256_broadcastsi128_si256(bit_masks());
+			const __m256i plane_0 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(low, bits), bits), _mm256_set1_epi8(0x01));
+			const __m256i plane_1 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(high, bits), bits), _mm256_set1_epi8(0x02));
+			const __m256i pattern = _mm256_or_si256(plane_0, plane_1);
+			const __m256i transparent = _mm256_cmpeq_epi8(pattern, _mm256_setzero_si256());
+			return _mm256_or_si256(pattern, _mm256_andnot_si256(transparent, _mm256_slli_epi16(palette, 2)));
+		}
+#endif // PPU_SIMD_AVX2
+
+	} // Anonymous Namespace
+#endif // PPU_SIMD_SSE2
+
+	void decode_tile_row(u8 low, u8 high, u8 palette, u8* pixels) {
+#if PPU_SIMD_SSE2
+		const __m128i row = decode_pair(broadcast_pair(low, 0), broadcast_pair(high, 0), _mm_set1_epi8(static_cast<char>(palette)));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(pixels), row);
+#else
+		scalar::decode_tile_row(low, high, palette, pixels);
+#endif // PPU_SIMD_SSE2
+	}
+
+	void decode_tile_rows(const u8* low, const u8* high, const u8* palette, u32 count, u8* pixels) {
+		u32 tile{ 0 };
+
+#if PPU_SIMD_AVX2
+		for (; tile + 4 <= count; tile += 4) { // 32 pixels
+			const __m256i row = decode_quad(broadcast_quad(low + tile), broadcast_quad(high + tile), broadcast_quad(palette + tile));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + tile * 8), row);
+		}
+#endif // PPU_SIMD_AVX2
+
+#if PPU_SIMD_SSE2
+		for (; tile + 2 <= count; tile += 2) { // 16 pixels
+			const __m128i row = decode_pair(broadcast_pair(low[tile], low[tile + 1]), broadcast_pair(high[tile], high[tile + 1]), broadcast_pair(palette[tile], palette[tile + 1]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + tile * 8), row);
+		}
+#endif // PPU_SIMD_SSE2
+
+		for (; tile < count; ++tile) {
+			decode_tile_row(low[tile], high[tile], palette[tile], pixels + tile * 8);
+		}
+	}
+
+	// 8 pixels per u64 already [SWAR] | A byte is opaque if either pattern bit is set, the multiply copies palette << 2 into exactly those bytes
+	void merge_tile_rows(const u64* rows, const u8* palette, u32 count, u8* pixels) {
+		for (u32 tile{ 0 }; tile < count; ++tile) {
+			const u64 opaque = (rows[tile] | (rows[tile] >> 1)) & 0x0101010101010101;
+			const u64 row = rows[tile] | (opaque * (palette[tile] << 2));
+			std::memcpy(pixels + tile * 8, &row, sizeof(row));
+		}
+	}
+
+	s16 compose_scanline(const u8* background, const u8* sprites, const u8* palette, u8 grayscale_mask, u8* colours) {
+#if PPU_SIMD_SSE2
+		s16 sprite_zero_hit{ -1 };
+		auto find_hit = [&](u16 x, u32 hits) { // x = 255 never hits
+			if (sprite_zero_hit < 0 && (hits &= (x == 240 ? 0x7FFF : 0xFFFF))) {
+				sprite_zero_hit = static_cast<s16>(x + std::countr_zero(hits));
+			}
+		};
+
+#if PPU_SIMD_AVX2
+		// Palette RAM in two 16-entry halves, one pshufb each, bit 4 of the index picks the half
+		const __m256i palette_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(palette)));
+		const __m256i palette_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(palette + 16)));
+		const __m256i grayscale = _mm256_set1_epi8(static_cast<char>(grayscale_mask));
+
+		for (u16 x{ 0 }; x < 256; x += 32) {
+			u32 hits_low{ 0 }, hits_high{ 0 };
+			const __m128i index_low = compose_16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(background + x)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(sprites + x)), hits_low);
+			const __m128i index_high = compose_16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(background + x + 16)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(sprites + x + 16)), hits_high);
+			find_hit(x, hits_low);
+			find_hit(x + 16, hits_high);
+
+			const __m256i index = _mm256_set_m128i(index_high, index_low);
+			const __m256i high_half = _mm256_cmpeq_epi8(_mm256_and_si256(index, _mm256_set1_epi8(0x10)), _mm256_set1_epi8(0x10));
+			const __m256i entry = _mm256_and_si256(index, _mm256_set1_epi8(0x0F));
+			const __m256i colour = _mm256_blendv_epi8(_mm256_shuffle_epi8(palette_low, entry), _mm256_shuffle_epi8(palette_high, entry), high_half);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(colours + x), _mm256_and_si256(colour, grayscale));
+		}
+#else
+		alignas(16) u8 indices[16];
+
+		for (u16 x{ 0 }; x < 256; x += 16) {
+			u32 hits{ 0 };
+			const __m128i index = compose_16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(background + x)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(sprites + x)), hits);
+			find_hit(x, hits);
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(indices), index); // SSE2 has no byte shuffle -> table loads
+			for (u8 i{ 0 }; i < 16; ++i) {
+				colours[x + i] = palette[indices[i]] & grayscale_mask;
+			}
+		}
+#endif // PPU_SIMD_AVX2
+		return sprite_zero_hit;
+#else
+		return scalar::compose_scanline(background, sprites, palette, grayscale_mask, colours);
+#endif // PPU_SIMD_SSE2
+	}
+
+	void expand_scanline(const u8* colours, const u32* rgba_palette, u32* pixels) {
+		u16 x{ 0 };
+#if PPU_SIMD_AVX2
+		for (; x < 256; x += 8) { // Gather 8 colours from the 64-entry table
+			const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(colours + x)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + x), _mm256_i32gather_epi32(reinterpret_cast<const int*>(rgba_palette), index, 4));
+		}
+#endif // PPU_SIMD_AVX2
+		for (; x < 256; ++x) {
+			pixels[x] = rgba_palette[colours[x] & 0x3F];
+		}
+	}
+
+#if PPU_SIMD_TEST
+	u32 test_tile_decoder() {
+		u32 mismatches{ 0 };
+
+		// Every tile row with every background and sprite palette
+		for (u32 palette{ 0 }; palette < 8; ++palette) {
+			std::array<u8, 256> low, high, palettes;
+			for (u32 high_plane{ 0 }; high_plane < 256; ++high_plane) {
+				for (u32 i{ 0 }; i < 256; ++i) {
+					low[i] = static_cast<u8>(i);
+					high[i] = static_cast<u8>(high_plane);
+					palettes[i] = static_cast<u8>(palette);
+				}
+
+				std::array<u8, 256 * 8> simd, reference;
+				decode_tile_rows(low.data(), high.data(), palettes.data(), 256, simd.data());
+				for (u32 i{ 0 }; i < 256; ++i) {
+					scalar::decode_tile_row(low[i], high[i], palettes[i], &reference[i * 8]);
+
+					u8 single[8];
+					decode_tile_row(low[i], high[i], palettes[i], single);
+					mismatches += !std::equal(single, single + 8, &reference[i * 8]);
+				}
+				mismatches += !std::equal(simd.begin(), simd.end(), reference.begin());
+
+				// Same rows through the tile cache path -> decoded without a palette, merged afterwards
+				std::array<u8, 256> no_palette{};
+				std::array<u64, 256> rows;
+				decode_tile_rows(low.data(), high.data(), no_palette.data(), 256, simd.data());
+				std::memcpy(rows.data(), simd.data(), simd.size());
+				merge_tile_rows(rows.data(), palettes.data(), 256, simd.data());
+				mismatches += !std::equal(simd.begin(), simd.end(), reference.begin());
+			}
+		}
+
+		// Random scanlines through the multiplexer and the palette lookup
+		std::mt19937 random{ 0x2C02 };
+		for (u32 line{ 0 }; line < 4096; ++line) {
+			std::array<u8, 256> background, sprites, simd, reference;
+			std::array<u8, 32> palette;
+			for (auto& pixel : background) pixel = random() & 0x0F;
+			for (auto& pixel : sprites) pixel = (random() & 0x03) ? 0 : ((random() & 0x7F) | 0x10) & ((random() & 0x01) ? 0x7F : 0x3F);
+			for (auto& colour : palette) colour = random() & 0x3F;
+			const u8 grayscale = (line & 1) ? 0x30 : 0x3F;
+
+			const s16 simd_hit = compose_scanline(background.data(), sprites.data(), palette.data(), grayscale, simd.data());
+			const s16 reference_hit = scalar::compose_scanline(background.data(), sprites.data(), palette.data(), grayscale, reference.data());
+			mismatches += (simd_hit != reference_hit) || simd != reference;
+		}
+
+		std::cout << "Tile Decoder Test [" << (PPU_SIMD_AVX2 ? "AVX2" : PPU_SIMD_SSE2 ? "SSE2" : "Scalar") << "]: "
+			<< (mismatches ? "FAILED -> " : "passed") << (mismatches ? std::to_string(mismatches) + " mismatches" : "") << "\n";
+		return mismatches;
+	}
+#endif // PPU_SIMD_TEST
+}
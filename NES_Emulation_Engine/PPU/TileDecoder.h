@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+// Instruction Set | Picked at compile time from what the compiler targets [/arch:AVX2, -mavx2], PPU_SIMD 0 forces the scalar path
+#if PPU_SIMD && defined(__AVX2__)
+#define PPU_SIMD_AVX2 1
+#define PPU_SIMD_SSE2 1
+#elif PPU_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PPU_SIMD_AVX2 0
+#define PPU_SIMD_SSE2 1
+#else
+#define PPU_SIMD_AVX2 0
+#define PPU_SIMD_SSE2 0
+#endif
+
+namespace NES::PPU {
+
+	// Line Buffer Pixels | pixel = palette << 2 | pattern, transparent pixels are 0.
+	// Background uses palettes 0-3, sprites 4-7 plus the flags below, so a pixel is directly its index into palette RAM.
+	constexpr u8 sprite_behind_background{ 0x20 };
+	constexpr u8 sprite_zero{ 0x40 };
+
+	// Decodes one 2-bitplane tile row into 8 pixels | Bitplane interleave + attribute merge
+	void decode_tile_row(u8 low, u8 high, u8 palette, u8* pixels);
+
+	// Decodes count tile rows into 8 * count pixels | low[i], high[i], palette[i] describe tile i
+	void decode_tile_rows(const u8* low, const u8* high, const u8* palette, u32 count, u8* pixels);
+
+	// Attribute merge for rows decoded without a palette [Cartridge::TileCache] | rows[i] -> 8 pattern indices, pixel 0 in the first byte
+	void merge_tile_rows(const u64* rows, const u8* palette, u32 count, u8* pixels);
+
+	// Priority Multiplexer + Palette Lookup for 256 pixels | colours may point straight into a palette index framebuffer.
+	// Returns the first x where an opaque sprite 0 pixel overlaps an opaque background pixel [x < 255], -1 if none.
+	s16 compose_scanline(const u8* background, const u8* sprites, const u8* palette, u8 grayscale_mask, u8* colours);
+
+	// Palette Index -> RGBA for 256 pixels
+	void expand_scanline(const u8* colours, const u32* rgba_palette, u32* pixels);
+
+	// Reference implementations | The SIMD paths must match these bit for bit [PPU_SIMD_TEST]
+	namespace scalar {
+		void decode_tile_row(u8 low, u8 high, u8 palette, u8* pixels);
+		s16 compose_scanline(const u8* background, const u8* sprites, const u8* palette, u8 grayscale_mask, u8* colours);
+	}
+
+#if PPU_SIMD_TEST
+	// Compares the SIMD paths against the scalar ones on every tile row and on random scanlines | Returns the number of mismatches
+	u32 test_tile_decoder();
+#endif // PPU_SIMD_TEST
+}
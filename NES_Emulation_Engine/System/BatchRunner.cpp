@@ -0,0 +1,192 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif // _WIN32
+
+#include "BatchRunner.h"
+#include "Console.h"
+#include "Movie.h"
+#include "../Utilities/Hash.h"
+
+namespace NES::System {
+	namespace {
+
+		// Logical CPUs the process may run on [cpuset, taskset, job object], in ascending order | Empty where the platform cannot tell
+		std::vector<u32> allowed_cpus() {
+			std::vector<u32> cpus;
+#if defined(_WIN32)
+			DWORD_PTR process{ 0 }, system{ 0 };
+			if (!GetProcessAffinityMask(GetCurrentProcess(), &process, &system)) return cpus;
+			for (u32 cpu{ 0 }; cpu < sizeof(process) * 8; ++cpu) {
+				if (process & (DWORD_PTR{ 1 } << cpu)) cpus.push_back(cpu);
+			}
+#elif defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (sched_getaffinity(0, sizeof(set), &set)) return cpus;
+			for (u32 cpu{ 0 }; cpu < CPU_SETSIZE; ++cpu) {
+				if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+			}
+#endif // _WIN32
+			return cpus;
+		}
+
+		// Binds the calling thread to one logical CPU | false where the platform has no way to or refuses [the job still runs, just unpinned]
+		bool pin_current_thread(u32 cpu) {
+#if defined(_WIN32)
+			return cpu < 64 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << cpu) != 0;
+#elif defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+			return false;
+#endif // _WIN32
+		}
+
+		bool write_state(const std::string& path, const SaveState& state) {
+			std::FILE* file = std::fopen(path.c_str(), "wb");
+			if (!file) return false;
+			const bool written = std::fwrite(&state, sizeof(state), 1, file) == 1;
+			return std::fclose(file) == 0 && written;
+		}
+
+	} // Anonymous Namespace
+
+	BatchRunner::Result run_job(const BatchRunner::Job& job) {
+		using clock = std::chrono::steady_clock;
+		BatchRunner::Result result;
+
+		// Everything the machine owns is allocated and touched here, on the thread that runs it
+		Console console;
+		if (!console.load(job.rom)) {
+			result.error = "cannot load ROM";
+			return result;
+		}
+		console.set_rendering(false);
+		console.bus().get_apu()->set_sample_rate(0); // Nobody listens
+
+		Movie movie;
+		Movie::Playback playback;
+		if (!job.movie.empty()) {
+			if (!movie.load(job.movie)) {
+				result.error = "cannot read movie";
+				return result;
+			}
+			if (!movie.begin_playback(console, playback) && playback.ok()) {
+				result.error = "movie is for another ROM";
+				return result;
+			}
+		}
+
+		const u64 start_cycle = console.get_cycle();
+		const u64 start_frame = console.get_frame_count();
+		const auto start = clock::now();
+		if (!job.movie.empty()) {
+			movie.play(console, playback, job.frames ? job.frames : UINT64_MAX);
+			result.desync_frame = playback.desync_frame;
+		} else {
+			console.run_frames(job.frames);
+		}
+		result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+		result.cycles = console.get_cycle() - start_cycle;
+		result.frames = console.get_frame_count() - start_frame;
+		result.ram_hash = Utilities::fnv1a(console.ram());
+
+		const auto state = std::make_unique<SaveState>(); // Zeroed -> the hash does not depend on what the heap held
+		if (!console.save_state(*state)) {
+			result.error = "cannot save state";
+			return result;
+		}
+		result.state_hash = state->hash();
+
+		if (!playback.ok()) {
+			result.error = "movie out of sync";
+			return result;
+		}
+		if (!job.save_state.empty() && !write_state(job.save_state, *state)) {
+			result.error = "cannot write save state";
+			return result;
+		}
+		result.ok = true;
+		return result;
+	}
+
+	BatchRunner::BatchRunner() : BatchRunner(Config{}) {}
+
+	BatchRunner::BatchRunner(const Config& config) : _config{ config } {
+		_cpus = allowed_cpus();
+		const u32 cpus = _cpus.empty() ? std::thread::hardware_concurrency() : static_cast<u32>(_cpus.size());
+		_threads = _config.threads ? _config.threads : std::max(cpus, 1u);
+		_queues = std::vector<Queue>(_threads);
+	}
+
+	std::vector<BatchRunner::Result> BatchRunner::run(const std::vector<Job>& jobs, const ResultCallback& on_result) {
+		std::vector<Result> results(jobs.size());
+		_steals = 0;
+		_pin_failures = 0;
+		for (u64 job{ 0 }; job < jobs.size(); ++job) _queues[job % _threads].jobs.push_back(job);
+
+		std::vector<std::thread> workers;
+		workers.reserve(_threads);
+		for (u32 worker{ 0 }; worker < _threads; ++worker) {
+			workers.emplace_back(&BatchRunner::work, this, worker, std::cref(jobs), std::ref(results), std::cref(on_result));
+		}
+		for (std::thread& worker : workers) worker.join();
+		return results;
+	}
+
+	void BatchRunner::work(u32 worker, const std::vector<Job>& jobs, std::vector<Result>& results, const ResultCallback& on_result) {
+		// Worker i -> the i-th CPU the process is allowed on, wrapping when there are more workers than CPUs
+		s32 cpu{ -1 };
+		if (_config.pin_threads) {
+			if (!_cpus.empty() && pin_current_thread(_cpus[worker % _cpus.size()])) cpu = static_cast<s32>(_cpus[worker % _cpus.size()]);
+			else ++_pin_failures;
+		}
+
+		u64 job;
+		while (take(worker, job)) {
+			Result result = run_job(jobs[job]);
+			result.job = job;
+			result.worker = worker;
+			result.cpu = cpu;
+
+			std::lock_guard lock(_result_mutex);
+			if (on_result) on_result(result);
+			results[job] = std::move(result);
+		}
+	}
+
+	// Own deque from the back, then the others' from the front | false once every deque is empty [jobs are never added while running]
+	bool BatchRunner::take(u32 worker, u64& job) {
+		{
+			Queue& own = _queues[worker];
+			std::lock_guard lock(own.mutex);
+			if (!own.jobs.empty()) {
+				job = own.jobs.back();
+				own.jobs.pop_back();
+				return true;
+			}
+		}
+		for (u32 i{ 1 }; i < _threads; ++i) {
+			Queue& victim = _queues[(worker + i) % _threads];
+			std::lock_guard lock(victim.mutex);
+			if (!victim.jobs.empty()) {
+				job = victim.jobs.front();
+				victim.jobs.pop_front();
+				++_steals;
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::System {
+
+	// Batch Runner | Many independent machines on one host: every job is its own Console [ROM, optional movie, frame count],
+	// run unpaced on a pool of worker threads. Machines share nothing but the read-only mapper registry and CPU lookup table.
+	//
+	// Work stealing -> every worker owns a deque of jobs, handed out round robin up front. A worker takes from the back of its own
+	// and, once it is empty, steals from the front of the others. Jobs are whole runs [milliseconds to minutes], so a mutex per deque is plenty.
+	// Pinning -> worker i is bound to the i-th logical CPU of the process affinity mask [so a cpuset or taskset is respected].
+	// Each machine is then built and first touched on the worker that runs it, which places its pages on that CPU's NUMA node
+	// under the default first-touch policy. A worker that cannot be bound runs unpinned and says so in its results [cpu -1].
+	class BatchRunner {
+	public:
+		struct Config {
+			u32		threads{ 0 }; // 0 -> one per logical CPU the process is allowed on
+			bool	pin_threads{ false };
+		};
+
+		struct Job {
+			std::string	rom;
+			u64			frames{ 600 }; // With a movie -> at most this many of its frames [0 -> all]
+			std::string	movie; // Input movie played and verified on the way, none if empty
+			std::string	save_state; // Save state written at the end, none if empty
+		};
+
+		struct Result {
+			u64			job{ 0 }; // Index in the job list
+			u32			worker{ 0 };
+			s32			cpu{ -1 }; // Logical CPU its worker was bound to, -1 -> unpinned [not asked for or the bind failed]
+			bool		ok{ false }; // Ran to the end [and in sync with its movie]
+			std::string	error; // Why not
+			u64			frames{ 0 };
+			u64			cycles{ 0 };
+			double		seconds{ 0.0 };
+			u64			state_hash{ 0 }; // SaveState::hash at the end
+			u64			ram_hash{ 0 };
+			u64			desync_frame{ UINT64_MAX }; // Movie jobs, first checkpoint out of sync
+
+			[[nodiscard]] double cycles_per_second() const { return seconds > 0.0 ? cycles / seconds : 0.0; }
+		};
+
+		// Called from the worker threads as jobs finish, one call at a time
+		using ResultCallback = std::function<void(const Result&)>;
+
+		BatchRunner();
+		explicit BatchRunner(const Config& config);
+
+		// Runs every job and returns when all are done | Results in job order
+		std::vector<Result> run(const std::vector<Job>& jobs, const ResultCallback& on_result = {});
+
+		[[nodiscard]] u32 threads() const { return _threads; }
+		[[nodiscard]] u64 steals() const { return _steals; } // Jobs run by a worker other than the one they were handed to [last run]
+		[[nodiscard]] u32 pin_failures() const { return _pin_failures; } // Workers left unpinned although pinning was asked for [last run]
+
+	private:
+		struct Queue {
+			std::mutex			mutex;
+			std::deque<u64>		jobs;
+		};
+
+		void work(u32 worker, const std::vector<Job>& jobs, std::vector<Result>& results, const ResultCallback& on_result);
+		[[nodiscard]] bool take(u32 worker, u64& job);
+
+		Config					_config;
+		u32						_threads{ 1 };
+		std::vector<Queue>		_queues;
+		std::mutex				_result_mutex;
+		std::atomic<u64>		_steals{ 0 };
+		std::atomic<u32>		_pin_failures{ 0 };
+		std::vector<u32>		_cpus; // Process affinity mask, ascending
+	};
+
+	// One job on the calling thread | What every worker runs
+	[[nodiscard]] BatchRunner::Result run_job(const BatchRunner::Job& job);
+}
@@ -0,0 +1,73 @@
+#include "Console.h"
+#include "../Utilities/Hash.h"
+
+namespace NES::System {
+
+	Console::Console() : _cpu(std::make_unique<CPU::R6502>()) {
+		_bus = _cpu->CreateBus();
+		_cpu->SetBus(_bus);
+		set_rendering(true);
+	}
+
+	bool Console::load(const std::string& file) {
+		Cartridge::GameCard* card = Cartridge::load_file(file);
+		if (!card) return false;
+
+		insert_cartridge(std::shared_ptr<Cartridge::GameCard>(card));
+		return true;
+	}
+
+	void Console::insert_cartridge(std::shared_ptr<Cartridge::GameCard> card) {
+		_cartridge = std::move(card);
+		_cartridge_id = _cartridge ? Utilities::fnv1a(_cartridge->get_program_memory(), _cartridge->get_info().mapper_id + 1) : 0;
+		_bus->insert_cartridge(_cartridge);
+		reset();
+	}
+
+	bool Console::save_state(SaveState& state) const {
+		if (!_cartridge || !_cartridge->save_state(state.cartridge)) return false;
+
+		std::memcpy(state.header.magic, SaveState::magic, sizeof(state.header.magic));
+		state.header.version = SaveState::version;
+		state.header.size = sizeof(SaveState);
+		state.header.cartridge = _cartridge_id;
+		state.header.cycle = get_cycle();
+		state.header.frame = get_frame_count();
+
+		_cpu->save_state(state.cpu);
+		_bus->save_state(state.bus);
+		_bus->get_ppu()->save_state(state.ppu);
+		_bus->get_apu()->save_state(state.apu);
+		return true;
+	}
+
+	// Emulation is deterministic [no host time or randomness reaches the machine], so a clone runs exactly like the original from here on
+	std::unique_ptr<Console> Console::clone() const {
+		auto copy = std::make_unique<Console>();
+		if (!_cartridge) return copy;
+
+		std::shared_ptr<Cartridge::GameCard> card = _cartridge->clone();
+		if (!card) return nullptr;
+		copy->insert_cartridge(std::move(card));
+
+		const auto state = std::make_unique<SaveState>();
+		if (!save_state(*state) || !copy->load_state(*state)) return nullptr;
+		return copy;
+	}
+
+	// The cartridge goes first: the Bus page table and the PPU's nametable mirroring are rebuilt from the restored mapper
+	bool Console::load_state(const SaveState& state) {
+		if (!_cartridge || !state.compatible() || state.header.cartridge != _cartridge_id) return false;
+		if (!_cartridge->load_state(state.cartridge)) return false;
+
+		_bus->load_state(state.bus);
+		_bus->get_ppu()->load_state(state.ppu);
+		_bus->get_apu()->load_state(state.apu);
+		_cpu->load_state(state.cpu);
+		return true;
+	}
+
+	void Console::set_rendering(bool enabled) {
+		_bus->get_ppu()->set_frame_buffer(enabled ? _frame_buffer.data() : nullptr, PPU::PixelFormat::PaletteIndex);
+	}
+}
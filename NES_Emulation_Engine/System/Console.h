@@ -0,0 +1,82 @@
+#pragma once
+
+#include <span>
+
+#include "../Common/CommonHeaders.h"
+#include "../CPU/R6502.h"
+#include "SaveState.h"
+
+namespace NES::System {
+
+	// The Whole Machine | CPU, Bus [RAM, PPU, APU] and the cartridge, wired the way main() used to do by hand.
+	// Runs as fast as the host allows, pacing and I/O are up to the front end.
+	class Console {
+	public:
+		Console();
+
+		Console(const Console&) = delete;
+		Console& operator=(const Console&) = delete;
+
+		// Loads an iNES file and resets | false if the file cannot be read or its mapper is not supported
+		[[nodiscard]] bool load(const std::string& file);
+		// Inserts a cartridge built elsewhere [in-memory ROMs] and resets
+		void insert_cartridge(std::shared_ptr<Cartridge::GameCard> card);
+		void reset() { _cpu->reset(); }
+
+		// Runs whole instructions for at least cycles CPU cycles | Returns the cycles consumed
+		// Both take an optional trace sink [CPU/Trace.h] that sees every instruction.
+		template<CPU::TraceSink Sink = CPU::NullTrace>
+		u64 run_cycles(u64 cycles, Sink&& sink = {}) { return _cpu->run_cycles(cycles, sink); }
+
+		// Runs until frames more frames have completed [start of vertical blank] | Returns the cycles consumed
+		// Frames end at the start of vertical blank, so each batch runs up to the predicted vblank dot and a short tail covers rounding.
+		template<CPU::TraceSink Sink = CPU::NullTrace>
+		u64 run_frames(u64 frames, Sink&& sink = {}) {
+			const u64 start = get_cycle();
+			const u64 target = get_frame_count() + frames;
+
+			while (get_frame_count() < target) {
+				run_cycles(_bus->get_ppu()->dots_until_nmi() / 3 + 1, sink);
+			}
+			return get_cycle() - start;
+		}
+
+		// Save States | Between instructions [outside run_cycles/run_frames], into storage the caller owns -> nothing is allocated.
+		// save_state fails without a cartridge or with more CHR-RAM than a state holds, load_state with a state from another build
+		// or game, and then leaves the machine untouched.
+		[[nodiscard]] bool save_state(SaveState& state) const;
+		[[nodiscard]] bool load_state(const SaveState& state);
+
+		// Independent machine in the same state | Shares the ROM, copies everything else | nullptr if the cartridge cannot be cloned
+		[[nodiscard]] std::unique_ptr<Console> clone() const;
+
+		// Identity of the inserted cartridge | Mapper number + PRG-ROM hash, 0 without one
+		[[nodiscard]] u64 cartridge_id() const { return _cartridge_id; }
+
+		// Controller Input | Standard controllers on both ports, buttons as Input::Controller::Button bits.
+		// Held until changed, a front end sets them once per frame before running it.
+		void set_input(u32 port, u8 buttons) { _bus->get_controller(port).set_buttons(buttons); }
+		[[nodiscard]] u8 input(u32 port) const { return _bus->get_controller(port).buttons(); }
+
+		// Rendering into the console's own palette index framebuffer | Off -> the PPU skips pixel output entirely
+		void set_rendering(bool enabled);
+
+		[[nodiscard]] u64 get_cycle() const { return _cpu->get_cycle(); }
+		[[nodiscard]] u64 get_frame_count() const { return _bus->get_ppu()->get_frame_count(); }
+
+		[[nodiscard]] std::span<const u8> frame_buffer() const { return _frame_buffer; } // 256x240, 6-bit NES colours
+		[[nodiscard]] std::span<const u8> ram() const { return { _bus->get_ram()->data(), 0x0800 }; }
+
+		[[nodiscard]] CPU::R6502& cpu() { return *_cpu; }
+		[[nodiscard]] CPU::Bus& bus() { return *_bus; }
+		[[nodiscard]] const std::shared_ptr<Cartridge::GameCard>& cartridge() const { return _cartridge; }
+
+	private:
+		std::unique_ptr<CPU::R6502>				_cpu;
+		CPU::Bus*								_bus{ nullptr }; // Owned by the CPU
+		std::shared_ptr<Cartridge::GameCard>	_cartridge;
+		u64										_cartridge_id{ 0 };
+
+		std::array<u8, PPU::screen_width * PPU::screen_height>	_frame_buffer{};
+	};
+}
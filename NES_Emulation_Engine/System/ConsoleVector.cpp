@@ -0,0 +1,67 @@
+#include "ConsoleVector.h"
+
+namespace NES::System {
+
+	bool ConsoleVector::load(const std::string& rom, u32 count) {
+		_consoles.clear(); // Before their RAM goes
+		_lockstep.bind({});
+		if (!count) return false;
+
+		auto first = std::make_unique<Console>();
+		if (!first->load(rom)) return false;
+		first->bus().get_apu()->set_sample_rate(0); // Batch runs are not listened to
+		_consoles.push_back(std::move(first));
+		for (u32 instance{ 1 }; instance < count; ++instance) {
+			std::unique_ptr<Console> copy = _consoles[0]->clone(); // Shares the ROM
+			if (!copy) {
+				_consoles.clear();
+				return false;
+			}
+			copy->bus().get_apu()->set_sample_rate(0);
+			_consoles.push_back(std::move(copy));
+		}
+
+		set_rendering(false);
+		_ram.assign(u64{ count } * ram_stride, 0x00);
+		for (u32 instance{ 0 }; instance < count; ++instance) _consoles[instance]->bus().attach_ram(_ram.data() + u64{ instance } * ram_stride);
+
+		std::vector<CPU::R6502*> cpus;
+		for (const auto& console : _consoles) cpus.push_back(&console->cpu());
+		_lockstep.bind(cpus);
+		_targets.assign(count, 0);
+		_frames.assign(count, 0);
+		return true;
+	}
+
+	bool ConsoleVector::load_state(const SaveState& state) {
+		for (const auto& console : _consoles) {
+			if (!console->load_state(state)) return false;
+		}
+		_lockstep.refresh();
+		return true;
+	}
+
+	// Console::run_frames per instance: batches up to the predicted vblank until the frame count moves, every batch in lockstep
+	void ConsoleVector::run_frame() {
+		for (u32 instance{ 0 }; instance < size(); ++instance) _frames[instance] = _consoles[instance]->get_frame_count() + 1;
+
+		bool running{ true };
+		while (running) {
+			running = false;
+			for (u32 instance{ 0 }; instance < size(); ++instance) {
+				Console& console = *_consoles[instance];
+				_targets[instance] = console.get_cycle();
+				if (console.get_frame_count() >= _frames[instance]) continue;
+				_targets[instance] += console.bus().get_ppu()->dots_until_nmi() / 3 + 1;
+				running = true;
+			}
+			if (running) _lockstep.run_until(_targets);
+		}
+	}
+
+	void ConsoleVector::gather(u16 address, std::span<u8> out) const {
+		const u8* ram = _ram.data() + (address & (ram_stride - 1));
+		const u32 count = std::min<u32>(size(), static_cast<u32>(out.size()));
+		for (u32 instance{ 0 }; instance < count; ++instance) out[instance] = ram[u64{ instance } * ram_stride];
+	}
+}
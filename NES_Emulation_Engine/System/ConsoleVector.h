@@ -0,0 +1,56 @@
+#pragma once
+
+#include <span>
+
+#include "../Common/CommonHeaders.h"
+#include "../CPU/Lockstep.h"
+#include "Console.h"
+
+namespace NES::System {
+
+	// Console Vector | N instances of one ROM advanced a frame at a time in lockstep, each with its own input [RL and fuzzing runs].
+	// The instances share the PRG/CHR-ROM [Console::clone] and their 2KB RAMs sit side by side in one block, so reading a reward from
+	// every instance is a strided gather over a single allocation. Their CPUs run on one CPU::Lockstep: the registers as arrays,
+	// instances on the same opcode executed together, the rest [I/O, interrupts, divergent code] on each one's own core.
+	// An instance ends every frame in the state it would have reached as a Console of its own.
+	class ConsoleVector {
+	public:
+		static constexpr u32 ram_stride{ 0x0800 };
+
+		// count instances of the ROM at power-on | false if it cannot be loaded
+		[[nodiscard]] bool load(const std::string& rom, u32 count);
+		// Every instance to the same state [episode reset] | false if the state is for another game or build
+		[[nodiscard]] bool load_state(const SaveState& state);
+
+		// Buttons the instance holds from the next frame on
+		void set_input(u32 instance, u32 port, u8 buttons) { _consoles[instance]->set_input(port, buttons); }
+
+		// One frame on every instance [Console::run_frames(1) on each]
+		void run_frame();
+
+		[[nodiscard]] u32 size() const { return static_cast<u32>(_consoles.size()); }
+
+		// RAM of every instance, instance i at [i * ram_stride, (i + 1) * ram_stride)
+		[[nodiscard]] std::span<const u8> ram() const { return _ram; }
+		[[nodiscard]] std::span<const u8> ram(u32 instance) const { return std::span<const u8>(_ram).subspan(instance * ram_stride, ram_stride); }
+		// One byte of every instance's RAM -> out[i] = RAM[address] of instance i
+		void gather(u16 address, std::span<u8> out) const;
+
+		// Off after load
+		void set_rendering(bool enabled) { for (const auto& console : _consoles) console->set_rendering(enabled); }
+		[[nodiscard]] std::span<const u8> frame_buffer(u32 instance) const { return _consoles[instance]->frame_buffer(); }
+
+		// Registers of every instance as of the end of the last frame, one entry per instance
+		[[nodiscard]] const CPU::Lockstep& cpus() const { return _lockstep; }
+
+		// The instance's machine, to be changed between frames [state, cartridge RAM, anything run_frame does not cover]
+		[[nodiscard]] Console& console(u32 instance) { return *_consoles[instance]; }
+
+	private:
+		std::vector<u8>							_ram; // Before the consoles -> outlives the RAM attached to it
+		std::vector<std::unique_ptr<Console>>	_consoles;
+		CPU::Lockstep							_lockstep;
+		std::vector<u64>						_targets; // Cycle each instance runs to next, its own cycle once its frame is done
+		std::vector<u64>						_frames; // Frame count each instance is done at
+	};
+}
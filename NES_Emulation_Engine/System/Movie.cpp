@@ -0,0 +1,155 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Movie.h"
+
+namespace NES::System {
+	namespace {
+
+		template<typename T>
+		bool write_items(std::FILE* file, const T* items, u64 count) {
+			return !count || std::fwrite(items, sizeof(T), count, file) == count;
+		}
+
+		template<typename T>
+		bool read_items(std::FILE* file, T* items, u64 count) {
+			return !count || std::fread(items, sizeof(T), count, file) == count;
+		}
+
+		// Bytes from the current position to the end, 0 if the file cannot seek
+		u64 remaining_bytes(std::FILE* file) {
+			const long position = std::ftell(file);
+			if (position < 0 || std::fseek(file, 0, SEEK_END)) return 0;
+			const long end = std::ftell(file);
+			if (end < position || std::fseek(file, position, SEEK_SET)) return 0;
+			return static_cast<u64>(end - position);
+		}
+
+	} // Anonymous Namespace
+
+	bool Movie::begin_recording(const Console& console, bool power_on, u32 checkpoint_interval) {
+		if (!console.cartridge()) return false;
+
+		std::memcpy(_header.magic, magic, sizeof(magic));
+		_header.version = version;
+		_header.checkpoint_interval = std::max<u32>(checkpoint_interval, 1);
+		_header.cartridge = console.cartridge_id();
+		_header.frames = 0;
+		_header.state_size = power_on ? 0 : sizeof(SaveState);
+		_input.clear();
+		_checkpoints.clear();
+
+		_start.reset();
+		if (!power_on) {
+			_start = std::make_unique<SaveState>();
+			if (!console.save_state(*_start)) return false;
+		}
+		_checkpoints.push_back(state_hash(console));
+		_header.checkpoints = _checkpoints.size();
+		return true;
+	}
+
+	void Movie::record_frame(Console& console, u8 port1, u8 port2) {
+		console.set_input(0, port1);
+		console.set_input(1, port2);
+		console.run_frames(1);
+
+		_input.push_back(port1);
+		_input.push_back(port2);
+		if (++_header.frames % _header.checkpoint_interval == 0) {
+			_checkpoints.push_back(state_hash(console));
+			_header.checkpoints = _checkpoints.size();
+		}
+	}
+
+	bool Movie::begin_playback(Console& console, Playback& playback) const {
+		playback = {};
+		if (!console.cartridge() || console.cartridge_id() != _header.cartridge || _checkpoints.empty()) return false;
+		if (_start && !console.load_state(*_start)) return false;
+
+		const u64 hash = state_hash(console);
+		if (hash != _checkpoints[0]) {
+			playback.desync_frame = 0;
+			playback.expected = _checkpoints[0];
+			playback.actual = hash;
+			return false;
+		}
+		playback.checkpoints = 1;
+		return true;
+	}
+
+	bool Movie::play(Console& console, Playback& playback, u64 frames) const {
+		if (!playback.ok()) return false;
+
+		const u64 end = playback.frames + std::min(frames, _header.frames - playback.frames);
+		while (playback.frames < end) {
+			const u64 frame = playback.frames;
+			console.set_input(0, input(frame, 0));
+			console.set_input(1, input(frame, 1));
+			console.run_frames(1);
+			++playback.frames;
+
+			if (playback.frames % _header.checkpoint_interval) continue;
+			const u64 checkpoint = playback.frames / _header.checkpoint_interval;
+			const u64 hash = state_hash(console);
+			if (hash != _checkpoints[checkpoint]) {
+				playback.desync_frame = playback.frames;
+				playback.expected = _checkpoints[checkpoint];
+				playback.actual = hash;
+				return false;
+			}
+			++playback.checkpoints;
+		}
+		return playback.frames < _header.frames;
+	}
+
+	bool Movie::save(const std::string& path) const {
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		if (!file) return false;
+
+		bool written = write_items(file, &_header, 1);
+		if (_start) written = written && write_items(file, _start.get(), 1);
+		written = written && write_items(file, _input.data(), _input.size()) && write_items(file, _checkpoints.data(), _checkpoints.size());
+		return std::fclose(file) == 0 && written;
+	}
+
+	bool Movie::load(const std::string& path) {
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (!file) return false;
+
+		Header header{};
+		bool valid = read_items(file, &header, 1) && !std::memcmp(header.magic, magic, sizeof(magic)) && header.version == version
+			&& header.checkpoint_interval && header.checkpoints == header.frames / header.checkpoint_interval + 1
+			&& (header.state_size == 0 || header.state_size == sizeof(SaveState)); // A state from another build is unusable
+
+		std::unique_ptr<SaveState> start;
+		if (valid && header.state_size) {
+			start = std::make_unique<SaveState>();
+			valid = read_items(file, start.get(), 1) && start->compatible();
+		}
+		// Counts come from the file -> both arrays have to be in it before anything is allocated [no overflow for any u64 pair]
+		if (valid) {
+			const u64 left = remaining_bytes(file);
+			valid = header.frames <= left / 2 && header.checkpoints <= (left - header.frames * 2) / sizeof(u64);
+		}
+		std::vector<u8> input;
+		std::vector<u64> checkpoints;
+		if (valid) {
+			input.resize(header.frames * 2);
+			checkpoints.resize(header.checkpoints);
+			valid = read_items(file, input.data(), input.size()) && read_items(file, checkpoints.data(), checkpoints.size());
+		}
+		std::fclose(file);
+		if (!valid) return false;
+
+		_header = header;
+		_start = std::move(start);
+		_input = std::move(input);
+		_checkpoints = std::move(checkpoints);
+		return true;
+	}
+
+	u64 Movie::state_hash(const Console& console) const {
+		return console.save_state(*_scratch) ? _scratch->hash() : 0;
+	}
+}
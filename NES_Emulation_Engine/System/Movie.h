@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../Common/CommonHeaders.h"
+#include "Console.h"
+
+namespace NES::System {
+
+	// Input Movie | A run of the console kept as its input: the game, where it started and the buttons of both ports for every frame.
+	// Emulation is deterministic, so the same input from the same start reproduces the run exactly. State hashes [SaveState::hash]
+	// taken every checkpoint_interval frames while recording tell a replay whether, and from which frame on, it went its own way.
+	//
+	// File -> [Header] [SaveState, unless power-on] [2 bytes of input per frame] [u64 hash per checkpoint]
+	// Power-on movies carry no state: a SaveState only loads into the build that wrote it, the ROM loaded fresh is the same everywhere.
+	// Checkpoint 0 is the start itself, so a replay that does not start where the recording did fails before its first frame.
+	class Movie {
+	public:
+		static constexpr char magic[8]{ 'N', 'E', 'S', 'M', 'O', 'V', 'I', 'E' };
+		static constexpr u32 version{ 1 };
+
+		struct Header {
+			char	magic[8];
+			u32		version;
+			u32		checkpoint_interval; // Frames between state hashes
+			u64		cartridge; // Console::cartridge_id()
+			u64		frames;
+			u64		checkpoints;
+			u32		state_size; // 0 -> power-on, sizeof(SaveState) -> starts from the state that follows
+			u32		reserved;
+		};
+
+		// Outcome of a replay | Stops at the first checkpoint that does not match
+		struct Playback {
+			u64		frames{ 0 }; // Played
+			u64		checkpoints{ 0 }; // Matched
+			u64		desync_frame{ UINT64_MAX }; // Frame of the first mismatch
+			u64		expected{ 0 }; // Hashes at that frame
+			u64		actual{ 0 };
+
+			[[nodiscard]] bool ok() const { return desync_frame == UINT64_MAX; }
+		};
+
+		// Recording | Starts from the console as it is now, power_on says it was just loaded and then nothing else ran [no state stored]
+		// false without a cartridge
+		[[nodiscard]] bool begin_recording(const Console& console, bool power_on, u32 checkpoint_interval = 60);
+		// Holds the buttons of both ports for one frame, runs it and records it
+		void record_frame(Console& console, u8 port1, u8 port2);
+
+		// Playback | Puts the console at the start [loads the state or checks it is at power-on] and checks checkpoint 0
+		// false if the movie is for another game or the start does not match
+		[[nodiscard]] bool begin_playback(Console& console, Playback& playback) const;
+		// Plays frames more frames [or what is left] unpaced, verifying the checkpoints on the way | false once out of sync or at the end
+		bool play(Console& console, Playback& playback, u64 frames = UINT64_MAX) const;
+
+		[[nodiscard]] bool save(const std::string& path) const;
+		[[nodiscard]] bool load(const std::string& path);
+
+		[[nodiscard]] const Header& header() const { return _header; }
+		[[nodiscard]] u64 frames() const { return _header.frames; }
+		[[nodiscard]] u8 input(u64 frame, u32 port) const { return _input[frame * 2 + (port & 1)]; }
+
+	private:
+		[[nodiscard]] u64 state_hash(const Console& console) const; // Into _scratch
+
+		Header						_header{};
+		std::unique_ptr<SaveState>	_start; // nullptr -> power-on
+		std::vector<u8>				_input; // Port 1, port 2 per frame
+		std::vector<u64>			_checkpoints; // Frame 0, interval, 2 * interval...
+		std::unique_ptr<SaveState>	_scratch{ std::make_unique<SaveState>() }; // Zeroed once -> the unused parts hash the same every time
+	};
+}
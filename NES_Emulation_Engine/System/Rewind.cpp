@@ -0,0 +1,216 @@
+#include <chrono>
+#include <cstring>
+
+#include "Rewind.h"
+
+namespace NES::System {
+	namespace {
+
+		using clock = std::chrono::steady_clock;
+
+		constexpr u64 words{ sizeof(SaveState) / sizeof(u64) };
+
+		u64 elapsed_ns(clock::time_point start) {
+			return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+		}
+
+		u64 load_word(const u8* data) {
+			u64 word;
+			std::memcpy(&word, data, sizeof(word));
+			return word;
+		}
+
+		void write_varint(u8*& out, u64 value) {
+			for (; value >= 0x80; value >>= 7) *out++ = static_cast<u8>(value | 0x80);
+			*out++ = static_cast<u8>(value);
+		}
+
+		bool read_varint(const u8* data, u64 size, u64& position, u64& value) {
+			value = 0;
+			for (u32 shift{ 0 }; shift < 64; shift += 7) {
+				if (position >= size) return false;
+				const u8 byte = data[position++];
+				value |= static_cast<u64>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return true;
+			}
+			return false;
+		}
+
+		// XOR/RLE | base nullptr -> against zero [keyframes] | Returns the encoded size, never 0
+		u32 encode(const SaveState& state, const SaveState* base, u8* out) {
+			const u8* current = reinterpret_cast<const u8*>(&state);
+			const u8* previous = reinterpret_cast<const u8*>(base);
+			const auto changed = [&](u64 word) {
+				return load_word(current + word * 8) != (previous ? load_word(previous + word * 8) : 0);
+			};
+
+			u8* const begin = out;
+			u64 word{ 0 };
+			while (word < words) {
+				const u64 start = word;
+				while (word < words && !changed(word)) ++word;
+				if (word == words) break; // Unchanged to the end -> implied
+
+				const u64 run_start = word;
+				while (word < words && changed(word)) ++word;
+
+				write_varint(out, run_start - start);
+				write_varint(out, word - run_start);
+				for (u64 i{ run_start }; i < word; ++i) {
+					const u64 delta = load_word(current + i * 8) ^ (previous ? load_word(previous + i * 8) : 0);
+					std::memcpy(out, &delta, sizeof(delta));
+					out += sizeof(delta);
+				}
+			}
+			if (out == begin) { // Nothing changed -> one empty run, so no entry is 0 bytes
+				write_varint(out, 0);
+				write_varint(out, 0);
+			}
+			return static_cast<u32>(out - begin);
+		}
+
+		bool decode(const u8* data, u64 size, const SaveState* base, SaveState& state) {
+			u8* out = reinterpret_cast<u8*>(&state);
+			if (base) {
+				std::memcpy(out, base, sizeof(SaveState));
+			} else {
+				std::memset(out, 0, sizeof(SaveState));
+			}
+
+			u64 position{ 0 };
+			u64 word{ 0 };
+			while (position < size) {
+				u64 skip, count;
+				if (!read_varint(data, size, position, skip) || !read_varint(data, size, position, count)) return false;
+				word += skip;
+				if (word > words || count > words - word || count * 8 > size - position) return false;
+
+				for (u64 i{ 0 }; i < count; ++i, ++word, position += 8) {
+					const u64 value = load_word(out + word * 8) ^ load_word(data + position);
+					std::memcpy(out + word * 8, &value, sizeof(value));
+				}
+			}
+			return true;
+		}
+
+	} // Anonymous Namespace
+
+	Rewind::Rewind() : Rewind(Config{}) {}
+
+	Rewind::Rewind(const Config& config) : _config{ config } {
+		_data.resize(_config.capacity);
+		_entries.resize(std::max<u32>(_config.max_snapshots, 1));
+		_state = std::make_unique<SaveState>();
+		_keyframe = std::make_unique<SaveState>();
+		_encoded.resize(words * 10 + 16); // Alternating changed/unchanged words -> 2 varint bytes per 8 data bytes at worst
+		_counters.capacity = _config.capacity;
+	}
+
+	void Rewind::clear() {
+		_oldest = _next = 0;
+		_write = 0;
+		_force_keyframe = true;
+		_counters.snapshots = _counters.keyframes = _counters.bytes_used = 0;
+	}
+
+	bool Rewind::push(const Console& console) {
+		const auto start = clock::now();
+		if (!console.save_state(*_state)) return false;
+
+		if (size() == _entries.size()) drop_oldest_group();
+
+		bool keyframe = _force_keyframe || _since_keyframe + 1 >= _config.keyframe_interval;
+		if (keyframe) {
+			*_keyframe = *_state;
+			_keyframe_sequence = _next;
+		}
+		u32 encoded_size = encode(*_state, keyframe ? nullptr : _keyframe.get(), _encoded.data());
+		u8* out = allocate(encoded_size);
+
+		if (!keyframe && _keyframe_sequence < _oldest) { // Its keyframe was dropped to make room -> starts a new group instead
+			keyframe = true;
+			*_keyframe = *_state;
+			_keyframe_sequence = _next;
+			encoded_size = encode(*_state, nullptr, _encoded.data());
+			out = allocate(encoded_size);
+		}
+		if (!out) return false; // Capacity below a single keyframe
+
+		std::memcpy(out, _encoded.data(), encoded_size);
+		entry(_next) = { static_cast<u64>(out - _data.data()), encoded_size, keyframe, _keyframe_sequence };
+		++_next;
+		_write = (out - _data.data()) + encoded_size;
+
+		_since_keyframe = keyframe ? 0 : _since_keyframe + 1;
+		_force_keyframe = false;
+
+		++_counters.snapshots;
+		_counters.keyframes += keyframe;
+		_counters.bytes_used += encoded_size;
+		++_counters.pushed;
+		_counters.pushed_bytes += encoded_size;
+		_counters.push_ns += elapsed_ns(start);
+		return true;
+	}
+
+	bool Rewind::pop(Console& console) {
+		if (!size()) return false;
+		const auto start = clock::now();
+
+		const u64 sequence = _next - 1;
+		const Entry& newest = entry(sequence);
+		decode_keyframe(newest.keyframe_sequence);
+		const bool decoded = newest.keyframe
+			? (*_state = *_keyframe, true)
+			: decode(_data.data() + newest.offset, newest.size, _keyframe.get(), *_state);
+
+		--_next;
+		--_counters.snapshots;
+		_counters.keyframes -= newest.keyframe;
+		_counters.bytes_used -= newest.size;
+		_write = size() ? newest.offset : 0;
+		_force_keyframe = true; // What follows is a new timeline, the cached keyframe may be an older one now
+
+		if (!decoded || !console.load_state(*_state)) return false;
+		++_counters.rewound;
+		_counters.rewind_ns += elapsed_ns(start);
+		return true;
+	}
+
+	void Rewind::decode_keyframe(u64 sequence) {
+		if (_keyframe_sequence == sequence) return;
+		const Entry& keyframe = entry(sequence);
+		decode(_data.data() + keyframe.offset, keyframe.size, nullptr, *_keyframe);
+		_keyframe_sequence = sequence;
+	}
+
+	// The oldest entry is always a keyframe, the snapshots up to the next keyframe go with it
+	void Rewind::drop_oldest_group() {
+		do {
+			const Entry& oldest = entry(_oldest);
+			--_counters.snapshots;
+			_counters.keyframes -= oldest.keyframe;
+			_counters.bytes_used -= oldest.size;
+			++_oldest;
+		} while (size() && !entry(_oldest).keyframe);
+
+		if (!size()) _write = 0;
+	}
+
+	u8* Rewind::allocate(u32 size) {
+		if (size > _data.size()) return nullptr;
+
+		while (true) {
+			if (!this->size()) return _data.data();
+
+			const u64 oldest = entry(_oldest).offset;
+			if (_write > oldest) { // Free -> [_write, end) and [0, oldest)
+				if (_data.size() - _write >= size) return _data.data() + _write;
+				if (oldest >= size) return _data.data();
+			} else if (oldest - _write >= size) { // Wrapped, free -> [_write, oldest)
+				return _data.data() + _write;
+			}
+			drop_oldest_group();
+		}
+	}
+}
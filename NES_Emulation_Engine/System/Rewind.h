@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+#include "Console.h"
+
+namespace NES::System {
+
+	// Rewind | A save state per frame in a fixed-size ring, each one XOR'd against the last keyframe and run-length coded.
+	// Between two frames only a little RAM, VRAM and a few registers change, so a snapshot is mostly runs of unchanged words.
+	//
+	// Snapshot -> [varint unchanged words] [varint changed words] [changed words XOR keyframe]... over the SaveState as 64-bit words
+	// Keyframe -> the same against zero, every keyframe_interval snapshots [and after a rewind]
+	// When the ring is full the oldest keyframe goes together with the snapshots that depend on it.
+	// Everything is allocated up front, pushing and rewinding allocate nothing.
+	class Rewind {
+	public:
+		struct Config {
+			u64	capacity{ 32ull << 20 }; // Bytes of encoded snapshots
+			u32	max_snapshots{ 60 * 60 * 60 }; // An hour at 60 fps
+			u32	keyframe_interval{ 120 };
+		};
+
+		struct Counters {
+			u64		snapshots{ 0 }; // Held
+			u64		keyframes{ 0 }; // Held
+			u64		bytes_used{ 0 }; // Encoded bytes held
+			u64		capacity{ 0 };
+			u64		pushed{ 0 }; // Since construction
+			u64		pushed_bytes{ 0 }; // Encoded
+			u64		push_ns{ 0 }; // Time spent in push [save state + encode]
+			u64		rewound{ 0 };
+			u64		rewind_ns{ 0 }; // Time spent in pop [decode + load state]
+
+			[[nodiscard]] double bytes_per_snapshot() const { return pushed ? static_cast<double>(pushed_bytes) / pushed : 0.0; }
+			[[nodiscard]] double push_us() const { return pushed ? push_ns * 1e-3 / pushed : 0.0; }
+			[[nodiscard]] double rewind_us() const { return rewound ? rewind_ns * 1e-3 / rewound : 0.0; }
+		};
+
+		Rewind();
+		explicit Rewind(const Config& config);
+
+		// Snapshots the console, once per frame | false if the console cannot be saved [no cartridge]
+		bool push(const Console& console);
+		// Restores the newest snapshot and drops it | false once the ring is empty
+		bool pop(Console& console);
+		void clear();
+
+		[[nodiscard]] u64 size() const { return _next - _oldest; }
+		[[nodiscard]] const Counters& counters() const { return _counters; }
+
+	private:
+		struct Entry {
+			u64		offset; // In _data
+			u32		size;
+			bool	keyframe;
+			u64		keyframe_sequence; // Snapshot it was coded against
+		};
+
+		static constexpr u64 words{ sizeof(SaveState) / sizeof(u64) };
+		static_assert(sizeof(SaveState) % sizeof(u64) == 0);
+
+		[[nodiscard]] Entry& entry(u64 sequence) { return _entries[sequence % _entries.size()]; }
+
+		// Places size bytes at the write position, dropping the oldest keyframe groups until they fit | nullptr if they cannot
+		u8* allocate(u32 size);
+		void drop_oldest_group();
+		void decode_keyframe(u64 sequence); // Into _keyframe
+
+		Config					_config;
+		std::vector<u8>			_data; // Byte ring of encoded snapshots, an entry never wraps
+		std::vector<Entry>		_entries; // Indexed by sequence number
+		u64						_oldest{ 0 }; // Sequence numbers held -> [_oldest, _next)
+		u64						_next{ 0 };
+		u64						_write{ 0 }; // Offset after the newest entry
+
+		std::unique_ptr<SaveState>	_state; // Scratch for the console's state
+		std::unique_ptr<SaveState>	_keyframe; // Decoded keyframe the newest snapshots are coded against
+		u64						_keyframe_sequence{ UINT64_MAX }; // Which one _keyframe holds
+		u32						_since_keyframe{ 0 };
+		bool					_force_keyframe{ true };
+		std::vector<u8>			_encoded; // Worst case sized
+
+		Counters				_counters;
+	};
+}
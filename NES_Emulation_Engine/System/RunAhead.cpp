@@ -0,0 +1,93 @@
+#include "RunAhead.h"
+
+namespace NES::System {
+
+	RunAhead::RunAhead(Console& console, u32 frames, bool threaded) : _console{ console }, _frames{ frames } {
+		_state = std::make_unique<SaveState>();
+		if (!threaded || !_frames) return;
+
+		if (!(_ahead = _console.clone())) return; // Falls back to a single core
+		_ahead->bus().get_apu()->set_sample_rate(0); // Never heard
+		_ahead_valid = _console.save_state(*_state);
+		_worker = std::thread(&RunAhead::work, this);
+	}
+
+	RunAhead::~RunAhead() {
+		if (!_worker.joinable()) return;
+		{
+			std::lock_guard lock(_mutex);
+			_stop = true;
+		}
+		_start.notify_one();
+		_worker.join();
+	}
+
+	bool RunAhead::run_frame() {
+		if (!_frames) {
+			_console.set_rendering(true);
+			_console.run_frames(1);
+			return true;
+		}
+
+		if (threaded()) {
+			if (!_ahead_valid) return false;
+			{
+				std::lock_guard lock(_mutex);
+				_input = { _console.input(0), _console.input(1) }; // The state is from before this frame's input was set
+				_pending = true;
+			}
+			_start.notify_one();
+
+			_console.set_rendering(false);
+			_console.run_frames(1);
+
+			std::unique_lock lock(_mutex);
+			_done.wait(lock, [this] { return !_pending; });
+			lock.unlock();
+			return _ahead_valid = _console.save_state(*_state); // The worker is idle, the state is free to overwrite
+		}
+
+		_console.set_rendering(false);
+		_console.run_frames(1);
+		if (!_console.save_state(*_state)) return false;
+
+		APU::R2A03& apu = *_console.bus().get_apu();
+		apu.set_output_enabled(false);
+		lookahead(_console);
+		apu.set_output_enabled(true);
+		return _console.load_state(*_state);
+	}
+
+	std::span<const u8> RunAhead::frame_buffer() const {
+		return threaded() ? _ahead->frame_buffer() : _console.frame_buffer();
+	}
+
+	void RunAhead::lookahead(Console& machine) {
+		machine.set_rendering(false);
+		machine.run_frames(_frames - 1);
+		machine.set_rendering(true);
+		machine.run_frames(1);
+	}
+
+	// Lookahead on the clone | From the real frame before the one the console is running: that one again, then frames more
+	void RunAhead::work() {
+		while (true) {
+			std::unique_lock lock(_mutex);
+			_start.wait(lock, [this] { return _stop || _pending; });
+			if (_stop) return;
+			lock.unlock();
+
+			if (_ahead->load_state(*_state)) {
+				for (u32 port{ 0 }; port < 2; ++port) _ahead->set_input(port, _input[port]);
+				_ahead->set_rendering(false);
+				_ahead->run_frames(1);
+				lookahead(*_ahead);
+			}
+
+			lock.lock();
+			_pending = false;
+			lock.unlock();
+			_done.notify_one();
+		}
+	}
+}
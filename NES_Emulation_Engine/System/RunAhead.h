@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <span>
+#include <thread>
+
+#include "../Common/CommonHeaders.h"
+#include "Console.h"
+
+namespace NES::System {
+
+	// Run-Ahead | Hides the frames of lag games have between reading input and showing its effect.
+	// Every presented frame the console advances one real frame with the buttons the front end set, the machine is then emulated frames further holding them
+	// and the last of those is what gets presented. Only the real frames are kept, the lookahead is thrown away.
+	//
+	// Single core -> on the console itself: real frame, save state, lookahead, load state.
+	// Threaded -> a clone runs the lookahead on a second core, starting from the previous real frame and emulating that frame too,
+	// while the console runs the same real frame in parallel. The console is never rolled back, the 1 + frames emulated frames run off
+	// the thread that runs the game.
+	// Only the last lookahead frame is rendered and its audio is dropped, the real frames are headless and carry the sound.
+	class RunAhead {
+	public:
+		RunAhead(Console& console, u32 frames, bool threaded);
+		~RunAhead();
+
+		RunAhead(const RunAhead&) = delete;
+		RunAhead& operator=(const RunAhead&) = delete;
+
+		// One presented frame | false if the console cannot be saved or cloned [no cartridge]
+		bool run_frame();
+
+		// The frame to present | frames ahead of the console
+		[[nodiscard]] std::span<const u8> frame_buffer() const;
+
+		[[nodiscard]] u32 frames() const { return _frames; }
+		[[nodiscard]] bool threaded() const { return _worker.joinable(); }
+
+	private:
+		void lookahead(Console& machine); // frames headless, the last one rendered
+		void work();
+
+		Console&					_console;
+		u32							_frames;
+		std::unique_ptr<SaveState>	_state; // Real frame the lookahead starts from
+
+		// Threaded
+		std::unique_ptr<Console>	_ahead;
+		std::thread					_worker;
+		std::mutex					_mutex;
+		std::condition_variable		_start;
+		std::condition_variable		_done;
+		bool						_pending{ false }; // Lookahead requested and not finished
+		bool						_stop{ false };
+		bool						_ahead_valid{ false };
+		std::array<u8, 2>			_input{}; // Buttons held for the frame, both ports
+	};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include "../Common/CommonHeaders.h"
+#include "../CPU/R6502.h"
+#include "../Utilities/Hash.h"
+
+namespace NES::System {
+
+	// Save State | The whole machine as one flat block of plain data: no pointers, nothing allocated, every device copies its members in and out.
+	// The block can be written to disk or copied as it is [host byte order, compiler layout]. The layout is the sum of the devices' State
+	// structs, so changing any of them changes it -> bump version, old states are then rejected instead of misread.
+	struct SaveState {
+		static constexpr char magic[8]{ 'N', 'E', 'S', 'S', 'T', 'A', 'T', 'E' };
+		static constexpr u32 version{ 3 }; // 2 -> controllers, 3 -> DMC fetch cycle
+
+		struct Header {
+			char	magic[8];
+			u32		version;
+			u32		size; // sizeof(SaveState)
+			u64		cartridge; // Console::cartridge_id() -> a state only loads into the game it was taken from
+			u64		cycle; // CPU master cycle when it was taken
+			u64		frame;
+		};
+
+		Header						header;
+		CPU::R6502::State			cpu;
+		CPU::Bus::State				bus; // + RAM
+		PPU::R2C02::State			ppu; // + VRAM, palette, OAM
+		APU::R2A03::State			apu;
+		Cartridge::GameCard::State	cartridge; // Mapper, PRG-RAM, CHR-RAM
+
+		// Magic, version and size match this build
+		[[nodiscard]] bool compatible() const {
+			return !std::memcmp(header.magic, magic, sizeof(magic)) && header.version == version && header.size == sizeof(SaveState);
+		}
+
+		// Fingerprint of the machine | Field by field, so padding and the unused parts of the arrays never count
+		// CPU registers, RAM, VRAM, palette, OAM, PRG-RAM and CHR-RAM: whatever a game does ends up in one of them sooner or later.
+		[[nodiscard]] u64 hash() const {
+			const auto bytes = [](const auto& value) { return std::span<const u8>(reinterpret_cast<const u8*>(&value), sizeof(value)); };
+			u64 value = Utilities::fnv1a(bytes(header.cycle));
+			for (const u8 reg : { cpu.accumulator, cpu.x_register, cpu.y_register, cpu.stack_pointer, cpu.status_register }) {
+				value = Utilities::fnv1a(bytes(reg), value);
+			}
+			value = Utilities::fnv1a(bytes(cpu.program_counter), value);
+			value = Utilities::fnv1a(bus.ram, value);
+			value = Utilities::fnv1a(bytes(ppu.bus.vram), value);
+			value = Utilities::fnv1a(bytes(ppu.bus.palette_ram), value);
+			value = Utilities::fnv1a(ppu.oam, value);
+			value = Utilities::fnv1a(cartridge.mapper.program_ram, value);
+			return Utilities::fnv1a(std::span<const u8>(cartridge.character_ram).first(cartridge.character_ram_size), value);
+		}
+	};
+	static_assert(std::is_trivially_copyable_v<SaveState>);
+}
@@ -0,0 +1,172 @@
+// nes_batch : Batch Runner -> Runs a list of independent ROM sessions across all cores and streams one result per job.
+// A farm host runs one of these over its share of the library: every job reports its throughput and final state hash as it finishes.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../System/BatchRunner.h"
+#include "../APU/R2A03.h"
+
+using namespace NES;
+
+namespace {
+
+	struct Options {
+		std::string	jobs;
+		std::string	results; // JSON lines, one per job as it finishes, none if empty
+		u32			threads{ 0 };
+		bool		pin{ false };
+		u64			repeat{ 1 }; // Every job this many times [scaling runs from a short list]
+	};
+
+	void print_usage() {
+		std::printf(
+			"Usage: nes_batch <jobs.txt> [options]\n"
+			"  --threads N    Worker threads [default one per logical CPU]\n"
+			"  --pin          Bind worker i to the i-th CPU the process may use [machines are then allocated on its NUMA node]\n"
+			"  --results FILE Stream one JSON line per finished job\n"
+			"  --repeat N     Run every job N times\n"
+			"Job file: one job per line, '#' comments\n"
+			"  ROM [frames=N] [movie=FILE] [save-state=FILE]\n"
+			"  frames defaults to 600, or to the whole movie when there is one\n"
+			"Exit code: 0 every job ok, 1 some failed or went out of sync, 2 unreadable job file\n");
+	}
+
+	bool parse_count(const char* text, u64& value) {
+		char* end{ nullptr };
+		value = std::strtoull(text, &end, 0);
+		return end != text && *end == '\0';
+	}
+
+	// Whitespace separated, no quoting | Returns the line of the first bad job in error_line
+	bool read_jobs(const std::string& path, std::vector<System::BatchRunner::Job>& jobs, u64& error_line) {
+		std::FILE* file = std::fopen(path.c_str(), "r");
+		if (!file) return false;
+
+		char line[4096];
+		bool valid{ true };
+		for (error_line = 1; valid && std::fgets(line, sizeof(line), file); ++error_line) {
+			if (char* comment = std::strchr(line, '#')) *comment = '\0';
+
+			System::BatchRunner::Job job;
+			bool frames_set{ false };
+			for (char* token = std::strtok(line, " \t\r\n"); token && valid; token = std::strtok(nullptr, " \t\r\n")) {
+				if (!std::strncmp(token, "frames=", 7)) {
+					valid = parse_count(token + 7, job.frames);
+					frames_set = true;
+				} else if (!std::strncmp(token, "movie=", 6)) {
+					job.movie = token + 6;
+				} else if (!std::strncmp(token, "save-state=", 11)) {
+					job.save_state = token + 11;
+				} else if (job.rom.empty() && !std::strchr(token, '=')) {
+					job.rom = token;
+				} else {
+					valid = false;
+				}
+			}
+			if (!valid) break;
+			if (job.rom.empty()) continue; // Blank
+			if (!job.movie.empty() && !frames_set) job.frames = 0;
+			jobs.push_back(std::move(job));
+		}
+		std::fclose(file);
+		return valid;
+	}
+
+	// ROM paths are written as they are, minus the characters JSON cannot hold unescaped
+	void write_json_string(std::FILE* out, const std::string& text) {
+		std::fputc('"', out);
+		for (const char c : text) {
+			if (c == '"' || c == '\\') std::fputc('\\', out);
+			if (static_cast<unsigned char>(c) >= 0x20) std::fputc(c, out);
+		}
+		std::fputc('"', out);
+	}
+
+	void write_result(std::FILE* out, const System::BatchRunner::Job& job, const System::BatchRunner::Result& result) {
+		std::fprintf(out, "{\"job\": %llu, \"rom\": ", static_cast<unsigned long long>(result.job));
+		write_json_string(out, job.rom);
+		std::fprintf(out, ", \"worker\": %u, \"cpu\": %d, \"ok\": %s, \"error\": ", result.worker, result.cpu, result.ok ? "true" : "false");
+		write_json_string(out, result.error);
+		std::fprintf(out, ", \"frames\": %llu, \"cycles\": %llu, \"seconds\": %.6f, \"cycles_per_second\": %.1f, \"realtime\": %.2f, "
+			"\"state_hash\": \"%016llx\", \"ram_hash\": \"%016llx\"",
+			static_cast<unsigned long long>(result.frames), static_cast<unsigned long long>(result.cycles), result.seconds, result.cycles_per_second(),
+			result.cycles_per_second() / APU::cpu_clock_rate, static_cast<unsigned long long>(result.state_hash), static_cast<unsigned long long>(result.ram_hash));
+		if (result.desync_frame != UINT64_MAX) std::fprintf(out, ", \"desync_frame\": %llu", static_cast<unsigned long long>(result.desync_frame));
+		std::fprintf(out, "}\n");
+		std::fflush(out); // Streamed -> a killed run keeps what finished
+	}
+
+} // Anonymous Namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	bool valid{ true };
+	for (int i{ 1 }; i < argc && valid; ++i) {
+		const char* arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		u64 value{ 0 };
+		if (!std::strcmp(arg, "--threads") && has_value) {
+			valid = parse_count(argv[++i], value) && value <= 4096;
+			options.threads = static_cast<u32>(value);
+		} else if (!std::strcmp(arg, "--pin")) {
+			options.pin = true;
+		} else if (!std::strcmp(arg, "--results") && has_value) {
+			options.results = argv[++i];
+		} else if (!std::strcmp(arg, "--repeat") && has_value) {
+			valid = parse_count(argv[++i], options.repeat) && options.repeat;
+		} else if (arg[0] != '-' && options.jobs.empty()) {
+			options.jobs = arg;
+		} else {
+			valid = false;
+		}
+	}
+	if (!valid || options.jobs.empty()) {
+		print_usage();
+		return 1;
+	}
+
+	std::vector<System::BatchRunner::Job> list;
+	u64 error_line{ 0 };
+	if (!read_jobs(options.jobs, list, error_line)) {
+		std::fprintf(stderr, "nes_batch: cannot read '%s' [line %llu]\n", options.jobs.c_str(), static_cast<unsigned long long>(error_line));
+		return 2;
+	}
+	std::vector<System::BatchRunner::Job> jobs;
+	jobs.reserve(list.size() * options.repeat);
+	for (u64 i{ 0 }; i < options.repeat; ++i) jobs.insert(jobs.end(), list.begin(), list.end());
+
+	std::FILE* results_file{ nullptr };
+	if (!options.results.empty() && !(results_file = std::fopen(options.results.c_str(), "w"))) {
+		std::fprintf(stderr, "nes_batch: cannot write '%s'\n", options.results.c_str());
+		return 2;
+	}
+
+	System::BatchRunner runner({ options.threads, options.pin });
+	const auto start = std::chrono::steady_clock::now();
+	const std::vector<System::BatchRunner::Result> results = runner.run(jobs, [&](const System::BatchRunner::Result& result) {
+		if (results_file) write_result(results_file, jobs[result.job], result);
+	});
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (results_file) std::fclose(results_file);
+	if (runner.pin_failures()) std::fprintf(stderr, "nes_batch: %u of %u workers could not be pinned and ran unpinned\n", runner.pin_failures(), runner.threads());
+
+	u64 failed{ 0 }, cycles{ 0 }, frames{ 0 };
+	for (const System::BatchRunner::Result& result : results) {
+		failed += !result.ok;
+		cycles += result.cycles;
+		frames += result.frames;
+		if (!result.ok) std::fprintf(stderr, "nes_batch: job %llu [%s]: %s\n", static_cast<unsigned long long>(result.job), jobs[result.job].rom.c_str(), result.error.c_str());
+	}
+	const double cycles_per_second = seconds > 0.0 ? cycles / seconds : 0.0;
+
+	std::printf("jobs:               %llu [%llu failed]\n", static_cast<unsigned long long>(jobs.size()), static_cast<unsigned long long>(failed));
+	std::printf("threads:            %u%s, %llu steals\n", runner.threads(), options.pin ? " [pinned]" : "", static_cast<unsigned long long>(runner.steals()));
+	std::printf("frames:             %llu\n", static_cast<unsigned long long>(frames));
+	std::printf("elapsed:            %.3f s\n", seconds);
+	std::printf("cycles per second:  %.0f [%.1fx real time over all jobs]\n", cycles_per_second, cycles_per_second / APU::cpu_clock_rate);
+	return failed ? 1 : 0;
+}
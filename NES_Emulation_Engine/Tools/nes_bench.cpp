@@ -0,0 +1,71 @@
+// nes_bench : Micro-Benchmark Suite -> CPU dispatch, Bus decode, mapper, RAM and PPU scanline cases.
+// Prints a table, and with --json the results in a machine-readable form for tracking regressions between commits.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../Benchmarks/Benchmark.h"
+
+using namespace NES;
+
+namespace {
+
+	void print_usage() {
+		std::printf(
+			"Usage: nes_bench [options]\n"
+			"  --json FILE    Write the results as JSON [- -> stdout, the table moves to stderr]\n"
+			"  --filter TEXT  Only run cases whose name contains TEXT\n"
+			"  --repeat N     Runs per case, the fastest counts [default 5]\n"
+			"  --scale F      Multiply every case's op count [default 1.0]\n");
+	}
+
+	bool parse_options(int argc, char** argv, Benchmarks::Options& options, std::string& json) {
+		for (int i{ 1 }; i < argc; ++i) {
+			const char* arg = argv[i];
+			if (i + 1 >= argc) return false; // Every option takes a value
+
+			if (!std::strcmp(arg, "--json")) {
+				json = argv[++i];
+			} else if (!std::strcmp(arg, "--filter")) {
+				options.filter = argv[++i];
+			} else if (!std::strcmp(arg, "--repeat")) {
+				options.repeat = static_cast<u32>(std::strtoul(argv[++i], nullptr, 0));
+			} else if (!std::strcmp(arg, "--scale")) {
+				options.scale = std::strtod(argv[++i], nullptr);
+			} else {
+				return false;
+			}
+		}
+		return options.scale > 0.0;
+	}
+
+} // Anonymous Namespace
+
+int main(int argc, char** argv) {
+	Benchmarks::Options options;
+	std::string json;
+	if (!parse_options(argc, argv, options, json)) {
+		print_usage();
+		return 1;
+	}
+
+	Benchmarks::Suite suite(options);
+	Benchmarks::run_micro_benchmarks(suite);
+
+	const bool json_to_stdout = json == "-";
+	suite.print_table(json_to_stdout ? stderr : stdout);
+
+	if (json_to_stdout) {
+		suite.write_json(stdout);
+	} else if (!json.empty()) {
+		std::FILE* file = std::fopen(json.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "nes_bench: cannot write '%s'\n", json.c_str());
+			return 2;
+		}
+		suite.write_json(file);
+		std::fclose(file);
+	}
+	return 0;
+}
@@ -0,0 +1,229 @@
+// nes_movie : Input Movies -> Records the controller input of a run and replays it unpaced, checking the state hashes on the way.
+// Regression runs over a game library: record a movie per game once, then every build plays them all and reports the first frame
+// any of them goes out of sync.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../System/Console.h"
+#include "../System/Movie.h"
+#include "../APU/R2A03.h"
+
+using namespace NES;
+
+namespace {
+
+	struct Options {
+		u64			frames{ 600 };
+		u64			interval{ 60 };
+		std::string	input; // Input script, none if empty
+		u64			random{ 0 }; // Seed of random input, none if 0
+		std::string	load_state; // Start from a save state instead of power-on
+		bool		render{ false };
+	};
+
+	// Input change | From frame on, the ports hold these buttons
+	struct InputChange {
+		u64		frame;
+		u8		port1;
+		u8		port2;
+	};
+
+	void print_usage() {
+		std::printf(
+			"Usage: nes_movie <command> ...\n"
+			"  record ROM MOVIE [options]   Runs the ROM and records its input\n"
+			"    --frames N                 Frames to record [default 600]\n"
+			"    --input FILE               Input script, lines of 'frame port1 [port2]' -> buttons held from that frame on\n"
+			"                               [bits: 0x01 A, 0x02 B, 0x04 Select, 0x08 Start, 0x10 Up, 0x20 Down, 0x40 Left, 0x80 Right]\n"
+			"    --random SEED              Random buttons, new ones every 8 frames\n"
+			"    --interval N               Frames between state hashes [default 60]\n"
+			"    --load-state FILE          Start from a save state instead of power-on [movie only plays on this build]\n"
+			"  play ROM MOVIE [--render]    Replays unpaced and checks every state hash\n"
+			"  info MOVIE                   Header of a movie\n"
+			"Exit code of play: 0 in sync, 1 out of sync, 2 unreadable\n");
+	}
+
+	bool parse_count(const char* text, u64& value) {
+		char* end{ nullptr };
+		value = std::strtoull(text, &end, 0);
+		return end != text && *end == '\0';
+	}
+
+	// '#' starts a comment, numbers as strtoull reads them [0x.. hex]
+	bool read_input_script(const std::string& path, std::vector<InputChange>& changes) {
+		std::FILE* file = std::fopen(path.c_str(), "r");
+		if (!file) return false;
+
+		char line[256];
+		bool valid{ true };
+		while (valid && std::fgets(line, sizeof(line), file)) {
+			if (char* comment = std::strchr(line, '#')) *comment = '\0';
+			unsigned long long frame, port1, port2{ 0 };
+			const int fields = std::sscanf(line, "%lli %lli %lli", &frame, &port1, &port2);
+			if (fields <= 0) continue; // Blank
+			valid = fields >= 2 && port1 <= 0xFF && port2 <= 0xFF && (changes.empty() || frame >= changes.back().frame);
+			if (valid) changes.push_back({ frame, static_cast<u8>(port1), static_cast<u8>(port2) });
+		}
+		std::fclose(file);
+		return valid;
+	}
+
+	bool load_console(System::Console& console, const std::string& rom) {
+		if (console.load(rom)) return true;
+		std::fprintf(stderr, "nes_movie: cannot load '%s' [missing, truncated or unsupported mapper]\n", rom.c_str());
+		return false;
+	}
+
+	int record(const std::string& rom, const std::string& path, const Options& options) {
+		std::vector<InputChange> changes;
+		if (!options.input.empty() && !read_input_script(options.input, changes)) {
+			std::fprintf(stderr, "nes_movie: cannot read input script '%s'\n", options.input.c_str());
+			return 2;
+		}
+
+		System::Console console;
+		if (!load_console(console, rom)) return 2;
+		console.set_rendering(options.render);
+		console.bus().get_apu()->set_sample_rate(0);
+
+		if (!options.load_state.empty()) {
+			const auto state = std::make_unique<System::SaveState>();
+			std::FILE* file = std::fopen(options.load_state.c_str(), "rb");
+			const bool read = file && std::fread(state.get(), sizeof(*state), 1, file) == 1;
+			if (file) std::fclose(file);
+			if (!read || !console.load_state(*state)) {
+				std::fprintf(stderr, "nes_movie: cannot load state '%s' [missing, from another build or another ROM]\n", options.load_state.c_str());
+				return 2;
+			}
+		}
+
+		System::Movie movie;
+		if (!movie.begin_recording(console, options.load_state.empty(), static_cast<u32>(options.interval))) return 2;
+
+		u64 random = options.random;
+		u8 port1{ 0 }, port2{ 0 };
+		u64 next_change{ 0 };
+		for (u64 frame{ 0 }; frame < options.frames; ++frame) {
+			for (; next_change < changes.size() && changes[next_change].frame <= frame; ++next_change) {
+				port1 = changes[next_change].port1;
+				port2 = changes[next_change].port2;
+			}
+			if (random && frame % 8 == 0) { // xorshift64
+				random ^= random << 13;
+				random ^= random >> 7;
+				random ^= random << 17;
+				port1 = static_cast<u8>(random);
+				port2 = static_cast<u8>(random >> 8);
+			}
+			movie.record_frame(console, port1, port2);
+		}
+
+		if (!movie.save(path)) {
+			std::fprintf(stderr, "nes_movie: cannot write '%s'\n", path.c_str());
+			return 2;
+		}
+		std::printf("recorded:           %llu frames, %llu checkpoints\n", static_cast<unsigned long long>(movie.frames()),
+			static_cast<unsigned long long>(movie.header().checkpoints));
+		return 0;
+	}
+
+	int play(const std::string& rom, const std::string& path, const Options& options) {
+		System::Movie movie;
+		if (!movie.load(path)) {
+			std::fprintf(stderr, "nes_movie: cannot read '%s' [missing, not a movie or its state is from another build]\n", path.c_str());
+			return 2;
+		}
+
+		System::Console console;
+		if (!load_console(console, rom)) return 2;
+		console.set_rendering(options.render);
+		console.bus().get_apu()->set_sample_rate(0); // Unpaced, nobody listens
+
+		System::Movie::Playback playback;
+		const auto start = std::chrono::steady_clock::now();
+		const u64 start_cycle = console.get_cycle();
+		if (!movie.begin_playback(console, playback) && playback.ok()) {
+			std::fprintf(stderr, "nes_movie: '%s' was recorded on another ROM\n", path.c_str());
+			return 2;
+		}
+		movie.play(console, playback);
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const double emulated = (console.get_cycle() - start_cycle) / APU::cpu_clock_rate;
+
+		std::printf("frames:             %llu of %llu\n", static_cast<unsigned long long>(playback.frames), static_cast<unsigned long long>(movie.frames()));
+		std::printf("checkpoints:        %llu matched\n", static_cast<unsigned long long>(playback.checkpoints));
+		std::printf("elapsed:            %.3f s [%.1f fps, %.1fx real time]\n", seconds, seconds > 0.0 ? playback.frames / seconds : 0.0,
+			seconds > 0.0 ? emulated / seconds : 0.0);
+		if (!playback.ok()) {
+			std::printf("out of sync:        at frame %llu [expected %016llx, got %016llx]\n", static_cast<unsigned long long>(playback.desync_frame),
+				static_cast<unsigned long long>(playback.expected), static_cast<unsigned long long>(playback.actual));
+			return 1;
+		}
+		std::printf("in sync\n");
+		return 0;
+	}
+
+	int info(const std::string& path) {
+		System::Movie movie;
+		if (!movie.load(path)) {
+			std::fprintf(stderr, "nes_movie: cannot read '%s' [missing, not a movie or its state is from another build]\n", path.c_str());
+			return 2;
+		}
+		const System::Movie::Header& header = movie.header();
+		std::printf("cartridge:          %016llx\n", static_cast<unsigned long long>(header.cartridge));
+		std::printf("start:              %s\n", header.state_size ? "save state" : "power-on");
+		std::printf("frames:             %llu\n", static_cast<unsigned long long>(header.frames));
+		std::printf("checkpoints:        %llu [every %u frames]\n", static_cast<unsigned long long>(header.checkpoints), header.checkpoint_interval);
+		return 0;
+	}
+
+} // Anonymous Namespace
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		print_usage();
+		return 1;
+	}
+	const std::string command = argv[1];
+	const int files = command == "info" ? 1 : 2;
+	if (argc < 2 + files) {
+		print_usage();
+		return 1;
+	}
+
+	Options options;
+	bool valid{ true };
+	for (int i{ 2 + files }; i < argc && valid; ++i) {
+		const char* arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (!std::strcmp(arg, "--frames") && has_value) {
+			valid = parse_count(argv[++i], options.frames);
+		} else if (!std::strcmp(arg, "--interval") && has_value) {
+			valid = parse_count(argv[++i], options.interval) && options.interval && options.interval <= UINT32_MAX;
+		} else if (!std::strcmp(arg, "--input") && has_value) {
+			options.input = argv[++i];
+		} else if (!std::strcmp(arg, "--random") && has_value) {
+			valid = parse_count(argv[++i], options.random);
+		} else if (!std::strcmp(arg, "--load-state") && has_value) {
+			options.load_state = argv[++i];
+		} else if (!std::strcmp(arg, "--render")) {
+			options.render = true;
+		} else {
+			valid = false;
+		}
+	}
+	if (!valid) {
+		print_usage();
+		return 1;
+	}
+
+	if (command == "record") return record(argv[2], argv[3], options);
+	if (command == "play") return play(argv[2], argv[3], options);
+	if (command == "info") return info(argv[2]);
+	print_usage();
+	return 1;
+}
@@ -0,0 +1,265 @@
+// nes_run : Headless Runner -> Loads a ROM, runs it unpaced for a number of frames or cycles and reports the final state and throughput.
+// The base for throughput measurements and regression runs: same ROM + same count -> same hashes.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "../System/Console.h"
+#include "../System/Rewind.h"
+#include "../System/RunAhead.h"
+#include "../CPU/TraceFile.h"
+#include "../Utilities/Hash.h"
+#include "../APU/R2A03.h"
+
+using namespace NES;
+
+namespace {
+
+	struct Options {
+		std::string	rom;
+		u64			frames{ 600 };
+		u64			cycles{ 0 }; // Overrides frames when set
+		bool		render{ true };
+		bool		dump_ram{ false };
+		std::string	trace; // Instruction trace file, none if empty
+		bool		trace_binary{ false };
+		std::string	record; // Compressed trace for nes_trace, none if empty
+		std::string	load_state; // Save state to start from
+		std::string	save_state; // Save state written at the end
+		u64			rewind{ 0 }; // Frames to rewind and run again at the end
+		u64			run_ahead{ 0 }; // Frames presented ahead of the emulation
+		bool		run_ahead_threaded{ false };
+		std::string	dynarec; // off | on | verify, the build's default if empty
+	};
+
+	void print_usage() {
+		std::printf(
+			"Usage: nes_run <rom.nes> [options]\n"
+			"  --frames N     Run N frames [default 600]\n"
+			"  --cycles N     Run N CPU cycles instead\n"
+			"  --no-render    Skip pixel output [no framebuffer hash]\n"
+			"  --dump-ram     Hex dump of the 2KB RAM at the end\n"
+			"  --trace FILE   Instruction trace as nestest-style text\n"
+			"  --trace-bin FILE  Instruction trace as fixed-size binary records\n"
+			"  --record FILE  Compressed instruction trace [read with nes_trace, not with --trace or --trace-bin]\n"
+			"  --load-state FILE  Start from a save state of the same ROM\n"
+			"  --save-state FILE  Write a save state at the end\n"
+			"  --rewind N     Snapshot every frame, then rewind N frames and run them again [same final hashes]\n"
+			"  --run-ahead N  Present the frame N frames ahead [framebuffer hash = plain run of frames + N]\n"
+			"  --run-ahead-threaded  Do the run-ahead lookahead on a second core\n"
+			"  --dynarec MODE off | on | verify [every translated block checked against the interpreter, needs CPU_DYNAREC]\n");
+	}
+
+	bool parse_count(const char* text, u64& value) {
+		char* end{ nullptr };
+		value = std::strtoull(text, &end, 0);
+		return end != text && *end == '\0';
+	}
+
+	bool parse_options(int argc, char** argv, Options& options) {
+		for (int i{ 1 }; i < argc; ++i) {
+			const char* arg = argv[i];
+			const bool has_value = i + 1 < argc;
+
+			if (!std::strcmp(arg, "--frames") && has_value) {
+				if (!parse_count(argv[++i], options.frames)) return false;
+			} else if (!std::strcmp(arg, "--cycles") && has_value) {
+				if (!parse_count(argv[++i], options.cycles)) return false;
+			} else if (!std::strcmp(arg, "--no-render")) {
+				options.render = false;
+			} else if (!std::strcmp(arg, "--dump-ram")) {
+				options.dump_ram = true;
+			} else if ((!std::strcmp(arg, "--trace") || !std::strcmp(arg, "--trace-bin")) && has_value) {
+				options.trace_binary = !std::strcmp(arg, "--trace-bin");
+				options.trace = argv[++i];
+			} else if (!std::strcmp(arg, "--record") && has_value) {
+				options.record = argv[++i];
+			} else if (!std::strcmp(arg, "--load-state") && has_value) {
+				options.load_state = argv[++i];
+			} else if (!std::strcmp(arg, "--save-state") && has_value) {
+				options.save_state = argv[++i];
+			} else if (!std::strcmp(arg, "--rewind") && has_value) {
+				if (!parse_count(argv[++i], options.rewind)) return false;
+			} else if (!std::strcmp(arg, "--run-ahead") && has_value) {
+				if (!parse_count(argv[++i], options.run_ahead)) return false;
+			} else if (!std::strcmp(arg, "--run-ahead-threaded")) {
+				options.run_ahead_threaded = true;
+			} else if (!std::strcmp(arg, "--dynarec") && has_value) {
+				options.dynarec = argv[++i];
+				if (options.dynarec != "off" && options.dynarec != "on" && options.dynarec != "verify") return false;
+			} else if (arg[0] != '-' && options.rom.empty()) {
+				options.rom = arg;
+			} else {
+				return false;
+			}
+		}
+		// Rewind and run-ahead work in frames, run-ahead emulates frames twice so it does not trace
+		// The CPU takes one trace sink -> a text or binary trace and a recording cannot be written in the same run
+		const bool traced = !options.trace.empty() || !options.record.empty();
+		if (!options.trace.empty() && !options.record.empty()) return false;
+		return !options.rom.empty() && !(options.rewind && options.cycles) && !(options.run_ahead && (options.cycles || options.rewind || traced));
+	}
+
+	// Save state files are the SaveState block as it is
+	bool read_state(const std::string& path, System::SaveState& state) {
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (!file) return false;
+		const bool read = std::fread(&state, sizeof(state), 1, file) == 1;
+		std::fclose(file);
+		return read;
+	}
+
+	bool write_state(const std::string& path, const System::SaveState& state) {
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		if (!file) return false;
+		const bool written = std::fwrite(&state, sizeof(state), 1, file) == 1;
+		return std::fclose(file) == 0 && written;
+	}
+
+	void dump_ram(std::span<const u8> ram) {
+		for (u32 row{ 0 }; row < ram.size(); row += 16) {
+			std::printf("%04X:", row);
+			for (u32 i{ 0 }; i < 16; ++i) std::printf(" %02X", ram[row + i]);
+			std::printf("\n");
+		}
+	}
+
+} // Anonymous Namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parse_options(argc, argv, options)) {
+		print_usage();
+		return 1;
+	}
+
+	System::Console console;
+	if (!console.load(options.rom)) {
+		std::fprintf(stderr, "nes_run: cannot load '%s' [missing, truncated or unsupported mapper]\n", options.rom.c_str());
+		return 2;
+	}
+	console.set_rendering(options.render);
+	console.bus().get_apu()->set_sample_rate(0); // Nobody listens -> no synthesis
+#if CPU_DYNAREC
+	if (!options.dynarec.empty()) {
+		console.cpu().set_dynarec(options.dynarec == "off" ? CPU::Dynarec::Mode::Off : options.dynarec == "on" ? CPU::Dynarec::Mode::On : CPU::Dynarec::Mode::Verify);
+	}
+#else
+	if (!options.dynarec.empty() && options.dynarec != "off") {
+		std::fprintf(stderr, "nes_run: built without the dynarec [CPU_DYNAREC=1 on x86-64]\n");
+		return 1;
+	}
+#endif // CPU_DYNAREC
+
+	const auto state = std::make_unique<System::SaveState>();
+	if (!options.load_state.empty() && !(read_state(options.load_state, *state) && console.load_state(*state))) {
+		std::fprintf(stderr, "nes_run: cannot load state '%s' [missing, from another build or another ROM]\n", options.load_state.c_str());
+		return 2;
+	}
+
+	const u64 start_cycle = console.get_cycle();
+	const u64 start_frame = console.get_frame_count();
+
+	std::FILE* trace_file{ nullptr };
+	if (!options.trace.empty() && !(trace_file = std::fopen(options.trace.c_str(), options.trace_binary ? "wb" : "w"))) {
+		std::fprintf(stderr, "nes_run: cannot write '%s'\n", options.trace.c_str());
+		return 2;
+	}
+	std::unique_ptr<CPU::TraceRecorder> recorder;
+	if (!options.record.empty() && !(recorder = std::make_unique<CPU::TraceRecorder>(options.record))->is_open()) {
+		std::fprintf(stderr, "nes_run: cannot write '%s'\n", options.record.c_str());
+		return 2;
+	}
+
+	std::unique_ptr<System::Rewind> rewind;
+	if (options.rewind) rewind = std::make_unique<System::Rewind>();
+
+	std::unique_ptr<System::RunAhead> run_ahead;
+	if (options.run_ahead) run_ahead = std::make_unique<System::RunAhead>(console, static_cast<u32>(options.run_ahead), options.run_ahead_threaded);
+
+	const auto run = [&](auto&& sink) {
+		if (run_ahead) {
+			for (u64 frame{ 0 }; frame < options.frames; ++frame) run_ahead->run_frame();
+		} else if (options.cycles) {
+			console.run_cycles(options.cycles, sink);
+		} else if (rewind) {
+			for (u64 frame{ 0 }; frame < options.frames; ++frame) {
+				console.run_frames(1, sink);
+				rewind->push(console);
+			}
+		} else {
+			console.run_frames(options.frames, sink);
+		}
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+	if (recorder) {
+		run(*recorder);
+		recorder->close(); // Timed too, the run is not done until the writer has caught up
+	} else if (!trace_file) {
+		run(CPU::NullTrace{});
+	} else if (options.trace_binary) {
+		CPU::BinaryTrace trace(trace_file);
+		run(trace);
+	} else {
+		run(CPU::TextTrace(trace_file));
+	}
+	const auto end = std::chrono::steady_clock::now();
+	if (trace_file) std::fclose(trace_file);
+
+	if (rewind) { // The newest snapshot is the current frame -> one more pop lands options.rewind frames back
+		u64 rewound{ 0 };
+		while (rewound <= options.rewind && rewind->pop(console)) ++rewound;
+		if (rewound) console.run_frames(rewound - 1);
+	}
+
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	const u64 cycles = console.get_cycle() - start_cycle;
+	const u64 frames = console.get_frame_count() - start_frame;
+	const double cycles_per_second = seconds > 0.0 ? cycles / seconds : 0.0;
+
+	std::printf("rom:                %s [mapper %u]\n", options.rom.c_str(), static_cast<u32>(console.cartridge()->get_info().mapper_id));
+	std::printf("frames:             %llu\n", static_cast<unsigned long long>(frames));
+	std::printf("cpu cycles:         %llu [total %llu]\n", static_cast<unsigned long long>(cycles), static_cast<unsigned long long>(console.get_cycle()));
+	std::printf("ppu dots:           %llu\n", static_cast<unsigned long long>(cycles * 3));
+	std::printf("ram hash:           %016llx\n", static_cast<unsigned long long>(Utilities::fnv1a(console.ram())));
+	if (options.render) {
+		const std::span<const u8> frame_buffer = run_ahead ? run_ahead->frame_buffer() : console.frame_buffer(); // Presented frame
+		std::printf("framebuffer hash:   %016llx\n", static_cast<unsigned long long>(Utilities::fnv1a(frame_buffer)));
+	}
+	std::printf("elapsed:            %.3f s\n", seconds);
+	std::printf("cycles per second:  %.0f [%.1fx real time, %.1f fps]\n", cycles_per_second,
+		cycles_per_second / APU::cpu_clock_rate, seconds > 0.0 ? frames / seconds : 0.0);
+
+	if (recorder) {
+		std::printf("recorded:           %llu instructions, %llu bytes\n", static_cast<unsigned long long>(recorder->entries()),
+			static_cast<unsigned long long>(recorder->bytes_written()));
+	}
+#if CPU_DYNAREC
+	if (const CPU::Dynarec::Counters* counters = console.cpu().dynarec_counters()) {
+		const u64 instructions = counters->native_instructions + counters->interpreted_instructions;
+		std::printf("dynarec:            %llu blocks, %.1f%% of instructions native [%llu flushes]\n", static_cast<unsigned long long>(counters->blocks),
+			instructions ? 100.0 * counters->native_instructions / instructions : 0.0, static_cast<unsigned long long>(counters->flushes));
+		if (console.cpu().get_dynarec() == CPU::Dynarec::Mode::Verify) {
+			std::printf("dynarec verify:     %llu block runs, %llu mismatches", static_cast<unsigned long long>(counters->verified),
+				static_cast<unsigned long long>(counters->mismatches));
+			if (counters->mismatches) std::printf(" [first at $%04X]", counters->first_mismatch);
+			std::printf("\n");
+		}
+	}
+#endif // CPU_DYNAREC
+	if (rewind) {
+		const System::Rewind::Counters& counters = rewind->counters();
+		std::printf("rewind:             %llu snapshots held [%llu keyframes], %.2f MB of %.2f MB\n", static_cast<unsigned long long>(counters.snapshots),
+			static_cast<unsigned long long>(counters.keyframes), counters.bytes_used / 1048576.0, counters.capacity / 1048576.0);
+		std::printf("rewind cost:        %.0f bytes/snapshot, %.2f us/push, %.2f us/pop\n", counters.bytes_per_snapshot(), counters.push_us(), counters.rewind_us());
+	}
+	if (!options.save_state.empty() && !(console.save_state(*state) && write_state(options.save_state, *state))) {
+		std::fprintf(stderr, "nes_run: cannot write state '%s'\n", options.save_state.c_str());
+		return 2;
+	}
+	if (options.dump_ram) dump_ram(console.ram());
+	return 0;
+}
@@ -0,0 +1,138 @@
+// nes_trace : Trace Reader -> Inspects the compressed traces nes_run --record writes.
+// Finding a desync: record the good and the bad build on the same ROM and count, then diff them for the first instruction they disagree on.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "../CPU/TraceFile.h"
+
+using namespace NES;
+
+namespace {
+
+	void print_usage() {
+		std::printf(
+			"Usage: nes_trace <command> ...\n"
+			"  info FILE                                Blocks, entries, cycle range and size\n"
+			"  dump FILE [--cycle C] [--count N]        Entries from cycle C [default start], N of them [default 32]\n"
+			"  diff A B [--cycle C] [--context N]       First entry the traces differ on, with N entries before it [default 8]\n"
+			"Exit code of diff: 0 identical, 1 different, 2 unreadable\n");
+	}
+
+	bool parse_count(const char* text, u64& value) {
+		char* end{ nullptr };
+		value = std::strtoull(text, &end, 0);
+		return end != text && *end == '\0';
+	}
+
+	void print_entry(const char* prefix, const CPU::TraceEntry& entry) {
+		std::printf("%s%04X  %02X %-4s A:%02X X:%02X Y:%02X P:%02X SP:%02X CYC:%llu\n", prefix, entry.pc, entry.opcode, CPU::opcode_name(entry.opcode),
+			entry.a, entry.x, entry.y, entry.p, entry.sp, static_cast<unsigned long long>(entry.cycle));
+	}
+
+	bool open(CPU::TraceReader& reader, const std::string& path) {
+		if (reader.open(path)) return true;
+		std::fprintf(stderr, "nes_trace: cannot read '%s' [missing or not a trace]\n", path.c_str());
+		return false;
+	}
+
+	int info(const std::string& path) {
+		CPU::TraceReader reader;
+		if (!open(reader, path)) return 2;
+
+		std::printf("blocks:             %llu\n", static_cast<unsigned long long>(reader.blocks()));
+		std::printf("instructions:       %llu\n", static_cast<unsigned long long>(reader.entries()));
+		std::printf("cycles:             %llu - %llu\n", static_cast<unsigned long long>(reader.first_cycle()), static_cast<unsigned long long>(reader.last_cycle()));
+		std::printf("file size:          %llu bytes\n", static_cast<unsigned long long>(reader.file_size()));
+		if (reader.entries()) {
+			std::printf("bytes per entry:    %.3f [%.1fx smaller than raw]\n", static_cast<double>(reader.file_size()) / reader.entries(),
+				static_cast<double>(reader.entries() * sizeof(CPU::TraceEntry)) / reader.file_size());
+		}
+		return 0;
+	}
+
+	int dump(const std::string& path, u64 cycle, u64 count) {
+		CPU::TraceReader reader;
+		if (!open(reader, path)) return 2;
+		if (!reader.seek(cycle)) return 0;
+
+		CPU::TraceEntry entry;
+		for (u64 i{ 0 }; i < count && reader.next(entry); ++i) print_entry("", entry);
+		return 0;
+	}
+
+	int diff(const std::string& path_a, const std::string& path_b, u64 cycle, u64 context) {
+		CPU::TraceReader a, b;
+		if (!open(a, path_a) || !open(b, path_b)) return 2;
+		const bool has_a = a.seek(cycle);
+		const bool has_b = b.seek(cycle);
+
+		std::vector<CPU::TraceEntry> history; // Last context entries both agreed on
+		u64 compared{ 0 };
+		CPU::TraceEntry entry_a, entry_b;
+		while (true) {
+			const bool more_a = has_a && a.next(entry_a);
+			const bool more_b = has_b && b.next(entry_b);
+			if (!more_a && !more_b) {
+				std::printf("identical: %llu instructions\n", static_cast<unsigned long long>(compared));
+				return 0;
+			}
+			if (more_a != more_b || entry_a != entry_b) {
+				std::printf("first difference after %llu identical instructions\n", static_cast<unsigned long long>(compared));
+				for (const CPU::TraceEntry& entry : history) print_entry("  ", entry);
+				if (more_a) print_entry("A ", entry_a); else std::printf("A <end of trace>\n");
+				if (more_b) print_entry("B ", entry_b); else std::printf("B <end of trace>\n");
+				return 1;
+			}
+
+			++compared;
+			if (context) {
+				if (history.size() == context) history.erase(history.begin());
+				history.push_back(entry_a);
+			}
+		}
+	}
+
+} // Anonymous Namespace
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		print_usage();
+		return 1;
+	}
+	const std::string command = argv[1];
+	const int files = command == "diff" ? 2 : 1;
+	if (argc < 2 + files) {
+		print_usage();
+		return 1;
+	}
+
+	u64 cycle{ 0 };
+	u64 count{ 32 };
+	u64 context{ 8 };
+	bool valid{ true };
+	for (int i{ 2 + files }; i < argc && valid; ++i) {
+		const char* arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (!std::strcmp(arg, "--cycle") && has_value) {
+			valid = parse_count(argv[++i], cycle);
+		} else if (!std::strcmp(arg, "--count") && has_value) {
+			valid = parse_count(argv[++i], count);
+		} else if (!std::strcmp(arg, "--context") && has_value) {
+			valid = parse_count(argv[++i], context);
+		} else {
+			valid = false;
+		}
+	}
+	if (!valid) {
+		print_usage();
+		return 1;
+	}
+
+	if (command == "info") return info(argv[2]);
+	if (command == "dump") return dump(argv[2], cycle, count);
+	if (command == "diff") return diff(argv[2], argv[3], cycle, context);
+	print_usage();
+	return 1;
+}
@@ -0,0 +1,102 @@
+#include <cstring>
+
+#include "BlockCompression.h"
+
+namespace NES::Utilities {
+	namespace {
+
+		u32 read_u32(const u8* data) {
+			u32 value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		void write_length(std::vector<u8>& out, u64 length) { // Extension bytes of a count that reached 15
+			for (; length >= 255; length -= 255) out.push_back(255);
+			out.push_back(static_cast<u8>(length));
+		}
+
+		bool read_length(const u8* data, u64 size, u64& position, u64& length) {
+			u8 byte;
+			do {
+				if (position >= size) return false;
+				byte = data[position++];
+				length += byte;
+			} while (byte == 255);
+			return true;
+		}
+
+		void write_sequence(std::vector<u8>& out, const u8* literals, u64 literal_count, u32 offset, u64 match_length) {
+			const u64 match_code = match_length ? match_length - BlockCompressor::min_match : 0;
+			out.push_back(static_cast<u8>((std::min<u64>(literal_count, 15) << 4) | std::min<u64>(match_code, 15)));
+			if (literal_count >= 15) write_length(out, literal_count - 15);
+			out.insert(out.end(), literals, literals + literal_count);
+
+			if (!match_length) return; // Last sequence
+			out.push_back(static_cast<u8>(offset));
+			out.push_back(static_cast<u8>(offset >> 8));
+			if (match_code >= 15) write_length(out, match_code - 15);
+		}
+
+	} // Anonymous Namespace
+
+	void BlockCompressor::compress(const u8* data, u64 size, std::vector<u8>& out) {
+		out.clear();
+		std::fill(_table.begin(), _table.end(), 0);
+
+		u64 anchor{ 0 }; // Start of the pending literals
+		u64 position{ 0 };
+		const u64 limit = size > 12 ? size - 12 : 0; // The tail always goes out as literals, so matches never read past the end
+
+		while (position < limit) {
+			const u32 sequence = read_u32(data + position);
+			const u32 hash = (sequence * 2654435761u) >> (32 - hash_bits);
+			const u64 candidate = _table[hash];
+			_table[hash] = static_cast<u32>(position + 1);
+
+			if (!candidate || position - (candidate - 1) > max_offset || read_u32(data + candidate - 1) != sequence) {
+				++position;
+				continue;
+			}
+
+			const u64 match = candidate - 1;
+			u64 length{ min_match };
+			while (position + length < size && data[match + length] == data[position + length]) ++length;
+
+			write_sequence(out, data + anchor, position - anchor, static_cast<u32>(position - match), length);
+			position += length;
+			anchor = position;
+		}
+		write_sequence(out, data + anchor, size - anchor, 0, 0);
+	}
+
+	bool BlockCompressor::decompress(const u8* data, u64 data_size, u8* out, u64 size) {
+		u64 in{ 0 };
+		u64 written{ 0 };
+
+		while (in < data_size) {
+			const u8 token = data[in++];
+
+			u64 literal_count = token >> 4;
+			if (literal_count == 15 && !read_length(data, data_size, in, literal_count)) return false;
+			if (literal_count > data_size - in || literal_count > size - written) return false;
+			std::memcpy(out + written, data + in, literal_count);
+			in += literal_count;
+			written += literal_count;
+
+			if (in == data_size) break; // Last sequence
+
+			if (data_size - in < 2) return false;
+			const u64 offset = data[in] | (data[in + 1] << 8);
+			in += 2;
+			u64 length = (token & 0x0F) + min_match;
+			if ((token & 0x0F) == 15 && !read_length(data, data_size, in, length)) return false;
+			if (!offset || offset > written || length > size - written) return false;
+
+			const u8* source = out + written - offset;
+			for (u64 i{ 0 }; i < length; ++i) out[written + i] = source[i]; // Byte by byte, the match may overlap what it writes
+			written += length;
+		}
+		return written == size;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::Utilities {
+
+	// Block Compression | Byte-oriented LZ77 in the spirit of LZ4: a greedy single-probe hash match finder, no entropy coding.
+	// Fast enough to keep up with the emulator on another thread, and traces of loops [the common case] shrink a lot.
+	//
+	// Sequence -> [token: literal count << 4 | match length - 4] [literal count extension] [literals] [offset u16] [match length extension]
+	// A count of 15 in the token continues in extension bytes, each adding up to 255. The last sequence has literals only.
+	class BlockCompressor {
+	public:
+		static constexpr u32 min_match{ 4 };
+		static constexpr u32 max_offset{ 0xFFFF };
+
+		BlockCompressor() : _table(1 << hash_bits) {}
+
+		// Replaces out with the compressed data
+		void compress(const u8* data, u64 size, std::vector<u8>& out);
+
+		// Decompresses into exactly size bytes | false on corrupt input
+		[[nodiscard]] static bool decompress(const u8* data, u64 data_size, u8* out, u64 size);
+
+	private:
+		static constexpr u32 hash_bits{ 14 };
+
+		std::vector<u32>	_table; // Hash of 4 bytes -> last position + 1 [0 -> empty], reused across blocks
+	};
+}
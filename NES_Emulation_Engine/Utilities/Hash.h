@@ -0,0 +1,16 @@
+#pragma once
+
+#include <span>
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::Utilities {
+
+	// FNV-1a, 64-bit | Cheap fingerprint of RAM or a frame for regression runs, not for anything adversarial
+	[[nodiscard]] inline u64 fnv1a(std::span<const u8> data, u64 hash = 0xCBF29CE484222325) {
+		for (const u8 byte : data) {
+			hash = (hash ^ byte) * 0x00000100000001B3;
+		}
+		return hash;
+	}
+}
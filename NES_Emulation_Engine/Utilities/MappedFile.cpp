@@ -0,0 +1,93 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace NES::Utilities {
+
+#if defined(_WIN32)
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr); // Copy-on-write view of a read-only file
+		if (!mapping) {
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+		if (!view) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		_file = file;
+		_mapping = mapping;
+		_data = static_cast<u8*>(view);
+		_size = static_cast<u64>(size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data) UnmapViewOfFile(_data);
+		if (_mapping) CloseHandle(_mapping);
+		if (_file) CloseHandle(_file);
+
+		_data = nullptr;
+		_mapping = nullptr;
+		_file = nullptr;
+		_size = 0;
+	}
+
+#else
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+		int file = ::open(path.c_str(), O_RDONLY);
+		if (file < 0) return false;
+
+		struct stat info{};
+		if (fstat(file, &info) != 0 || info.st_size == 0) {
+			::close(file);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0); // Copy-on-write view of a read-only file
+		::close(file); // The mapping keeps its own reference to the file
+
+		if (view == MAP_FAILED) return false;
+
+		_data = static_cast<u8*>(view);
+		_size = static_cast<u64>(info.st_size);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data) munmap(_data, static_cast<size_t>(_size));
+
+		_data = nullptr;
+		_size = 0;
+	}
+
+#endif // _WIN32
+}
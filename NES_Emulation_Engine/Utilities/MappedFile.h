@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../Common/CommonHeaders.h"
+
+namespace NES::Utilities {
+
+	// A file mapped into memory | The mapping is private: pages are shared with the OS file cache until written, a write copies only the touched page [copy-on-write] and never reaches the file.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile() { close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		[[nodiscard]] bool open(const std::string& path);
+		void close();
+
+		[[nodiscard]] u8* data() const { return _data; }
+		[[nodiscard]] u64 size() const { return _size; }
+
+	private:
+		u8*		_data{ nullptr };
+		u64		_size{ 0 };
+
+#if defined(_WIN32)
+		void*	_file{ nullptr }; // HANDLE
+		void*	_mapping{ nullptr }; // HANDLE
+#endif // _WIN32
+	};
+}